@@ -0,0 +1,130 @@
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+#include <string>
+
+#include <occa.hpp>
+
+//---[ Internal Tools ]-----------------
+// Note: These headers are not officially supported
+//       Please don't rely on it outside of the occa examples
+#include <occa/internal/utils/cli.hpp>
+//======================================
+
+occa::json parseArgs(int argc, const char **argv);
+
+// The byte-at-a-time hash used before occa::hasher_t, kept for comparison
+occa::hash_t legacyHash(const void *ptr, occa::udim_t bytes) {
+  const char *c = (const char*) ptr;
+
+  occa::hash_t hash;
+  int *h = hash.h;
+
+  const int p[8] = {
+    102679, 102701, 102761, 102763,
+    102769, 102793, 102797, 102811
+  };
+
+  for (occa::udim_t i = 0; i < bytes; ++i) {
+    for (int j = 0; j < 8; ++j) {
+      h[j] = (h[j] * p[j]) ^ c[i];
+    }
+  }
+  hash.initialized = true;
+
+  return hash;
+}
+
+std::string buildOklSource(const int kernels) {
+  std::string source;
+  for (int i = 0; i < kernels; ++i) {
+    const std::string id = std::to_string(i);
+    source += (
+      "@kernel void addVectors" + id + "(const int entries,\n"
+      "                                  const float *a,\n"
+      "                                  const float *b,\n"
+      "                                  float *ab) {\n"
+      "  for (int i = 0; i < entries; ++i; @tile(16, @outer, @inner)) {\n"
+      "    ab[i] = a[i] + b[i] * " + id + ";\n"
+      "  }\n"
+      "}\n\n"
+    );
+  }
+  return source;
+}
+
+template <class hashFunction_t>
+double benchmark(const std::string &source,
+                 const int iterations,
+                 hashFunction_t hashFunction) {
+  int checksum = 0;
+
+  const auto start = std::chrono::steady_clock::now();
+  for (int i = 0; i < iterations; ++i) {
+    checksum ^= hashFunction(source.c_str(), source.size()).getInt();
+  }
+  const auto end = std::chrono::steady_clock::now();
+
+  // Keep the hashes from being optimized away
+  if (checksum == 0x12345678) {
+    std::cout << ' ';
+  }
+
+  const double seconds = std::chrono::duration<double>(end - start).count();
+  return (source.size() * (double) iterations) / (seconds * 1e9);
+}
+
+int main(int argc, const char **argv) {
+  occa::json args = parseArgs(argc, argv);
+
+  const int kernels = std::stoi((std::string) args["options/kernels"]);
+  const int iterations = std::stoi((std::string) args["options/iterations"]);
+
+  const std::string source = buildOklSource(kernels);
+
+  const double legacyBandwidth = benchmark(source, iterations, legacyHash);
+  const double newBandwidth = benchmark(
+    source, iterations,
+    [](const void *ptr, occa::udim_t bytes) {
+      return occa::hash(ptr, bytes);
+    }
+  );
+
+  std::cout << std::fixed << std::setprecision(3)
+            << "Source size  : " << (source.size() / 1024) << " KB\n"
+            << "Iterations   : " << iterations << '\n'
+            << "legacy hash  : " << legacyBandwidth << " GB/s\n"
+            << "occa::hash   : " << newBandwidth << " GB/s\n"
+            << "Speedup      : " << (newBandwidth / legacyBandwidth) << "x\n";
+
+  return 0;
+}
+
+occa::json parseArgs(int argc, const char **argv) {
+  occa::cli::parser parser;
+  parser
+    .withDescription(
+      "Benchmark occa::hash against the previous byte-at-a-time hash on a large OKL source"
+    )
+    .addOption(
+      occa::cli::option('k', "kernels",
+                        "Number of kernels in the generated OKL source (default: 10000)")
+      .withArg()
+      .withDefaultValue(10000)
+    )
+    .addOption(
+      occa::cli::option('i', "iterations",
+                        "Number of times the source is hashed (default: 10)")
+      .withArg()
+      .withDefaultValue(10)
+    )
+    .addOption(
+      occa::cli::option('v', "verbose",
+                        "Compile kernels in verbose mode")
+    );
+
+  occa::json args = parser.parseArgs(argc, argv);
+  occa::settings()["kernel/verbose"] = args["options/verbose"];
+
+  return args;
+}
@@ -0,0 +1,126 @@
+#include <algorithm>
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include <occa.hpp>
+
+//---[ Internal Tools ]-----------------
+// Note: These headers are not officially supported
+//       Please don't rely on it outside of the occa examples
+#include <occa/internal/utils/cli.hpp>
+//======================================
+
+occa::json parseArgs(int argc, const char **argv);
+
+struct policy_t {
+  std::string name;
+  occa::json props;
+};
+
+// Best STREAM triad bandwidth in GB/s with arrays allocated using [props]
+double benchmark(occa::device &device,
+                 occa::kernel &triad,
+                 const int entries,
+                 const int iterations,
+                 const occa::json &props) {
+  occa::memory o_a = device.malloc<double>(entries, props);
+  occa::memory o_b = device.malloc<double>(entries, props);
+  occa::memory o_c = device.malloc<double>(entries, props);
+
+  // Initialize the arrays with the kernel so untouched pages are placed by it
+  triad(entries, 0.0, o_b, o_a, o_a);
+  triad(entries, 0.0, o_c, o_a, o_a);
+  triad(entries, 0.0, o_a, o_b, o_c);
+  device.finish();
+
+  double bestSeconds = -1;
+  for (int i = 0; i < iterations; ++i) {
+    const auto start = std::chrono::steady_clock::now();
+    triad(entries, 3.0, o_a, o_b, o_c);
+    device.finish();
+    const auto end = std::chrono::steady_clock::now();
+
+    const double seconds = std::chrono::duration<double>(end - start).count();
+    if ((bestSeconds < 0) || (seconds < bestSeconds)) {
+      bestSeconds = seconds;
+    }
+  }
+
+  // Reads b and c, writes a
+  const double bytes = 3.0 * sizeof(double) * entries;
+  return bytes / (bestSeconds * 1e9);
+}
+
+int main(int argc, const char **argv) {
+  occa::json args = parseArgs(argc, argv);
+
+  const int entries = std::stoi((std::string) args["options/entries"]);
+  const int iterations = std::stoi((std::string) args["options/iterations"]);
+
+  occa::device device((std::string) args["options/device"]);
+
+  occa::kernel triad = device.buildKernel("triad.okl", "triad");
+
+  // Placement properties are read by host modes and ignored by others
+  const std::vector<policy_t> policies = {
+    {"default", occa::json()},
+    {"first_touch: parallel", {{"first_touch", "parallel"}}},
+    {"interleave", {{"interleave", true}}},
+    {"numa_node: 0", {{"numa_node", 0}}},
+    {"huge_pages", {{"huge_pages", true}}},
+    {"huge_pages + first_touch", {{"huge_pages", true}, {"first_touch", "parallel"}}}
+  };
+
+  std::cout << "Mode       : " << device.mode() << '\n'
+            << "Array size : " << (entries * sizeof(double) / (1 << 20)) << " MB\n"
+            << "Iterations : " << iterations << "\n\n";
+
+  std::cout << std::fixed << std::setprecision(2);
+  for (const policy_t &policy : policies) {
+    const double bandwidth = benchmark(device, triad,
+                                       entries, iterations,
+                                       policy.props);
+    std::cout << std::left << std::setw(26) << policy.name
+              << ": " << bandwidth << " GB/s\n";
+  }
+
+  return 0;
+}
+
+occa::json parseArgs(int argc, const char **argv) {
+  occa::cli::parser parser;
+  parser
+    .withDescription(
+      "STREAM triad bandwidth for each host memory placement policy"
+    )
+    .addOption(
+      occa::cli::option('d', "device",
+                        "Device properties (default: \"{mode: 'Serial'}\")")
+      .withArg()
+      .withDefaultValue("{mode: 'Serial'}")
+    )
+    .addOption(
+      occa::cli::option('e', "entries",
+                        "Number of doubles in each array (default: 4194304)")
+      .withArg()
+      .withDefaultValue(1 << 22)
+    )
+    .addOption(
+      occa::cli::option('i', "iterations",
+                        "Number of timed triad launches per policy (default: 10)")
+      .withArg()
+      .withDefaultValue(10)
+    )
+    .addOption(
+      occa::cli::option('v', "verbose",
+                        "Compile kernels in verbose mode")
+    );
+
+  occa::json args = parser.parseArgs(argc, argv);
+  occa::settings()["kernel/verbose"] = args["options/verbose"];
+
+  return args;
+}
@@ -0,0 +1,131 @@
+#include <algorithm>
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+#include <numeric>
+#include <string>
+#include <vector>
+
+#include <occa.hpp>
+#include <occa/functional.hpp>
+
+//---[ Internal Tools ]-----------------
+// Note: These headers are not officially supported
+//       Please don't rely on it outside of the occa examples
+#include <occa/internal/utils/cli.hpp>
+//======================================
+
+occa::json parseArgs(int argc, const char **argv);
+
+// Best time in seconds out of [iterations] calls
+template <class benchmarkFunction_t>
+double benchmark(occa::device &device,
+                 const int iterations,
+                 benchmarkFunction_t benchmarkFunction) {
+  double bestSeconds = -1;
+  for (int i = 0; i < iterations; ++i) {
+    const auto start = std::chrono::steady_clock::now();
+    benchmarkFunction();
+    device.finish();
+    const auto end = std::chrono::steady_clock::now();
+
+    const double seconds = std::chrono::duration<double>(end - start).count();
+    if ((bestSeconds < 0) || (seconds < bestSeconds)) {
+      bestSeconds = seconds;
+    }
+  }
+  return bestSeconds;
+}
+
+void printResult(const std::string &name,
+                 const int entries,
+                 const double stdSeconds,
+                 const double occaSeconds) {
+  std::cout << std::left << std::setw(16) << name
+            << ": std " << std::setw(10) << (entries / (stdSeconds * 1e6))
+            << "occa " << std::setw(10) << (entries / (occaSeconds * 1e6))
+            << "(M entries/s, " << (stdSeconds / occaSeconds) << "x)\n";
+}
+
+int main(int argc, const char **argv) {
+  occa::json args = parseArgs(argc, argv);
+
+  const int entries = std::stoi((std::string) args["options/entries"]);
+  const int iterations = std::stoi((std::string) args["options/iterations"]);
+
+  occa::device device((std::string) args["options/device"]);
+
+  // Unsorted keys with repeats, like particles binned by cell
+  std::vector<int> keys(entries);
+  for (int i = 0; i < entries; ++i) {
+    keys[i] = (int) ((i * 2654435761u) % (entries / 4 + 1));
+  }
+  std::vector<int> output(entries);
+
+  occa::array<int> array(device.malloc<int>(entries, keys.data()));
+
+  // Build kernels before timing
+  array.sort();
+  array.inclusiveScan();
+
+  std::cout << "Mode       : " << device.mode() << '\n'
+            << "Entries    : " << entries << '\n'
+            << "Iterations : " << iterations << "\n\n";
+
+  std::cout << std::fixed << std::setprecision(2);
+
+  const double stdSortSeconds = benchmark(device, iterations, [&]() {
+    output = keys;
+    std::sort(output.begin(), output.end());
+  });
+  const double occaSortSeconds = benchmark(device, iterations, [&]() {
+    array.sort();
+  });
+  printResult("sort", entries, stdSortSeconds, occaSortSeconds);
+
+  // std::inclusive_scan is C++17, std::partial_sum is its serial equivalent
+  const double stdScanSeconds = benchmark(device, iterations, [&]() {
+    std::partial_sum(keys.begin(), keys.end(), output.begin());
+  });
+  const double occaScanSeconds = benchmark(device, iterations, [&]() {
+    array.inclusiveScan();
+  });
+  printResult("inclusiveScan", entries, stdScanSeconds, occaScanSeconds);
+
+  return 0;
+}
+
+occa::json parseArgs(int argc, const char **argv) {
+  occa::cli::parser parser;
+  parser
+    .withDescription(
+      "Benchmark occa::array sort and scan against std::sort and std::partial_sum"
+    )
+    .addOption(
+      occa::cli::option('d', "device",
+                        "Device properties (default: \"{mode: 'Serial'}\")")
+      .withArg()
+      .withDefaultValue("{mode: 'Serial'}")
+    )
+    .addOption(
+      occa::cli::option('e', "entries",
+                        "Number of ints in the array (default: 10000000)")
+      .withArg()
+      .withDefaultValue(10000000)
+    )
+    .addOption(
+      occa::cli::option('i', "iterations",
+                        "Number of timed runs, keeping the best (default: 5)")
+      .withArg()
+      .withDefaultValue(5)
+    )
+    .addOption(
+      occa::cli::option('v', "verbose",
+                        "Compile kernels in verbose mode")
+    );
+
+  occa::json args = parser.parseArgs(argc, argv);
+  occa::settings()["kernel/verbose"] = args["options/verbose"];
+
+  return args;
+}
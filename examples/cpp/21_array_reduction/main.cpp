@@ -0,0 +1,151 @@
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include <occa.hpp>
+#include <occa/functional.hpp>
+
+//---[ Internal Tools ]-----------------
+// Note: These headers are not officially supported
+//       Please don't rely on it outside of the occa examples
+#include <occa/internal/utils/cli.hpp>
+//======================================
+
+occa::json parseArgs(int argc, const char **argv);
+
+// Best time in seconds out of [iterations] calls
+template <class benchmarkFunction_t>
+double benchmark(occa::device &device,
+                 const int iterations,
+                 benchmarkFunction_t benchmarkFunction) {
+  double bestSeconds = -1;
+  for (int i = 0; i < iterations; ++i) {
+    const auto start = std::chrono::steady_clock::now();
+    benchmarkFunction();
+    device.finish();
+    const auto end = std::chrono::steady_clock::now();
+
+    const double seconds = std::chrono::duration<double>(end - start).count();
+    if ((bestSeconds < 0) || (seconds < bestSeconds)) {
+      bestSeconds = seconds;
+    }
+  }
+  return bestSeconds;
+}
+
+int main(int argc, const char **argv) {
+  occa::json args = parseArgs(argc, argv);
+
+  const int minEntries = std::stoi((std::string) args["options/min-entries"]);
+  const int maxEntries = std::stoi((std::string) args["options/max-entries"]);
+  const int iterations = std::stoi((std::string) args["options/iterations"]);
+
+  occa::device device((std::string) args["options/device"]);
+
+  // Smaller arrays are slices of the largest one
+  occa::array<float> array(device, maxEntries);
+  array.fill(1);
+
+  occa::function<float(const float&, const float&)> sum = OCCA_FUNCTION(
+    [](const float &acc, const float &value) -> float {
+      return acc + value;
+    }
+  );
+
+  const std::vector<occa::reductionType> minMaxSum = {
+    occa::reductionType::min,
+    occa::reductionType::max,
+    occa::reductionType::sum
+  };
+
+  std::cout << "Mode       : " << device.mode() << '\n'
+            << "Iterations : " << iterations << "\n\n";
+
+  std::cout << std::left
+            << std::setw(12) << "Entries"
+            << std::setw(14) << "sum (us)"
+            << std::setw(14) << "sum (GB/s)"
+            << std::setw(20) << "min+max+sum (us)"
+            << std::setw(20) << "multiReduce (us)"
+            << "speedup\n";
+
+  std::cout << std::fixed << std::setprecision(2);
+  for (int entries = minEntries; entries <= maxEntries; entries *= 4) {
+    occa::array<float> values = array.slice(0, entries);
+
+    // Build kernels before timing
+    values.reduce<float>(occa::reductionType::sum, sum);
+    values.min();
+    values.max();
+    values.multiReduce(minMaxSum);
+
+    const double sumSeconds = benchmark(device, iterations, [&]() {
+      values.reduce<float>(occa::reductionType::sum, sum);
+    });
+    const double separateSeconds = benchmark(device, iterations, [&]() {
+      values.min();
+      values.max();
+      values.reduce<float>(occa::reductionType::sum, sum);
+    });
+    const double multiReduceSeconds = benchmark(device, iterations, [&]() {
+      values.multiReduce(minMaxSum);
+    });
+
+    const double bytes = sizeof(float) * (double) entries;
+    std::cout << std::setw(12) << entries
+              << std::setw(14) << (sumSeconds * 1e6)
+              << std::setw(14) << (bytes / (sumSeconds * 1e9))
+              << std::setw(20) << (separateSeconds * 1e6)
+              << std::setw(20) << (multiReduceSeconds * 1e6)
+              << (separateSeconds / multiReduceSeconds) << "x\n";
+
+    if (entries > (maxEntries / 4)) {
+      break;
+    }
+  }
+
+  return 0;
+}
+
+occa::json parseArgs(int argc, const char **argv) {
+  occa::cli::parser parser;
+  parser
+    .withDescription(
+      "Benchmark occa::array reductions over array sizes from 1K to 1G floats"
+    )
+    .addOption(
+      occa::cli::option('d', "device",
+                        "Device properties (default: \"{mode: 'Serial'}\")")
+      .withArg()
+      .withDefaultValue("{mode: 'Serial'}")
+    )
+    .addOption(
+      occa::cli::option('i', "iterations",
+                        "Number of timed runs per size, keeping the best (default: 10)")
+      .withArg()
+      .withDefaultValue(10)
+    )
+    .addOption(
+      occa::cli::option('m', "max-entries",
+                        "Largest array size, which is allocated once (default: 1073741824)")
+      .withArg()
+      .withDefaultValue(1 << 30)
+    )
+    .addOption(
+      occa::cli::option('n', "min-entries",
+                        "Smallest array size, multiplied by 4 until the largest size (default: 1024)")
+      .withArg()
+      .withDefaultValue(1024)
+    )
+    .addOption(
+      occa::cli::option('v', "verbose",
+                        "Compile kernels in verbose mode")
+    );
+
+  occa::json args = parser.parseArgs(argc, argv);
+  occa::settings()["kernel/verbose"] = args["options/verbose"];
+
+  return args;
+}
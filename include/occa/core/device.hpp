@@ -1,6 +1,7 @@
 #ifndef OCCA_CORE_DEVICE_HEADER
 #define OCCA_CORE_DEVICE_HEADER
 
+#include <functional>
 #include <iostream>
 #include <sstream>
 
@@ -24,6 +25,27 @@ namespace occa {
   typedef cachedKernelMap::iterator       cachedKernelMapIterator;
   typedef cachedKernelMap::const_iterator cCachedKernelMapIterator;
 
+  typedef std::function<void (occa::kernel &kernel)> kernelLauncher_t;
+
+  /**
+   * @startDoc{kernelSpec}
+   *
+   * Description:
+   *   Describes one kernel to build through [[device.buildKernels]].
+   *
+   * @endDoc
+   */
+  class kernelSpec {
+   public:
+    std::string filename;
+    std::string kernelName;
+    occa::json props;
+
+    kernelSpec(const std::string &filename_,
+               const std::string &kernelName_,
+               const occa::json &props_ = occa::json());
+  };
+
   /**
    * @startDoc{device}
    *
@@ -331,6 +353,85 @@ namespace occa {
      */
     udim_t memoryAllocated() const;
 
+    /**
+     * @startDoc{peakMemoryAllocated}
+     *
+     * Description:
+     *   Returns the high-water mark of [[device.memoryAllocated]], in bytes.
+     *
+     * @endDoc
+     */
+    udim_t peakMemoryAllocated() const;
+
+    /**
+     * @startDoc{trimMemoryPool}
+     *
+     * Description:
+     *   Frees the allocations cached by the device memory pool.
+     *   Memory that is still in use is not affected.
+     *
+     *   The pool is enabled through the `memory_pool` device properties on host modes
+     *   (`Serial`, `OpenMP`, `Threads`):
+     *
+     *   ```cpp
+     *   occa::device device({
+     *     {"mode", "Serial"},
+     *     {"memory_pool", {
+     *       {"enabled", true},
+     *       // Optional, released memory past this is returned to the system
+     *       {"max_cached_bytes", 1 << 30}
+     *     }}
+     *   });
+     *   ```
+     *
+     *   Released allocations are kept in size classes and reused by later [[device.malloc]] calls.
+     *   An allocation released while [[asynchronous streams|device.createStream]] have queued work
+     *   is only reused once that work finishes, or by work queued on the same stream.
+     *
+     * @endDoc
+     */
+    void trimMemoryPool();
+
+    /**
+     * @startDoc{memoryPoolInfo}
+     *
+     * Description:
+     *   Returns the memory pool statistics:
+     *   - `enabled`: Whether the device pools its allocations
+     *   - `cached_bytes`: Bytes released to the pool and ready for reuse
+     *   - `reserved_bytes`: Bytes held by the pool, both in use and cached
+     *   - `peak_reserved_bytes`: High-water mark of `reserved_bytes`
+     *   - `hits`, `misses`: Allocations served from and outside the cache
+     *
+     * @endDoc
+     */
+    occa::json memoryPoolInfo() const;
+
+    /**
+     * @startDoc{kernelCacheHits}
+     *
+     * Description:
+     *   Returns how many [[device.buildKernel]] calls were served by an already loaded kernel.
+     *
+     *   Kernels are cached in memory by their hash and name until they are freed,
+     *   so rebuilding the same kernel returns a handle to the existing kernel.
+     *   Each handle keeps its own arguments and run dimensions,
+     *   and [[kernel.free]] only releases the kernel once no other handle uses it.
+     *
+     * @endDoc
+     */
+    udim_t kernelCacheHits() const;
+
+    /**
+     * @startDoc{kernelCacheMisses}
+     *
+     * Description:
+     *   Returns how many [[device.buildKernel]] calls had to load or compile a kernel.
+     *
+     * @endDoc
+     */
+    udim_t kernelCacheMisses() const;
+
     /**
      * @startDoc{finish}
      *
@@ -369,6 +470,13 @@ namespace occa {
      *
      *   > Note that the stream is created but not set as the active stream.
      *
+     *   Host modes (`Serial`, `OpenMP`, `Threads`) run work on the calling thread by default.
+     *   Passing `async: true` gives the stream its own executor thread, where
+     *   kernel launches and `async: true` memory copies are queued in order and return right away.
+     *   Use [[device.finish]] or a [[streamTag]] to wait on the queued work before touching
+     *   the memory from the host.
+     *   Setting `stream: { async: true }` in the device properties makes every stream asynchronous.
+     *
      * Returns:
      *   Newly created [[stream]]
      *
@@ -445,6 +553,20 @@ namespace occa {
 
     hash_t applyDependencyHash(const hash_t &kernelHash) const;
 
+  private:
+    std::string tuningFile(const hash_t &sourceHash,
+                           const std::string &kernelName) const;
+
+    // Results are read once per device, uninitialized if the kernel wasn't tuned
+    occa::json loadTunedProperties(const hash_t &sourceHash,
+                                   const std::string &kernelName) const;
+
+    occa::json applyTunedProperties(const occa::json &props,
+                                    const hash_t &sourceHash,
+                                    const std::string &kernelName) const;
+
+  public:
+
     /**
      * @startDoc{buildKernel}
      *
@@ -496,7 +618,7 @@ namespace occa {
      *
      *   # Functions
      *
-     *   Lastly, [[function]]'s can be captured through the `functions` path.
+     *   [[function]]'s can be captured through the `functions` path.
      *   For example:
      *
      *   ```cpp
@@ -508,6 +630,39 @@ namespace occa {
      *   );
      *   ```
      *
+     *   # OpenMP
+     *
+     *   The `OpenMP` mode adds clauses to the `omp parallel for` pragma through the `openmp` path:
+     *   - `threads`: Number of threads (`num_threads`)
+     *   - `schedule`: One of `static`, `dynamic`, `guided`, `auto` or `runtime`, with an optional `chunk` size
+     *   - `proc_bind`: One of `close`, `spread`, `primary` or `master`
+     *   - `collapse`: Number of perfectly nested `@outer` loops to collapse
+     *
+     *   Setting them on the device makes them the default for every kernel.
+     *   For example:
+     *
+     *   ```cpp
+     *   occa::json props;
+     *   props["openmp/schedule"] = "dynamic";
+     *   props["openmp/chunk"] = 4;
+     *   props["openmp/collapse"] = 2;
+     *   ```
+     *
+     *   # Vectorization
+     *
+     *   Host modes (`Serial`, `OpenMP` and `Threads`) can pass vectorization hints to the compiler through the `serial` path:
+     *   - `vectorize`: Adds `#pragma omp simd` to inner-most `@inner` loops and compiles with the compiler's OpenMP SIMD flag.
+     *     Loops using `@exclusive`, `@atomic`, `@barrier`, `break`, `return` or `goto` are left as-is.
+     *     The decision for each loop is printed when `verbose` is set.
+     *   - `assume_aligned`: Alignment in bytes promised for every `@restrict` pointer argument.
+     *     Host allocations are aligned to `OCCA_MEM_BYTE_ALIGN`, so views with unaligned offsets should not be passed.
+     *   - `static_functions`: Gives non-kernel functions defined in the source internal linkage so they can be inlined into kernels.
+     *     Functional and `OCCA_JIT` kernels enable it by default.
+     *
+     *   Setting `okl/fuse_inner_loops` to `true` also lets host modes merge adjacent inner-most `@inner` loops with identical headers.
+     *   Loops are only merged when every value written in one loop and read in the other is indexed by the loop iterator the same way,
+     *   so pointer arguments should be marked `@restrict` to be fused.
+     *
      * @endDoc
      */
     occa::kernel buildKernel(const std::string &filename,
@@ -541,6 +696,148 @@ namespace occa {
     occa::kernel buildKernelFromBinary(const std::string &filename,
                                        const std::string &kernelName,
                                        const occa::json &props = occa::json()) const;
+
+    /**
+     * @startDoc{buildKernels[0]}
+     *
+     * Description:
+     *   Builds a batch of kernels, returning them in the same order as `specs`.
+     *
+     *   Every kernel is hashed up front and kernels sharing a source file and properties
+     *   share one build. Backends which compile through a host compiler, such as
+     *   `Serial` and `OpenMP`, run the missing compiles concurrently.
+     *   The number of concurrent compiler processes can be limited through the
+     *   `compiler_jobs` property or the `OCCA_COMPILER_JOBS` environment variable.
+     *   If specs set different `compiler_jobs` values, the smallest one limits the batch.
+     *
+     * Arguments:
+     *   specs:
+     *     The [[kernelSpec]] list to build.
+     *     More information on the properties in [[device.buildKernel]]
+     *   errors:
+     *     Set to the build error of each kernel, or an empty string on success.
+     *     Kernels which failed to build are returned uninitialized.
+     *
+     * Returns:
+     *   The compiled [[kernel]] list.
+     *
+     * @endDoc
+     */
+    std::vector<occa::kernel> buildKernels(const std::vector<kernelSpec> &specs,
+                                           strVector &errors) const;
+
+    /**
+     * @startDoc{buildKernels[1]}
+     *
+     * Description:
+     *   Same as above but throws an error listing every kernel that failed to build.
+     *
+     * @endDoc
+     */
+    std::vector<occa::kernel> buildKernels(const std::vector<kernelSpec> &specs) const;
+
+    /**
+     * @startDoc{tuneKernel}
+     *
+     * Description:
+     *   Builds every combination of the properties in `searchSpace`, times each variant,
+     *   and returns the fastest [[kernel]].
+     *
+     *   The search space mirrors the kernel properties, with an array of candidate values for each tuned property.
+     *   `@tile` sizes can be tuned by passing them as defines, such as `@tile(BLOCK, @outer, @inner)`.
+     *
+     *   ```cpp
+     *   occa::kernel addVectors = device.tuneKernel(
+     *     "addVectors.okl", "addVectors",
+     *     occa::json::parse("{ defines: { BLOCK: [32, 64, 128, 256] } }"),
+     *     [&](occa::kernel &kernel) {
+     *       kernel(entries, o_a, o_b, o_ab);
+     *     }
+     *   );
+     *   ```
+     *
+     *   Variants are compiled together through [[device.buildKernels]].
+     *   Each variant is launched `tuning/warmup` times (default 1) and then timed
+     *   `tuning/iterations` times (default 5) with [[device.tagStream]] and [[device.timeBetween]],
+     *   keeping its fastest run. Variants which fail to build are skipped.
+     *
+     *   The winning properties are stored in the OCCA cache under the device [[hash|device.hash]],
+     *   source and kernel name.
+     *   Later [[device.buildKernel]] calls for the same kernel on an identical device use them automatically,
+     *   with properties passed to [[device.buildKernel]] taking precedence.
+     *   Set `tuning/apply` to `false` to build a kernel without its tuned properties.
+     *
+     * Arguments:
+     *   filename:
+     *     Location of the file to compile
+     *   kernelName
+     *     Specify the `@kernel` function name to use
+     *   searchSpace:
+     *     Kernel properties with an array of candidate values in place of each tuned value
+     *   launcher:
+     *     Launches the given variant with its arguments.
+     *     It is called several times per variant, so it should not accumulate results.
+     *   props:
+     *     Base [[properties|json]] shared by every variant.
+     *     More information in [[device.buildKernel]]
+     *
+     * Returns:
+     *   The fastest [[kernel]].
+     *
+     * @endDoc
+     */
+    occa::kernel tuneKernel(const std::string &filename,
+                            const std::string &kernelName,
+                            const occa::json &searchSpace,
+                            const kernelLauncher_t &launcher,
+                            const occa::json &props = occa::json());
+
+    /**
+     * @startDoc{tunedKernelProperties}
+     *
+     * Description:
+     *   Returns the properties picked by [[device.tuneKernel]] for the kernel,
+     *   or an empty object if it hasn't been tuned on this device.
+     *
+     * @endDoc
+     */
+    occa::json tunedKernelProperties(const std::string &filename,
+                                     const std::string &kernelName) const;
+
+    /**
+     * @startDoc{loadBundle}
+     *
+     * Description:
+     *   Loads a kernel bundle created through `occa bundle`, which packs prebuilt kernels into one file.
+     *
+     *   ```bash
+     *   occa bundle kernels.json kernels.bundle
+     *   ```
+     *
+     *   The manifest lists the device properties and the kernels to build,
+     *   where relative filenames are resolved from the manifest directory:
+     *
+     *   ```js
+     *   {
+     *     device: { mode: 'Serial' },
+     *     kernels: [
+     *       { file: 'addVectors.okl', kernel: 'addVectors', props: { defines: { TILE: 64 } } }
+     *     ]
+     *   }
+     *   ```
+     *
+     *   The bundle is memory-mapped and [[device.buildKernel]] calls matching a bundled kernel
+     *   restore its binary in the cache directory instead of compiling it.
+     *   Kernels only match if the source file, properties and device [[hash|device.hash]] are the same
+     *   as when the bundle was built.
+     *
+     * Arguments:
+     *   filename:
+     *     Location of the bundle
+     *
+     * @endDoc
+     */
+    void loadBundle(const std::string &filename);
     //  |===============================
 
     //  |---[ Memory ]------------------
@@ -558,6 +855,18 @@ namespace occa {
      *   {"host", true}
      *   ```
      *
+     *   Host modes (`Serial`, `OpenMP`, `Threads`) take page placement properties,
+     *   which can also be set for every allocation through the device `memory` properties:
+     *
+     *   - `numa_node`: Bind the pages to a NUMA node
+     *   - `interleave`: Interleave the pages across the online NUMA nodes
+     *   - `huge_pages`: Back the allocation with transparent huge pages
+     *   - `first_touch`: Use `"parallel"` to initialize the pages with one thread per allowed CPU,
+     *     each touching a contiguous chunk, which places pages near threads using a static schedule
+     *   - `first_touch_threads`: How many threads are used for the `"parallel"` first touch
+     *
+     *   Placement that isn't supported by the system is skipped, with a warning when `OCCA_VERBOSE` is set.
+     *
      * Overloaded Description:
      *   Uses the templated type to determine the type and bytes.
      *
@@ -4,6 +4,7 @@
 #include <initializer_list>
 #include <iostream>
 #include <stdint.h>
+#include <type_traits>
 #include <vector>
 
 #include <occa/defines.hpp>
@@ -18,6 +19,7 @@ namespace occa {
   class modeMemory_t; class memory;
   class modeDevice_t; class device;
   class kernelBuilder;
+  class kernelLaunch;
 
   namespace lang {
     class parser_t;
@@ -42,9 +44,10 @@ namespace occa {
    *
    *   # Launch
    *
-   *   There are 2 ways to launching kernels:
+   *   There are 3 ways to launching kernels:
    *   - [[kernel.operator_parentheses]] which can be used to call a kernel like a regular function.
    *   - [[kernel.run]] which requires the user to push the arguments one-by-one before running it.
+   *   - [[kernel.bind]] which validates the arguments once and returns a [[kernelLaunch]] to run many times.
    *
    *   # Garbage collection
    *
@@ -56,10 +59,17 @@ namespace occa {
   class kernel : public gc::ringEntry_t {
     friend class occa::modeKernel_t;
     friend class occa::device;
+    friend class occa::kernelLaunch;
 
   private:
     modeKernel_t *modeKernel;
 
+    // Launch state is kept per handle since cached kernels are shared between handles,
+    //   the const call operators set the arguments
+    mutable kernelArgDataVector arguments;
+    bool hasRunDims;
+    dim outerDims, innerDims;
+
   public:
     kernel();
     kernel(modeKernel_t *modeKernel_);
@@ -74,6 +84,14 @@ namespace occa {
     void setModeKernel(modeKernel_t *modeKernel_);
     void removeKernelRef();
 
+    void addArgument(const kernelArg &arg) const;
+    void setArguments(const kernelArg *args,
+                      const int count) const;
+
+    // Dimensions set through setRunDims, otherwise the kernel's
+    const dim& getRunOuterDims() const;
+    const dim& getRunInnerDims() const;
+
   public:
     /**
      * @startDoc{dontUseRefs}
@@ -232,6 +250,8 @@ namespace occa {
      *   need to be manually set.
      *   The dimensions are required when running modes such as `CUDA`, `HIP`, and `OpenCL`.
      *
+     *   The dimensions only apply to this handle and its copies.
+     *
      * @endDoc
      */
     void setRunDims(dim outerDims, dim innerDims);
@@ -242,6 +262,8 @@ namespace occa {
      * Description:
      *   Push the next argument that will be passed to the backend kernel.
      *
+     *   Arguments are stored in this handle, so other handles to the same kernel aren't affected.
+     *
      *   See [[kernel.run]] for more information.
      *
      * @endDoc
@@ -296,6 +318,29 @@ namespace occa {
      */
 #include "kernelOperators.hpp_codegen"
 
+    /**
+     * @startDoc{bind}
+     *
+     * Description:
+     *   Validates the arguments once and returns a [[kernelLaunch]] holding them.
+     *   Running the [[kernelLaunch]] skips the argument checks done by [[kernel.operator_parentheses]],
+     *   which is useful when launching small kernels many times.
+     *
+     *   Scalar arguments can be updated in place through [[kernelLaunch.setArg]].
+     *
+     * Argument Override:
+     *    [[kernelArg]]... args
+     *
+     * Returns:
+     *   The bound [[kernelLaunch]]
+     *
+     * @endDoc
+     */
+    kernelLaunch bind(std::initializer_list<kernelArg> args) const;
+
+    template <class ...Args>
+    kernelLaunch bind(const Args &...args) const;
+
     /**
      * @startDoc{free}
      *
@@ -303,11 +348,82 @@ namespace occa {
      *   Free the kernel object.
      *   Calling [[kernel.isInitialized]] will return `false` now.
      *
+     *   Kernels cached by [[device.buildKernel]] are shared between handles,
+     *   so only this handle is released while other handles still use the kernel.
+     *
      * @endDoc
      */
     void free();
   };
 
+  /**
+   * @startDoc{kernelLaunch}
+   *
+   * Description:
+   *   A [[kernel]] together with arguments that were validated by [[kernel.bind]].
+   *
+   *   Memory arguments are checked again only when they are replaced through [[kernelLaunch.setArg]].
+   *   Updating a scalar argument with a value of the same type doesn't allocate.
+   *
+   * @endDoc
+   */
+  class kernelLaunch {
+   private:
+    occa::kernel kernel_;
+    kernelArgDataVector args;
+    bool validated;
+
+   public:
+    kernelLaunch();
+    kernelLaunch(const occa::kernel &kernel__,
+                 const kernelArgDataVector &args_);
+
+    bool isInitialized() const;
+
+    occa::kernel getKernel() const;
+
+    int argumentCount() const;
+
+    /**
+     * @startDoc{setArg}
+     *
+     * Description:
+     *   Replaces the argument at `index`.
+     *   Scalars must keep the type they were bound with.
+     *
+     * @endDoc
+     */
+    template <class T>
+    typename std::enable_if<std::is_arithmetic<T>::value>::type
+    setArg(const int index, const T value) {
+      setScalarArg(index, primitive(value));
+    }
+
+    void setArg(const int index, const kernelArg &arg);
+
+    /**
+     * @startDoc{run}
+     *
+     * Description:
+     *   Launches the kernel with the bound arguments.
+     *
+     * @endDoc
+     */
+    void run() const;
+
+    void operator () () const;
+
+   private:
+    void assertInitialized() const;
+    void assertIndex(const int index) const;
+
+    void setScalarArg(const int index, const primitive &value);
+  };
+
+  template <class ...Args>
+  kernelLaunch kernel::bind(const Args &...args) const {
+    return bind({kernelArg(args)...});
+  }
 
   //---[ Kernel Properties ]------------
   // Properties:
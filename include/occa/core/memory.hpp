@@ -14,6 +14,7 @@ namespace occa {
   class modeMemory_t; class memory;
   class modeDevice_t; class device;
   class kernelArg;
+  class memoryView;
 
   typedef std::map<hash_t,occa::memory>   hashedMemoryMap;
   typedef hashedMemoryMap::iterator       hashedMemoryMapIterator;
@@ -320,6 +321,29 @@ namespace occa {
     occa::memory slice(const dim_t offset,
                        const dim_t count = -1) const;
 
+    /**
+     * @startDoc{view}
+     *
+     * Description:
+     *   Returns a lightweight [[memoryView]] of a subsection of the memory.
+     *   Unlike [[memory.slice]], no backend memory object is created so views are cheap to create in tight loops.
+     *
+     * Arguments:
+     *   offset:
+     *     What index to start the view at
+     *
+     *   count:
+     *     How many indicies the view should have.
+     *     If the default `-1` is passed, it will use the remaining length after `offset`.
+     *
+     * Returns:
+     *   A [[memoryView]] into the memory
+     *
+     * @endDoc
+     */
+    occa::memoryView view(const dim_t offset,
+                          const dim_t count = -1) const;
+
     /**
      * @startDoc{copyFrom[0]}
      *
@@ -476,6 +500,18 @@ namespace occa {
      */
     void free();
 
+    /**
+     * @startDoc{detach}
+     *
+     * Description:
+     *   Releases the memory object without freeing the underlying allocation,
+     *   which the caller then owns and frees.
+     *
+     *   Throws for `Serial` memory allocated with a placement such as `numa_node` or `first_touch`,
+     *   since it can't be released with a regular free.
+     *
+     * @endDoc
+     */
     void detach();
 
     void deleteRefs(const bool freeMemory = false);
@@ -491,6 +527,183 @@ namespace occa {
 
   template <>
   const void* memory::ptr<void>() const;
+
+  //---[ memoryView ]-------------------
+  /**
+   * @startDoc{memoryView}
+   *
+   * Description:
+   *   A [[memoryView]] is a value type describing a subsection of a [[memory]] object:
+   *   the base memory, a byte offset, a size and a dtype.
+   *
+   *   Views can be passed as [[kernel]] arguments and used in copies just like [[memory]] objects,
+   *   but creating one does not allocate or register anything with the [[device]].
+   *   This makes them a better fit than [[memory.slice]] when many subranges are created per step.
+   *
+   *   A view does not hold a reference to the memory it was created from,
+   *   so it should not outlive it.
+   *
+   *   > Passing a view with a non-zero offset to a kernel is not supported in the _OpenCL_ and _Metal_ modes.
+   *
+   * @endDoc
+   */
+  class memoryView {
+  private:
+    modeMemory_t *modeMemory;
+    udim_t offset_;
+    udim_t size_;
+    const dtype_t *dtype_;
+
+  public:
+    memoryView();
+    memoryView(const memory &mem);
+    memoryView(const memory &mem,
+               const dim_t offset,
+               const dim_t count = -1);
+
+  private:
+    memoryView(modeMemory_t *modeMemory_,
+               const udim_t offset,
+               const udim_t bytes,
+               const dtype_t *dtype__);
+
+    void assertInitialized() const;
+    void assertInRange(const char *name,
+                       const udim_t offset,
+                       const udim_t bytes) const;
+
+  public:
+    /**
+     * @startDoc{isInitialized}
+     *
+     * Description:
+     *   Check whether the [[memoryView]] points to initialized [[memory]].
+     *
+     * @endDoc
+     */
+    bool isInitialized() const;
+
+    /**
+     * @startDoc{getMemory}
+     *
+     * Description:
+     *   Returns the [[memory]] object the view was created from
+     *
+     * @endDoc
+     */
+    occa::memory getMemory() const;
+
+    modeMemory_t* getModeMemory() const;
+
+    occa::device getDevice() const;
+
+    /**
+     * @startDoc{ptr}
+     *
+     * Description:
+     *   Returns the backend pointer of the base [[memory]] shifted by the view offset.
+     *   See [[memory.ptr]] for what the pointer is in each mode.
+     *
+     * @endDoc
+     */
+    template <class T = void>
+    T* ptr() const;
+
+    /**
+     * @startDoc{offset}
+     *
+     * Description:
+     *   Returns the offset of the view in bytes, relative to the start of the base [[memory]]
+     *
+     * @endDoc
+     */
+    udim_t offset() const;
+
+    /**
+     * @startDoc{size}
+     *
+     * Description:
+     *   Returns the size of the view in bytes
+     *
+     * @endDoc
+     */
+    udim_t size() const;
+
+    /**
+     * @startDoc{length}
+     *
+     * Description:
+     *   Returns the number of entries in the view, based on its [[dtype_t]]
+     *
+     * @endDoc
+     */
+    udim_t length() const;
+
+    const dtype_t& dtype() const;
+
+    /**
+     * @startDoc{view}
+     *
+     * Description:
+     *   Returns a view of a subsection of this view, same as [[memory.view]]
+     *
+     * @endDoc
+     */
+    memoryView view(const dim_t offset,
+                    const dim_t count = -1) const;
+
+    /**
+     * @startDoc{operator_kernelArg}
+     *
+     * Description:
+     *   Casts to [[kernelArg]] for it to be taken as a [[kernel]] argument
+     *
+     * @endDoc
+     */
+    operator kernelArg() const;
+
+    /**
+     * @startDoc{copyFrom}
+     *
+     * Description:
+     *   Same as [[memory.copyFrom]] where offsets are relative to the start of the view
+     *
+     * @endDoc
+     */
+    void copyFrom(const void *src,
+                  const dim_t bytes = -1,
+                  const dim_t offset = 0,
+                  const occa::json &props = occa::json()) const;
+
+    void copyFrom(const memoryView &src,
+                  const dim_t bytes = -1,
+                  const dim_t destOffset = 0,
+                  const dim_t srcOffset = 0,
+                  const occa::json &props = occa::json()) const;
+
+    /**
+     * @startDoc{copyTo}
+     *
+     * Description:
+     *   Same as [[memory.copyTo]] where offsets are relative to the start of the view
+     *
+     * @endDoc
+     */
+    void copyTo(void *dest,
+                const dim_t bytes = -1,
+                const dim_t offset = 0,
+                const occa::json &props = occa::json()) const;
+
+    void copyTo(const memoryView &dest,
+                const dim_t bytes = -1,
+                const dim_t destOffset = 0,
+                const dim_t srcOffset = 0,
+                const occa::json &props = occa::json()) const;
+  };
+
+  template <>
+  void* memoryView::ptr<void>() const;
+  //====================================
 }
 
 #include "memory.tpp"
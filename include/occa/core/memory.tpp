@@ -8,4 +8,9 @@ namespace occa {
   const T* memory::ptr() const {
     return (const T*) ptr<void>();
   }
+
+  template <class T>
+  T* memoryView::ptr() const {
+    return (T*) ptr<void>();
+  }
 }
@@ -15,6 +15,9 @@
 #define OKL_VERSION       10012
 #define OKL_VERSION_STR   "1.0.12"
 
+// Bump when hashing or the cache layout changes so old cache entries aren't reused
+#define OCCA_CACHE_VERSION 2
+
 #define OCCA_MAX_ARGS 50
 
 #define OCCA_DEFAULT_MEM_BYTE_ALIGN 32
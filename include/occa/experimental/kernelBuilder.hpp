@@ -1,20 +1,65 @@
 #ifndef OCCA_EXPERIMENTAL_CORE_KERNELBUILDER_HEADER
 #define OCCA_EXPERIMENTAL_CORE_KERNELBUILDER_HEADER
 
+#include <mutex>
+#include <vector>
+
 #include <occa/core/kernel.hpp>
 #include <occa/functional/scope.hpp>
 
 namespace occa {
+  class modeDevice_t;
+
+  // Parts of a scope argument which show up in the generated kernel source
+  class jitArgSignature_t {
+  public:
+    std::string name;
+    std::string dtypeName;
+    bool isConst;
+    std::vector<bool> isPointer;
+
+    jitArgSignature_t(const scopeKernelArg &arg);
+
+    bool matches(const scopeKernelArg &arg) const;
+  };
+
+  // A built kernel with the scope signature it was built for, letting
+  //   repeated launches skip hashing the scope and looking up arguments by name
+  class jitKernel_t {
+  public:
+    modeDevice_t *modeDevice;
+    occa::json props;
+    std::vector<jitArgSignature_t> args;
+    occa::kernel kernel;
+    // Scope argument index for each kernel argument
+    std::vector<int> argIndices;
+
+    jitKernel_t(const occa::scope &scope,
+                occa::kernel kernel_);
+
+    bool matches(const occa::scope &scope) const;
+  };
+
   class kernelBuilder {
   private:
     std::string source;
     std::string kernelName;
     hashedKernelMap kernelMap;
 
+    std::vector<jitKernel_t> jitKernels;
+    int lastJitKernel;
+
+    // Builders are usually function-local statics (OCCA_JIT), shared by every calling thread
+    mutable std::mutex mutex;
+
   public:
     kernelBuilder(const std::string &source_,
                   const std::string &kernelName_);
 
+    kernelBuilder(const kernelBuilder &other);
+
+    kernelBuilder& operator = (const kernelBuilder &other);
+
     bool isInitialized();
 
     std::string getKernelName();
@@ -27,6 +72,11 @@ namespace occa {
     void run(const occa::scope &scope);
 
     void free();
+
+  private:
+    occa::kernel unsafeGetOrBuildKernel(const occa::scope &scope);
+
+    jitKernel_t& getJitKernel(const occa::scope &scope);
   };
 }
 
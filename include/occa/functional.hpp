@@ -2,7 +2,9 @@
 #define OCCA_FUNCTIONAL_HEADER
 
 #include <occa/functional/array.hpp>
+#include <occa/functional/arrayHostView.hpp>
 #include <occa/functional/function.hpp>
+#include <occa/functional/lazyArray.hpp>
 #include <occa/functional/range.hpp>
 #include <occa/functional/scope.hpp>
 #include <occa/functional/utils.hpp>
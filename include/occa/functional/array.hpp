@@ -1,16 +1,23 @@
 #ifndef OCCA_FUNCTIONAL_ARRAY_HEADER
 #define OCCA_FUNCTIONAL_ARRAY_HEADER
 
+#include <occa/functional/arrayHostView.hpp>
 #include <occa/functional/typelessArray.hpp>
 
 namespace occa {
   class kernelArg;
 
+  template <class T>
+  class lazyArray;
+
   template <class T>
   class array : public typelessArray {
     template <class T2>
     friend class array;
 
+    template <class T2>
+    friend class lazyArray;
+
   private:
     occa::memory memory_;
 
@@ -68,6 +75,53 @@ namespace occa {
       return "occa_array_ptr[0]";
     }
 
+    // Results can be empty, which still belong to the device
+    static array fromMemory(occa::device device, occa::memory mem) {
+      if (mem.isInitialized()) {
+        return array(mem);
+      }
+      array emptyArray;
+      emptyArray.setupTypelessArray(device, dtype::get<T>());
+      return emptyArray;
+    }
+
+    array filterArray(const baseFunction &fn) const {
+      occa::scope scope = getMapArrayScope(fn);
+      scope.props["defines/OCCA_ARRAY_COMPACT_COUNT(INDEX, COUNT)"] = (
+        "if (OCCA_ARRAY_FUNCTION_CALL(INDEX)) { ++COUNT; }"
+      );
+      scope.props["defines/OCCA_ARRAY_COMPACT_WRITE(INDEX, OFFSET)"] = (
+        "if (OCCA_ARRAY_FUNCTION_CALL(INDEX)) { occa_array_output[OFFSET] = occa_array_ptr[INDEX]; ++OFFSET; }"
+      );
+
+      return fromMemory(device_, typelessCompact<T>(scope));
+    }
+
+    T& getEntry(const dim_t index) const {
+      // Host-resident memory can be referenced directly once queued kernels finish
+      occa::device memoryDevice = memory_.getDevice();
+      if (!memoryDevice.hasSeparateMemorySpace()) {
+        memoryDevice.finish();
+        return ((T*) memory_.ptr<T>())[index];
+      }
+      static thread_local T value;
+      memory_.copyTo(&value,
+                     sizeof(T),
+                     index * sizeof(T));
+      return value;
+    }
+
+    udim_t getRangeCount(const dim_t offset,
+                         const dim_t count) const {
+      OCCA_ERROR("Offset [" << offset << "] is out of bounds for an array of length " << length(),
+                 (0 <= offset) && ((udim_t) offset <= length()));
+      return (
+        count < 0
+        ? length() - offset
+        : count
+      );
+    }
+
   public:
     //---[ Memory methods ]-------------
     bool isInitialized() const {
@@ -168,6 +222,17 @@ namespace occa {
 
     //---[ Lambda methods ]-------------
   public:
+    /**
+     * @startDoc{lazy}
+     *
+     * Description:
+     *   Start a [[lazyArray]] pipeline, fusing chained `map` and `filter` calls
+     *   with the final operation into a single kernel
+     *
+     * @endDoc
+     */
+    lazyArray<T> lazy() const;
+
     bool every(const occa::function<bool(const T&)> &fn) const {
       return typelessEvery(fn);
     }
@@ -192,6 +257,26 @@ namespace occa {
       return typelessSome(fn);
     }
 
+    /**
+     * @startDoc{filter}
+     *
+     * Description:
+     *   Return a new array with the values where `fn` returns `true`, keeping their order
+     *
+     * @endDoc
+     */
+    array filter(const occa::function<bool(const T&)> &fn) const {
+      return filterArray(fn);
+    }
+
+    array filter(const occa::function<bool(const T&, const int)> &fn) const {
+      return filterArray(fn);
+    }
+
+    array filter(const occa::function<bool(const T&, const int, const T*)> &fn) const {
+      return filterArray(fn);
+    }
+
     int findIndex(const occa::function<bool(const T&)> &fn) const {
       return typelessFindIndex(fn);
     }
@@ -296,19 +381,50 @@ namespace occa {
 
     //---[ Utility methods ]------------
     T& operator [] (const dim_t index) {
-      static T value;
-      memory_.copyTo(&value,
-                     sizeof(T),
-                     index * sizeof(T));
-      return value;
+      return getEntry(index);
     }
 
     T& operator [] (const dim_t index) const {
-      static T value;
-      memory_.copyTo(&value,
-                     sizeof(T),
-                     index * sizeof(T));
-      return value;
+      return getEntry(index);
+    }
+
+    /**
+     * @startDoc{hostView}
+     *
+     * Description:
+     *   Return an [[arrayHostView]] of the whole array for reading and writing values on the host.
+     *   Values are written back to the array when the view goes out of scope.
+     *
+     *   Prefer it to `operator []` in host loops, which copies one value per call
+     *   on devices with a separate memory space.
+     *
+     * @endDoc
+     */
+    arrayHostView<T> hostView() {
+      return arrayHostView<T>(memory_, 0, length());
+    }
+
+    arrayHostView<const T> hostView() const {
+      return arrayHostView<const T>(memory_, 0, length());
+    }
+
+    /**
+     * @startDoc{mappedRange}
+     *
+     * Description:
+     *   Same as [[array.hostView]] but only for the `count` values starting at `offset`.
+     *   If `count` is negative, the range goes to the end of the array.
+     *
+     * @endDoc
+     */
+    arrayHostView<T> mappedRange(const dim_t offset,
+                                 const dim_t count = -1) {
+      return arrayHostView<T>(memory_, offset, getRangeCount(offset, count));
+    }
+
+    arrayHostView<const T> mappedRange(const dim_t offset,
+                                       const dim_t count = -1) const {
+      return arrayHostView<const T>(memory_, offset, getRangeCount(offset, count));
     }
 
     array slice(const dim_t offset,
@@ -484,6 +600,120 @@ namespace occa {
         })
       );
     }
+
+    /**
+     * @startDoc{multiReduce}
+     *
+     * Description:
+     *   Compute several reductions, such as `min`, `max` and `sum`, reading the array once.
+     *   Results are returned in the same order as `types`.
+     *
+     *   ?> Reductions of an empty array return the identity of each reduction type
+     *
+     * @endDoc
+     */
+    std::vector<T> multiReduce(const std::vector<reductionType> &types) const {
+      if (!types.size()) {
+        return std::vector<T>();
+      }
+      return typelessMultiReduce<T>(memory_, types);
+    }
+    //==================================
+
+    //---[ Parallel Primitives ]--------
+    /**
+     * @startDoc{inclusiveScan}
+     *
+     * Description:
+     *   Return the running reduction of the array, where entry `i` includes value `i`
+     *
+     * @endDoc
+     */
+    array inclusiveScan(reductionType type = reductionType::sum) const {
+      occa::memory output = device_.template malloc<T>(length());
+      typelessScan<T>(memory_, output, type, true);
+      return fromMemory(device_, output);
+    }
+
+    /**
+     * @startDoc{exclusiveScan}
+     *
+     * Description:
+     *   Return the running reduction of the array, where entry `i` only includes values before `i`
+     *
+     * @endDoc
+     */
+    array exclusiveScan(reductionType type = reductionType::sum) const {
+      occa::memory output = device_.template malloc<T>(length());
+      typelessScan<T>(memory_, output, type, false);
+      return fromMemory(device_, output);
+    }
+
+    /**
+     * @startDoc{sort}
+     *
+     * Description:
+     *   Return a new array with the values sorted in ascending order
+     *
+     * @endDoc
+     */
+    array sort() const {
+      if (!length()) {
+        return fromMemory(device_, occa::memory());
+      }
+
+      occa::memory keys = memory_.clone();
+      occa::memory indices;
+      typelessRadixSort<T>(keys, indices);
+
+      return array(keys);
+    }
+
+    /**
+     * @startDoc{sortedIndices}
+     *
+     * Description:
+     *   Return the indices which sort the array, keeping equal values in their original order
+     *
+     * @endDoc
+     */
+    array<int> sortedIndices() const {
+      if (!length()) {
+        return array<int>::fromMemory(device_, occa::memory());
+      }
+
+      array<int> indices = map<int>(
+        OCCA_FUNCTION([=](const T &value, const int index) -> int {
+          return index;
+        })
+      );
+
+      occa::memory keys = memory_.clone();
+      typelessRadixSort<T>(keys, indices.memory_);
+
+      return array<int>(indices.memory_);
+    }
+
+    /**
+     * @startDoc{histogram}
+     *
+     * Description:
+     *   Count the values in `[minValue, maxValue)` into `binCount` bins of equal width
+     *
+     * @endDoc
+     */
+    array<int> histogram(const int binCount,
+                         const T minValue,
+                         const T maxValue) const {
+      OCCA_ERROR("Histograms need at least one bin",
+                 binCount > 0);
+      OCCA_ERROR("Histogram range [" << minValue << ", " << maxValue << ") is empty",
+                 minValue < maxValue);
+
+      return array<int>(
+        typelessHistogram<T>(memory_, binCount, minValue, maxValue)
+      );
+    }
     //==================================
 
     //---[ Linear Algebra Methods ]-----
@@ -542,4 +772,6 @@ namespace occa {
   };
 }
 
+#include <occa/functional/lazyArray.hpp>
+
 #endif
@@ -0,0 +1,131 @@
+#ifndef OCCA_FUNCTIONAL_ARRAYHOSTVIEW_HEADER
+#define OCCA_FUNCTIONAL_ARRAYHOSTVIEW_HEADER
+
+#include <type_traits>
+
+#include <occa/core.hpp>
+
+namespace occa {
+  /**
+   * @startDoc{arrayHostView}
+   *
+   * Description:
+   *   Host access to a range of an [[array]], created through [[array.hostView]] or [[array.mappedRange]].
+   *
+   *   If the device shares the host memory space (for example `Serial` or `OpenMP`),
+   *   the view points directly to the array data and nothing is copied.
+   *   The device is finished first, so kernels queued on an async stream are done.
+   *   Otherwise the range is copied to the host once when the view is created and,
+   *   unless `T` is `const`, copied back when the view goes out of scope.
+   *
+   *   ?> Kernels using the array shouldn't run while a copied view is alive,
+   *   ?> since its values are only written back when the view is destroyed.
+   *
+   * @endDoc
+   */
+  template <class T>
+  class arrayHostView {
+  public:
+    typedef typename std::remove_const<T>::type value_t;
+
+  private:
+    occa::memory memory_;
+    udim_t offset_;
+    udim_t size_;
+    T *ptr_;
+    // Only set when the range was copied to the host
+    value_t *hostBuffer;
+
+  public:
+    arrayHostView(occa::memory mem,
+                  const udim_t offset,
+                  const udim_t count) :
+      memory_(mem),
+      offset_(offset),
+      size_(count),
+      ptr_(NULL),
+      hostBuffer(NULL) {
+
+      OCCA_ERROR("Host view [" << offset << ", " << (offset + count) << ")"
+                 << " is out of bounds for an array of length " << memory_.length(),
+                 (offset + count) <= memory_.length());
+
+      if (!size_) {
+        return;
+      }
+
+      occa::device memoryDevice = memory_.getDevice();
+      if (!memoryDevice.hasSeparateMemorySpace()) {
+        // Kernels queued on an async stream may still write to the array
+        memoryDevice.finish();
+        ptr_ = memory_.ptr<value_t>() + offset_;
+        return;
+      }
+
+      hostBuffer = new value_t[size_];
+      memory_.copyTo(hostBuffer,
+                     size_ * sizeof(value_t),
+                     offset_ * sizeof(value_t));
+      ptr_ = hostBuffer;
+    }
+
+    arrayHostView(arrayHostView<T> &&other) :
+      memory_(other.memory_),
+      offset_(other.offset_),
+      size_(other.size_),
+      ptr_(other.ptr_),
+      hostBuffer(other.hostBuffer) {
+      other.ptr_ = NULL;
+      other.hostBuffer = NULL;
+    }
+
+    arrayHostView(const arrayHostView<T> &other) = delete;
+    arrayHostView& operator = (const arrayHostView<T> &other) = delete;
+
+    ~arrayHostView() {
+      if (!hostBuffer) {
+        return;
+      }
+      if (!std::is_const<T>::value) {
+        memory_.copyFrom(hostBuffer,
+                         size_ * sizeof(value_t),
+                         offset_ * sizeof(value_t));
+      }
+      delete [] hostBuffer;
+    }
+
+    /**
+     * @startDoc{isZeroCopy}
+     *
+     * Description:
+     *   Returns `true` if the view points directly to the array data instead of a host copy
+     *
+     * @endDoc
+     */
+    bool isZeroCopy() const {
+      return ptr_ && !hostBuffer;
+    }
+
+    T* data() const {
+      return ptr_;
+    }
+
+    udim_t size() const {
+      return size_;
+    }
+
+    T& operator [] (const dim_t index) const {
+      return ptr_[index];
+    }
+
+    T* begin() const {
+      return ptr_;
+    }
+
+    T* end() const {
+      return ptr_ + size_;
+    }
+  };
+}
+
+#endif
@@ -0,0 +1,401 @@
+#ifndef OCCA_FUNCTIONAL_LAZYARRAY_HEADER
+#define OCCA_FUNCTIONAL_LAZYARRAY_HEADER
+
+#include <memory>
+#include <vector>
+
+#include <occa/functional/array.hpp>
+
+namespace occa {
+  class lazyArrayStage {
+  public:
+    std::shared_ptr<baseFunction> fn;
+    bool isFilter;
+    // Type of the value after a map stage
+    std::string valueType;
+  };
+
+  /**
+   * @startDoc{lazyArray}
+   *
+   * Description:
+   *   Deferred chain of `map` and `filter` operations on an [[array]], created through [[array.lazy]].
+   *
+   *   Nothing is launched until a terminal method (such as `reduce`, `forEach`, or `toArray`) is called.
+   *   The whole chain is then fused into a single kernel which reads the array once and
+   *   doesn't allocate intermediate arrays.
+   *
+   *   ?> Stages only see the current value and its index in the original array,
+   *   ?> since intermediate values are never stored.
+   *
+   * @endDoc
+   */
+  template <class T>
+  class lazyArray : public typelessArray {
+    template <class T2>
+    friend class lazyArray;
+
+  private:
+    occa::memory memory_;
+    std::vector<lazyArrayStage> stages;
+    // Captured variables from every stage, passed to the fused kernel
+    occa::scope stagesScope;
+
+  public:
+    lazyArray(occa::memory mem) :
+      typelessArray(),
+      memory_(mem) {
+      setupTypelessArray(memory_);
+    }
+
+    lazyArray(const lazyArray<T> &other) :
+      typelessArray(other),
+      memory_(other.memory_),
+      stages(other.stages),
+      stagesScope(other.stagesScope) {}
+
+    lazyArray& operator = (const lazyArray<T> &other) {
+      typelessArray::operator = (other);
+      memory_ = other.memory_;
+      stages = other.stages;
+      stagesScope = other.stagesScope;
+
+      return *this;
+    }
+
+  private:
+    occa::scope getLazyArrayScope() const {
+      occa::scope lazyScope({
+        {"occa_array_ptr", memory_}
+      });
+
+      const int stageCount = (int) stages.size();
+      for (int i = 0; i < stageCount; ++i) {
+        lazyScope.props["functions/" + getStageFunctionName(i)] = stages[i].fn->hash();
+      }
+
+      return lazyScope + stagesScope;
+    }
+
+    occa::scope getMapArrayScopeOverrides() const {
+      return getLazyArrayScope();
+    }
+
+    occa::scope getReduceArrayScopeOverrides() const {
+      occa::scope lazyScope = getLazyArrayScope();
+      lazyScope.props["defines/OCCA_ARRAY_REDUCTION_STEP(ACC, INDEX)"] = buildPipelineSource(
+        "ACC = OCCA_ARRAY_FUNCTION(ACC, occa_lazy_array_value, INDEX, occa_array_ptr);"
+      );
+      return lazyScope;
+    }
+
+    std::string reductionInitialValue() const {
+      // Reductions always pass their identity since the first value might be filtered out
+      return "";
+    }
+
+    static std::string getStageFunctionName(const int stageIndex) {
+      return "occa_array_stage_" + std::to_string(stageIndex);
+    }
+
+    static std::string getStageValueName(const int stageIndex) {
+      return "occa_lazy_value_" + std::to_string(stageIndex);
+    }
+
+    // Builds a block which runs every stage on [INDEX] and calls outputStatement
+    //   with the final value as [occa_lazy_array_value] if no filter rejected it
+    std::string buildPipelineSource(const std::string &outputStatement) const {
+      std::string source = "{ const ";
+      source += memory_.dtype().name();
+      source += ' ' + getStageValueName(0) + " = occa_array_ptr[INDEX];";
+
+      std::string valueName = getStageValueName(0);
+      std::string valueType = memory_.dtype().name();
+      int openScopes = 1;
+
+      const int stageCount = (int) stages.size();
+      for (int i = 0; i < stageCount; ++i) {
+        const lazyArrayStage &stage = stages[i];
+
+        strVector argumentValues = {valueName, "INDEX"};
+        argumentValues.resize(stage.fn->argumentCount());
+
+        const std::string call = stage.fn->buildFunctionCall(getStageFunctionName(i),
+                                                             argumentValues);
+        if (stage.isFilter) {
+          source += " if (" + call + ") {";
+          ++openScopes;
+        } else {
+          valueName = getStageValueName(i + 1);
+          valueType = stage.valueType;
+          source += " const " + valueType + ' ' + valueName + " = " + call + ';';
+        }
+      }
+
+      source += " const " + valueType + " occa_lazy_array_value = " + valueName + ';';
+      source += ' ' + outputStatement;
+      for (int i = 0; i < openScopes; ++i) {
+        source += " }";
+      }
+
+      return source;
+    }
+
+    // Every captured variable becomes a kernel argument, so names can't repeat
+    void checkCapturedNames(const occa::scope &fnScope) const {
+      for (const scopeKernelArg &arg : fnScope.args) {
+        for (const scopeKernelArg &stageArg : stagesScope.args) {
+          OCCA_ERROR("Lazy array stages capture [" << arg.name << "] more than once",
+                     arg.name != stageArg.name);
+        }
+      }
+    }
+
+    template <class T2>
+    lazyArray<T2> addStage(const std::shared_ptr<baseFunction> &fn,
+                           const bool isFilter) const {
+      lazyArray<T2> next(memory_);
+      next.typelessArray::operator = (*this);
+      next.stages = stages;
+      next.stagesScope = stagesScope;
+      checkCapturedNames(fn->scope);
+      next.stagesScope += fn->scope;
+
+      lazyArrayStage stage;
+      stage.fn = fn;
+      stage.isFilter = isFilter;
+      stage.valueType = dtype::get<T2>().name();
+      next.stages.push_back(stage);
+
+      return next;
+    }
+
+    template <class T2, class Function>
+    lazyArray<T2> addMapStage(const Function &fn) const {
+      return addStage<T2>(std::make_shared<Function>(fn), false);
+    }
+
+    template <class Function>
+    lazyArray<T> addFilterStage(const Function &fn) const {
+      return addStage<T>(std::make_shared<Function>(fn), true);
+    }
+
+    bool hasFilter() const {
+      for (const lazyArrayStage &stage : stages) {
+        if (stage.isFilter) {
+          return true;
+        }
+      }
+      return false;
+    }
+
+    // [T] is defined as the original array type in the kernel, not the current value type
+    static occa::scope getValueTypeScope() {
+      return occa::scope({}, {
+        {"defines/T", dtype::get<T>().name()}
+      });
+    }
+
+    template <class T2>
+    T2 lazyReduce(reductionType type,
+                  const T2 &localInit,
+                  const baseFunction &fn) const {
+      checkCapturedNames(fn.scope);
+      return typelessReduce<T2>(type, localInit, true, fn);
+    }
+
+  public:
+    udim_t length() const {
+      return memory_.length();
+    }
+
+    //---[ Stages ]---------------------
+    /**
+     * @startDoc{map}
+     *
+     * Description:
+     *   Add a stage which transforms each value, without launching a kernel
+     *
+     * @endDoc
+     */
+    template <class T2>
+    lazyArray<T2> map(const occa::function<T2(const T&)> &fn) const {
+      return addMapStage<T2>(fn);
+    }
+
+    template <class T2>
+    lazyArray<T2> map(const occa::function<T2(const T&, const int)> &fn) const {
+      return addMapStage<T2>(fn);
+    }
+
+    /**
+     * @startDoc{filter}
+     *
+     * Description:
+     *   Add a stage which drops values where `fn` returns `false`, without launching a kernel
+     *
+     * @endDoc
+     */
+    lazyArray filter(const occa::function<bool(const T&)> &fn) const {
+      return addFilterStage(fn);
+    }
+
+    lazyArray filter(const occa::function<bool(const T&, const int)> &fn) const {
+      return addFilterStage(fn);
+    }
+    //==================================
+
+    //---[ Terminal methods ]-----------
+    void forEach(const occa::function<void(const T&)> &fn) const {
+      lazyForEach(fn);
+    }
+
+    void forEach(const occa::function<void(const T&, const int)> &fn) const {
+      lazyForEach(fn);
+    }
+
+    /**
+     * @startDoc{mapTo}
+     *
+     * Description:
+     *   Run the fused stages and store the final values in `output`.
+     *
+     *   ?> Values dropped by `filter` stages are skipped, so `output` is resized to the kept values
+     *
+     * @endDoc
+     */
+    array<T> mapTo(array<T> &output) const {
+      if (hasFilter()) {
+        output = toArray();
+        return output;
+      }
+
+      output.resize(device_, length());
+      occa::memory outputMemory = output.memory();
+
+      occa::scope scope = getMapArrayScope();
+      scope.add("occa_array_output", outputMemory);
+      scope.props["defines/OCCA_LAZY_ARRAY_PIPELINE(INDEX)"] = buildPipelineSource(
+        "occa_array_output[INDEX] = occa_lazy_array_value;"
+      );
+
+      OCCA_JIT(scope, (
+        OCCA_ARRAY_TILE_FOR_LOOP {
+          OCCA_ARRAY_TILE_PARALLEL_FOR_LOOP {
+            OCCA_LAZY_ARRAY_PIPELINE(i);
+          }
+        }
+      ));
+
+      return output;
+    }
+
+    array<T> toArray() const {
+      if (!hasFilter()) {
+        array<T> output(device_, length());
+        return mapTo(output);
+      }
+
+      // Count the kept values per block first to find where each block writes
+      occa::scope scope = getMapArrayScope();
+      scope.props["defines/OCCA_ARRAY_COMPACT_COUNT(INDEX, COUNT)"] = buildPipelineSource(
+        "++COUNT;"
+      );
+      scope.props["defines/OCCA_ARRAY_COMPACT_WRITE(INDEX, OFFSET)"] = buildPipelineSource(
+        "occa_array_output[OFFSET] = occa_lazy_array_value; ++OFFSET;"
+      );
+
+      return array<T>::fromMemory(device_, typelessCompact<T>(scope));
+    }
+
+    template <class T2>
+    T2 reduce(reductionType type,
+              const occa::function<T2(const T2&, const T&)> &fn) const {
+      return lazyReduce<T2>(type, functional::reductionIdentity<T2>(type), fn);
+    }
+
+    template <class T2>
+    T2 reduce(reductionType type,
+              const occa::function<T2(const T2&, const T&, const int)> &fn) const {
+      return lazyReduce<T2>(type, functional::reductionIdentity<T2>(type), fn);
+    }
+
+    template <class T2>
+    T2 reduce(reductionType type,
+              const T2 &localInit,
+              const occa::function<T2(const T2&, const T&)> &fn) const {
+      return lazyReduce<T2>(type, localInit, fn);
+    }
+
+    template <class T2>
+    T2 reduce(reductionType type,
+              const T2 &localInit,
+              const occa::function<T2(const T2&, const T&, const int)> &fn) const {
+      return lazyReduce<T2>(type, localInit, fn);
+    }
+
+    T sum() const {
+      return reduce<T>(
+        reductionType::sum,
+        OCCA_FUNCTION(getValueTypeScope(), [=](const T &acc, const T &value) -> T {
+          return acc + value;
+        })
+      );
+    }
+
+    T max() const {
+      return reduce<T>(
+        reductionType::max,
+        OCCA_FUNCTION(getValueTypeScope(), [=](const T &currentMax, const T &value) -> T {
+          return currentMax > value ? currentMax : value;
+        })
+      );
+    }
+
+    T min() const {
+      return reduce<T>(
+        reductionType::min,
+        OCCA_FUNCTION(getValueTypeScope(), [=](const T &currentMin, const T &value) -> T {
+          return currentMin < value ? currentMin : value;
+        })
+      );
+    }
+
+    int count() const {
+      return reduce<int>(
+        reductionType::sum,
+        OCCA_FUNCTION(getValueTypeScope(), [=](const int &acc, const T &value) -> int {
+          return acc + 1;
+        })
+      );
+    }
+    //==================================
+
+  private:
+    void lazyForEach(const baseFunction &fn) const {
+      checkCapturedNames(fn.scope);
+
+      occa::scope scope = getMapArrayScope(fn);
+      scope.props["defines/OCCA_LAZY_ARRAY_PIPELINE(INDEX)"] = buildPipelineSource(
+        "OCCA_ARRAY_FUNCTION(occa_lazy_array_value, INDEX, occa_array_ptr);"
+      );
+
+      OCCA_JIT(scope, (
+        OCCA_ARRAY_TILE_FOR_LOOP {
+          OCCA_ARRAY_TILE_PARALLEL_FOR_LOOP {
+            OCCA_LAZY_ARRAY_PIPELINE(i);
+          }
+        }
+      ));
+    }
+  };
+
+  template <class T>
+  lazyArray<T> array<T>::lazy() const {
+    lazyArray<T> lazyArray_(memory_);
+    lazyArray_.setTileSize(tileSize, tileIterations);
+    return lazyArray_;
+  }
+}
+
+#endif
@@ -1,6 +1,11 @@
 #ifndef OCCA_FUNCTIONAL_TYPELESSARRAY_HEADER
 #define OCCA_FUNCTIONAL_TYPELESSARRAY_HEADER
 
+#include <algorithm>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
 #include <occa/defines/okl.hpp>
 #include <occa/dtype.hpp>
 #include <occa/core.hpp>
@@ -51,7 +56,7 @@ namespace occa {
       return occa::scope();
     }
 
-    occa::scope getMapArrayScope(const baseFunction &fn) const {
+    occa::scope getMapArrayScope() const {
       const int arrayLength = (int) length();
 
       const int safeTileSize = std::min(
@@ -74,10 +79,8 @@ namespace occa {
         {"defines/T", dtype_.name()},
         {"defines/OCCA_ARRAY_TILE_SIZE", safeTileSize},
         {"defines/OCCA_ARRAY_TILE_ITERATIONS", safeTileIterations},
-        {"defines/OCCA_ARRAY_FUNCTION(VALUE, INDEX, VALUES_PTR)", buildMapFunctionCall(fn)},
         {"defines/OCCA_ARRAY_TILE_FOR_LOOP", tileForLoop},
-        {"defines/OCCA_ARRAY_TILE_PARALLEL_FOR_LOOP", parallelForLoop},
-        {"functions/occa_array_function", fn}
+        {"defines/OCCA_ARRAY_TILE_PARALLEL_FOR_LOOP", parallelForLoop}
       });
 
       baseScope.device = device_;
@@ -85,6 +88,18 @@ namespace occa {
       return (
         baseScope
         + getMapArrayScopeOverrides()
+      );
+    }
+
+    occa::scope getMapArrayScope(const baseFunction &fn) const {
+      occa::scope fnScope({}, {
+        {"defines/OCCA_ARRAY_FUNCTION(VALUE, INDEX, VALUES_PTR)", buildMapFunctionCall(fn)},
+        {"functions/occa_array_function", fn}
+      });
+
+      return (
+        getMapArrayScope()
+        + fnScope
         + fn.scope
       );
     }
@@ -93,17 +108,15 @@ namespace occa {
     occa::scope getCpuReduceArrayScope(reductionType type,
                                        const T2 &localInit,
                                        const bool useLocalInit,
-                                       const baseFunction &fn) const {
+                                       const baseFunction &fn,
+                                       occa::memory partials) const {
       const int arrayLength = (int) length();
-      const int ompLoopSize = 128;
-
-      setupReturnMemoryArray<T2>(ompLoopSize);
 
       occa::json props({
         {"defines/T", dtype_.name()},
         {"defines/T2", dtype::get<T2>().name()},
-        {"defines/OCCA_ARRAY_OMP_LOOP_SIZE", 128},
         {"defines/OCCA_ARRAY_FUNCTION(ACC, VALUE, INDEX, VALUES_PTR)", buildReduceFunctionCall(fn)},
+        {"defines/OCCA_ARRAY_REDUCTION_STEP(ACC, INDEX)", "ACC = OCCA_ARRAY_FUNCTION_CALL(ACC, INDEX)"},
         {"defines/OCCA_ARRAY_LOCAL_REDUCTION(LEFT_VALUE, RIGHT_VALUE)", buildLocalReductionOperation(type)},
         {"functions/occa_array_function", fn}
       });
@@ -116,23 +129,23 @@ namespace occa {
 
       occa::scope baseScope({
         {"occa_array_length", arrayLength},
-        {"occa_array_return", returnMemory}
+        {"occa_array_return", partials}
       }, props);
 
       baseScope.device = device_;
 
       return (
         baseScope
+        + getBlockLoopScope()
         + getReduceArrayScopeOverrides()
         + fn.scope
       );
     }
 
-    template <class T2>
-    occa::scope getGpuReduceArrayScope(reductionType type,
-                                       const T2 &localInit,
-                                       const bool useLocalInit,
-                                       const baseFunction &fn) const {
+    // Each @outer tile reduces [tileSize * tileIterations] entries into one partial
+    void getGpuReduceTiling(int &safeTileSize,
+                            int &safeTileIterations,
+                            int &partialCount) const {
       const int arrayLength = (int) length();
 
       // Default and limit to 1024 if not set
@@ -145,9 +158,9 @@ namespace occa {
       // Limit it to the array length
       unsafeTileSize = std::min(unsafeTileSize, arrayLength);
 
-      // Make sure it's a power of 2
-      int safeTileSize = 1024;
-      while ((safeTileSize > 1) && ((safeTileSize >> 1) > unsafeTileSize)) {
+      // Make sure it's a power of 2, with at least 2 values for the last shared reduction
+      safeTileSize = 1024;
+      while ((safeTileSize > 2) && ((safeTileSize >> 1) > unsafeTileSize)) {
         safeTileSize >>= 1;
       }
 
@@ -157,15 +170,25 @@ namespace occa {
         ? 16
         : tileIterations
       );
-      const int safeTileIterations = std::min(
+      safeTileIterations = std::max(1, std::min(
         defaultTileIterations,
         (arrayLength + safeTileSize - 1) / safeTileSize
-      );
+      ));
 
       const int localReductionSize = safeTileSize * safeTileIterations;
-      const int localReductionCount = (arrayLength + localReductionSize - 1) / localReductionSize;
+      partialCount = std::max(1, (arrayLength + localReductionSize - 1) / localReductionSize);
+    }
 
-      setupReturnMemoryArray<T2>(localReductionCount);
+    template <class T2>
+    occa::scope getGpuReduceArrayScope(reductionType type,
+                                       const T2 &localInit,
+                                       const bool useLocalInit,
+                                       const baseFunction &fn,
+                                       occa::memory partials) const {
+      const int arrayLength = (int) length();
+
+      int safeTileSize, safeTileIterations, partialCount;
+      getGpuReduceTiling(safeTileSize, safeTileIterations, partialCount);
 
       occa::json props({
         {"defines/T", dtype_.name()},
@@ -173,6 +196,7 @@ namespace occa {
         {"defines/OCCA_ARRAY_TILE_SIZE", safeTileSize},
         {"defines/OCCA_ARRAY_TILE_ITERATIONS", safeTileIterations},
         {"defines/OCCA_ARRAY_FUNCTION(ACC, VALUE, INDEX, VALUES_PTR)", buildReduceFunctionCall(fn)},
+        {"defines/OCCA_ARRAY_REDUCTION_STEP(ACC, INDEX)", "ACC = OCCA_ARRAY_FUNCTION_CALL(ACC, INDEX)"},
         {"defines/OCCA_ARRAY_LOCAL_REDUCTION(LEFT_VALUE, RIGHT_VALUE)", buildLocalReductionOperation(type)},
         {"defines/OCCA_ARRAY_SHARED_REDUCTION(BOUNDS)",
          "for (int i = 0; i < OCCA_ARRAY_TILE_SIZE; ++i; @inner) {"
@@ -193,7 +217,7 @@ namespace occa {
 
       occa::scope baseScope({
         {"occa_array_length", arrayLength},
-        {"occa_array_return", returnMemory}
+        {"occa_array_return", partials}
       }, props);
 
       baseScope.device = device_;
@@ -329,6 +353,62 @@ namespace occa {
       return (mode == "Serial" || mode == "OpenMP");
     }
 
+    int getCpuThreadCount() const {
+      if (device_.mode() == "Serial") {
+        return 1;
+      }
+      int threadCount = device_.properties().get("threads", 0);
+      if (threadCount <= 0) {
+        threadCount = (int) std::thread::hardware_concurrency();
+      }
+      return std::max(1, threadCount);
+    }
+
+    // Blocked kernels split the array into contiguous blocks which are
+    //   each traversed in order by a single thread
+    int getBlockCount() const {
+      const int arrayLength = (int) length();
+      const int minBlockSize = 4096;
+
+      // Use a few blocks per thread to balance uneven blocks
+      return std::max(
+        1,
+        std::min(4 * getCpuThreadCount(),
+                 (arrayLength + minBlockSize - 1) / minBlockSize)
+      );
+    }
+
+    occa::scope getBlockArrayScope() const {
+      occa::scope baseScope({
+        {"occa_array_length", (int) length()}
+      }, {
+        {"defines/T", dtype_.name()}
+      });
+
+      baseScope.device = device_;
+
+      return baseScope + getBlockLoopScope();
+    }
+
+    occa::scope getBlockLoopScope() const {
+      const int arrayLength = (int) length();
+      const int blockCount = getBlockCount();
+
+      // Sizes are arguments so arrays of different lengths share kernels
+      return occa::scope({
+        {"occa_array_block_count", blockCount},
+        {"occa_array_block_size", (arrayLength + blockCount - 1) / blockCount}
+      }, {
+        {"defines/OCCA_ARRAY_BLOCK_FOR_LOOP",
+         "for (int blockIndex = 0; blockIndex < occa_array_block_count; ++blockIndex; @outer)"
+         "  for (int dummyIndex = 0; dummyIndex < 1; ++dummyIndex; @inner)"},
+        {"defines/OCCA_ARRAY_BLOCK_FOR_LOOP_INDICES",
+         "for (int i = blockIndex * occa_array_block_size;"
+         " i < occa_array_length && i < (blockIndex + 1) * occa_array_block_size;"
+         " ++i)"}
+      });
+    }
+
   public:
     typelessArray() :
       tileSize(-1),
@@ -488,31 +568,47 @@ namespace occa {
                           const T2 &localInit,
                           const bool useLocalInit,
                           const baseFunction &fn) const {
-      occa::scope scope = getCpuReduceArrayScope<T2>(type, localInit, useLocalInit, fn);
-
-      OCCA_JIT(scope, (
-        for (int ompIndex = 0; ompIndex < OCCA_ARRAY_OMP_LOOP_SIZE; ++ompIndex; @outer) {
-          for (int dummyIndex = 0; dummyIndex < 1; ++dummyIndex; @inner) {
-            const int blockSize = (
-              (occa_array_length + OCCA_ARRAY_OMP_LOOP_SIZE - 1) / OCCA_ARRAY_OMP_LOOP_SIZE
-            );
+      // One partial per block, sized from the thread count
+      const int blockCount = getBlockCount();
 
-            const int startIndex = ompIndex * blockSize;
-            const int unsafeEndIndex = startIndex + blockSize;
-            const int endIndex = occa_array_length < unsafeEndIndex ? occa_array_length : unsafeEndIndex;
+      functional::reductionBuffer buffer(device_, blockCount * sizeof(T2));
+      occa::memory partials = buffer.memory.cast(dtype::get<T2>());
 
-            T2 localAcc = OCCA_ARRAY_REDUCTION_INIT_VALUE;
-
-            for (int i = startIndex; i < endIndex; ++i) {
-              localAcc = OCCA_ARRAY_FUNCTION_CALL(localAcc, i);
-            }
+      occa::scope scope = getCpuReduceArrayScope<T2>(type, localInit, useLocalInit, fn, partials);
 
-            occa_array_return[ompIndex] = localAcc;
+      // Independent accumulators let consecutive steps overlap
+      OCCA_JIT(scope, (
+        OCCA_ARRAY_BLOCK_FOR_LOOP {
+          const int startIndex = blockIndex * occa_array_block_size;
+          const int unsafeEndIndex = startIndex + occa_array_block_size;
+          const int endIndex = occa_array_length < unsafeEndIndex ? occa_array_length : unsafeEndIndex;
+          const int unrolledEndIndex = startIndex + (((endIndex - startIndex) / 4) * 4);
+
+          T2 localAcc = OCCA_ARRAY_REDUCTION_INIT_VALUE;
+          T2 localAcc1 = OCCA_ARRAY_REDUCTION_INIT_VALUE;
+          T2 localAcc2 = OCCA_ARRAY_REDUCTION_INIT_VALUE;
+          T2 localAcc3 = OCCA_ARRAY_REDUCTION_INIT_VALUE;
+
+          for (int i = startIndex; i < unrolledEndIndex; i += 4) {
+            const int i1 = i + 1;
+            const int i2 = i + 2;
+            const int i3 = i + 3;
+            OCCA_ARRAY_REDUCTION_STEP(localAcc, i);
+            OCCA_ARRAY_REDUCTION_STEP(localAcc1, i1);
+            OCCA_ARRAY_REDUCTION_STEP(localAcc2, i2);
+            OCCA_ARRAY_REDUCTION_STEP(localAcc3, i3);
+          }
+          for (int i = unrolledEndIndex; i < endIndex; ++i) {
+            OCCA_ARRAY_REDUCTION_STEP(localAcc, i);
           }
+
+          localAcc = OCCA_ARRAY_LOCAL_REDUCTION(localAcc, localAcc1);
+          localAcc2 = OCCA_ARRAY_LOCAL_REDUCTION(localAcc2, localAcc3);
+          occa_array_return[blockIndex] = OCCA_ARRAY_LOCAL_REDUCTION(localAcc, localAcc2);
         }
       ));
 
-      return finishReturnMemoryReduction<T2>(type);
+      return finishPartialsReduction<T2>(type, partials, blockCount);
     }
 
     template <class T2>
@@ -520,7 +616,13 @@ namespace occa {
                           const T2 &localInit,
                           const bool useLocalInit,
                           const baseFunction &fn) const {
-      occa::scope scope = getGpuReduceArrayScope<T2>(type, localInit, useLocalInit, fn);
+      int safeTileSize, safeTileIterations, partialCount;
+      getGpuReduceTiling(safeTileSize, safeTileIterations, partialCount);
+
+      functional::reductionBuffer buffer(device_, partialCount * sizeof(T2));
+      occa::memory partials = buffer.memory.cast(dtype::get<T2>());
+
+      occa::scope scope = getGpuReduceArrayScope<T2>(type, localInit, useLocalInit, fn, partials);
 
       OCCA_JIT(scope, (
         for (int tileIndex = 0;
@@ -534,9 +636,9 @@ namespace occa {
             T2 localAcc = OCCA_ARRAY_REDUCTION_INIT_VALUE;
 
             for (int i = 0; i < OCCA_ARRAY_TILE_ITERATIONS; ++i) {
-              const int index = tileIndex + (i * OCCA_ARRAY_TILE_ITERATIONS) + localIndex;
+              const int index = tileIndex + (i * OCCA_ARRAY_TILE_SIZE) + localIndex;
               if (index < occa_array_length) {
-                localAcc = OCCA_ARRAY_FUNCTION_CALL(localAcc, index);
+                OCCA_ARRAY_REDUCTION_STEP(localAcc, index);
               }
             }
 
@@ -583,7 +685,7 @@ namespace occa {
             if (i == 0) {
               const T2 leftValue = tileAcc[0];
               const T2 rightValue = tileAcc[1];
-              occa_array_return[tileIndex] = (
+              occa_array_return[tileIndex / (OCCA_ARRAY_TILE_SIZE * OCCA_ARRAY_TILE_ITERATIONS)] = (
                 OCCA_ARRAY_LOCAL_REDUCTION(leftValue, rightValue)
               );
             }
@@ -591,12 +693,417 @@ namespace occa {
         }
       ));
 
-      return finishReturnMemoryReduction<T2>(type);
+      return finishPartialsReduction<T2>(type, partials, partialCount);
     }
 
     template <class T2>
-    T2 finishReturnMemoryReduction(reductionType type) const {
-      return functional::hostReduction<T2>(type, returnMemory);
+    T2 finishPartialsReduction(reductionType type,
+                               occa::memory partials,
+                               const int partialCount) const {
+      T2 *values = new T2[partialCount];
+      partials.copyTo(values, partialCount * sizeof(T2));
+
+      const T2 reductionValue = functional::hostReduction<T2>(type, values, partialCount);
+
+      delete [] values;
+
+      return reductionValue;
+    }
+
+    // Runs every reduction in [types] on the input values in a single pass
+    template <class T2>
+    std::vector<T2> typelessMultiReduce(const occa::memory input,
+                                        const std::vector<reductionType> &types) const {
+      const int typeCount = (int) types.size();
+      const int blockCount = getBlockCount();
+
+      std::vector<T2> reductionValues;
+      if (!length()) {
+        for (int i = 0; i < typeCount; ++i) {
+          reductionValues.push_back(functional::reductionIdentity<T2>(types[i]));
+        }
+        return reductionValues;
+      }
+
+      functional::reductionBuffer buffer(device_, typeCount * blockCount * sizeof(T2));
+      occa::memory partials = buffer.memory.cast(dtype::get<T2>());
+
+      std::string initSource, stepSource, combineSource, returnSource;
+      occa::scope scope = getBlockArrayScope();
+      for (int i = 0; i < typeCount; ++i) {
+        const std::string index = std::to_string(i);
+        const std::string reduction = "OCCA_ARRAY_LOCAL_REDUCTION_" + index;
+
+        scope.props["defines/OCCA_ARRAY_REDUCTION_INIT_VALUE_" + index] = (
+          functional::reductionIdentity<T2>(types[i])
+        );
+        scope.props["defines/" + reduction + "(LEFT_VALUE, RIGHT_VALUE)"] = (
+          buildLocalReductionOperation(types[i])
+        );
+
+        initSource += "ACC[" + index + "] = OCCA_ARRAY_REDUCTION_INIT_VALUE_" + index + "; ";
+        stepSource += (
+          "ACC[" + index + "] = " + reduction + "(ACC[" + index + "], VALUE); "
+        );
+        combineSource += (
+          "localAcc[" + index + "] = " + reduction + "(localAcc[" + index + "], localAcc1[" + index + "]); "
+        );
+        returnSource += (
+          "occa_array_return[" + index + " * occa_array_block_count + blockIndex] = localAcc[" + index + "]; "
+        );
+      }
+
+      scope.add("occa_array_ptr", input);
+      scope.add("occa_array_return", partials);
+      scope.props["defines/T2"] = dtype::get<T2>().name();
+      scope.props["defines/OCCA_ARRAY_REDUCTION_COUNT"] = typeCount;
+      scope.props["defines/OCCA_ARRAY_MULTI_REDUCTION_INIT(ACC)"] = initSource;
+      scope.props["defines/OCCA_ARRAY_MULTI_REDUCTION_STEP(ACC, VALUE)"] = stepSource;
+      scope.props["defines/OCCA_ARRAY_MULTI_REDUCTION_COMBINE"] = combineSource;
+      scope.props["defines/OCCA_ARRAY_MULTI_REDUCTION_RETURN"] = returnSource;
+
+      // Two sets of accumulators let consecutive steps overlap
+      OCCA_JIT(scope, (
+        OCCA_ARRAY_BLOCK_FOR_LOOP {
+          const int startIndex = blockIndex * occa_array_block_size;
+          const int unsafeEndIndex = startIndex + occa_array_block_size;
+          const int endIndex = occa_array_length < unsafeEndIndex ? occa_array_length : unsafeEndIndex;
+          const int unrolledEndIndex = startIndex + (((endIndex - startIndex) / 2) * 2);
+
+          T2 localAcc[OCCA_ARRAY_REDUCTION_COUNT];
+          T2 localAcc1[OCCA_ARRAY_REDUCTION_COUNT];
+          OCCA_ARRAY_MULTI_REDUCTION_INIT(localAcc);
+          OCCA_ARRAY_MULTI_REDUCTION_INIT(localAcc1);
+
+          for (int i = startIndex; i < unrolledEndIndex; i += 2) {
+            const T2 value = occa_array_ptr[i];
+            const T2 value1 = occa_array_ptr[i + 1];
+            OCCA_ARRAY_MULTI_REDUCTION_STEP(localAcc, value);
+            OCCA_ARRAY_MULTI_REDUCTION_STEP(localAcc1, value1);
+          }
+          for (int i = unrolledEndIndex; i < endIndex; ++i) {
+            const T2 value = occa_array_ptr[i];
+            OCCA_ARRAY_MULTI_REDUCTION_STEP(localAcc, value);
+          }
+
+          OCCA_ARRAY_MULTI_REDUCTION_COMBINE;
+          OCCA_ARRAY_MULTI_REDUCTION_RETURN;
+        }
+      ));
+
+      // Partials are grouped by reduction
+      T2 *values = new T2[typeCount * blockCount];
+      partials.copyTo(values, typeCount * blockCount * sizeof(T2));
+
+      for (int i = 0; i < typeCount; ++i) {
+        reductionValues.push_back(
+          functional::hostReduction<T2>(types[i], values + (i * blockCount), blockCount)
+        );
+      }
+
+      delete [] values;
+
+      return reductionValues;
+    }
+
+    template <class T2>
+    void typelessScan(const occa::memory input,
+                      occa::memory output,
+                      reductionType type,
+                      const bool inclusive) const {
+      const int blockCount = getBlockCount();
+
+      functional::reductionBuffer buffer(device_, blockCount * sizeof(T2));
+      occa::memory partials = buffer.memory.cast(dtype::get<T2>());
+
+      occa::scope scope = getBlockArrayScope();
+      scope.add("occa_array_ptr", input);
+      scope.add("occa_array_output", output);
+      scope.add("occa_array_return", partials);
+      scope.props["defines/T2"] = dtype::get<T2>().name();
+      scope.props["defines/OCCA_ARRAY_SCAN_INIT_VALUE"] = functional::reductionIdentity<T2>(type);
+      scope.props["defines/OCCA_ARRAY_INCLUSIVE_SCAN"] = inclusive;
+      scope.props["defines/OCCA_ARRAY_LOCAL_REDUCTION(LEFT_VALUE, RIGHT_VALUE)"] = (
+        buildLocalReductionOperation(type)
+      );
+
+      // Reduce each block so blocks know their starting value
+      if (blockCount > 1) {
+        OCCA_JIT(scope, (
+          OCCA_ARRAY_BLOCK_FOR_LOOP {
+            T2 acc = OCCA_ARRAY_SCAN_INIT_VALUE;
+            OCCA_ARRAY_BLOCK_FOR_LOOP_INDICES {
+              acc = OCCA_ARRAY_LOCAL_REDUCTION(acc, occa_array_ptr[i]);
+            }
+            occa_array_return[blockIndex] = acc;
+          }
+        ));
+      }
+
+      OCCA_JIT(scope, (
+        OCCA_ARRAY_BLOCK_FOR_LOOP {
+          T2 acc = OCCA_ARRAY_SCAN_INIT_VALUE;
+          for (int block = 0; block < blockIndex; ++block) {
+            acc = OCCA_ARRAY_LOCAL_REDUCTION(acc, occa_array_return[block]);
+          }
+          OCCA_ARRAY_BLOCK_FOR_LOOP_INDICES {
+            const T2 value = occa_array_ptr[i];
+            if (OCCA_ARRAY_INCLUSIVE_SCAN) {
+              acc = OCCA_ARRAY_LOCAL_REDUCTION(acc, value);
+              occa_array_output[i] = acc;
+            } else {
+              occa_array_output[i] = acc;
+              acc = OCCA_ARRAY_LOCAL_REDUCTION(acc, value);
+            }
+          }
+        }
+      ));
+    }
+
+    // The scope comes from getMapArrayScope() and defines how each entry is counted and written:
+    //   OCCA_ARRAY_COMPACT_COUNT(INDEX, COUNT)
+    //   OCCA_ARRAY_COMPACT_WRITE(INDEX, OFFSET)
+    // Returns uninitialized memory if no entries are kept
+    template <class T2>
+    occa::memory typelessCompact(occa::scope scope) const {
+      const int blockCount = getBlockCount();
+      occa::memory counts = device_.template malloc<int>(blockCount);
+
+      scope += getBlockLoopScope();
+      scope.add("occa_array_counts", counts);
+
+      OCCA_JIT(scope, (
+        OCCA_ARRAY_BLOCK_FOR_LOOP {
+          int count = 0;
+          OCCA_ARRAY_BLOCK_FOR_LOOP_INDICES {
+            OCCA_ARRAY_COMPACT_COUNT(i, count);
+          }
+          occa_array_counts[blockIndex] = count;
+        }
+      ));
+
+      // Turn the block counts into output offsets
+      std::vector<int> offsets(blockCount);
+      counts.copyTo(offsets.data());
+
+      int outputLength = 0;
+      for (int &offset : offsets) {
+        const int count = offset;
+        offset = outputLength;
+        outputLength += count;
+      }
+
+      occa::memory output = device_.template malloc<T2>(outputLength);
+      if (!outputLength) {
+        return output;
+      }
+      counts.copyFrom(offsets.data());
+
+      scope.add("occa_array_output", output);
+
+      OCCA_JIT(scope, (
+        OCCA_ARRAY_BLOCK_FOR_LOOP {
+          int offset = occa_array_counts[blockIndex];
+          OCCA_ARRAY_BLOCK_FOR_LOOP_INDICES {
+            OCCA_ARRAY_COMPACT_WRITE(i, offset);
+          }
+        }
+      ));
+
+      return output;
+    }
+
+    // Stable LSD radix sort on 8-bit digits, keys are swapped with a buffer each pass
+    // If indices is initialized, its values are permuted along with the keys
+    template <class T2>
+    void typelessRadixSort(occa::memory &keys,
+                           occa::memory &indices) const {
+      const int arrayLength = (int) length();
+      const int keyBits = 8 * sizeof(T2);
+      const int blockCount = getBlockCount();
+      const bool sortIndices = indices.isInitialized();
+
+      // Entries are moved as same-sized integers and their bits are mapped to
+      //   unsigned keys [K] which keep the order of signed and floating point values
+      // dtypes don't keep signedness, so the unsigned type is only named in the source
+      const dtype_t &bitsDtype = (
+        sizeof(T2) == 1
+        ? dtype::int8
+        : sizeof(T2) == 2
+        ? dtype::int16
+        : sizeof(T2) == 4
+        ? dtype::int32
+        : dtype::int64
+      );
+      const std::string keyType = (
+        sizeof(T2) == 1
+        ? "unsigned char"
+        : sizeof(T2) == 2
+        ? "unsigned short"
+        : sizeof(T2) == 4
+        ? "unsigned int"
+        : "unsigned long long"
+      );
+
+      std::string radixKey = "(BITS)";
+      if (std::is_floating_point<T2>::value) {
+        radixKey = "((BITS & OCCA_ARRAY_SIGN_BIT) ? ~BITS : (BITS | OCCA_ARRAY_SIGN_BIT))";
+      } else if (std::is_signed<T2>::value) {
+        radixKey = "(BITS ^ OCCA_ARRAY_SIGN_BIT)";
+      }
+
+      occa::json props({
+        {"defines/K", keyType},
+        {"defines/OCCA_ARRAY_SIGN_BIT", "(((K) 1) << " + std::to_string(keyBits - 1) + ")"},
+        {"defines/OCCA_ARRAY_RADIX_KEY(BITS)", radixKey},
+        {"defines/OCCA_ARRAY_RADIX_DIGIT(BITS, SHIFT)", "((int) ((OCCA_ARRAY_RADIX_KEY(((K) BITS)) >> SHIFT) & 255))"},
+        {"defines/OCCA_ARRAY_SORT_INDEX(POSITION, INDEX)", (
+          sortIndices
+          ? "occa_array_output_indices[POSITION] = occa_array_indices[INDEX]"
+          : ""
+        )}
+      });
+
+      // Casts are views which don't keep their memory alive, so the buffers are kept separately
+      occa::memory keysBuffer = keys;
+      occa::memory destBuffer = device_.malloc(arrayLength, dtype::get<T2>());
+      occa::memory src = keysBuffer.cast(bitsDtype);
+      occa::memory dest = destBuffer.cast(bitsDtype);
+      bool isSwapped = false;
+      occa::memory srcIndices = indices;
+      occa::memory destIndices;
+      if (sortIndices) {
+        destIndices = device_.template malloc<int>(arrayLength);
+      }
+
+      occa::memory counts = device_.template malloc<int>(256 * blockCount);
+      std::vector<int> offsets(256 * blockCount);
+
+      for (int shift = 0; shift < keyBits; shift += 8) {
+        const occa::memory constSrc = src;
+        const occa::memory constSrcIndices = srcIndices;
+
+        occa::scope scope = getBlockArrayScope() + occa::scope(props);
+        scope.add("occa_array_ptr", constSrc);
+        scope.add("occa_array_counts", counts);
+        scope.add("occa_array_shift", shift);
+
+        OCCA_JIT(scope, (
+          OCCA_ARRAY_BLOCK_FOR_LOOP {
+            const int countOffset = 256 * blockIndex;
+            for (int digit = 0; digit < 256; ++digit) {
+              occa_array_counts[countOffset + digit] = 0;
+            }
+            OCCA_ARRAY_BLOCK_FOR_LOOP_INDICES {
+              ++occa_array_counts[countOffset + OCCA_ARRAY_RADIX_DIGIT(occa_array_ptr[i], occa_array_shift)];
+            }
+          }
+        ));
+
+        counts.copyTo(offsets.data());
+
+        // Digit-major offsets keep entries from earlier blocks first
+        bool skipPass = false;
+        int offset = 0;
+        for (int digit = 0; digit < 256; ++digit) {
+          const int digitOffset = offset;
+          for (int block = 0; block < blockCount; ++block) {
+            const int count = offsets[256 * block + digit];
+            offsets[256 * block + digit] = offset;
+            offset += count;
+          }
+          // Every key has the same digit
+          skipPass = skipPass || ((offset - digitOffset) == arrayLength);
+        }
+        if (skipPass) {
+          continue;
+        }
+
+        counts.copyFrom(offsets.data());
+
+        scope.add("occa_array_output", dest);
+        if (sortIndices) {
+          scope.add("occa_array_indices", constSrcIndices);
+          scope.add("occa_array_output_indices", destIndices);
+        }
+
+        OCCA_JIT(scope, (
+          OCCA_ARRAY_BLOCK_FOR_LOOP {
+            const int countOffset = 256 * blockIndex;
+            OCCA_ARRAY_BLOCK_FOR_LOOP_INDICES {
+              const int countIndex = countOffset + OCCA_ARRAY_RADIX_DIGIT(occa_array_ptr[i], occa_array_shift);
+              const int position = occa_array_counts[countIndex];
+              occa_array_counts[countIndex] = position + 1;
+              occa_array_output[position] = occa_array_ptr[i];
+              OCCA_ARRAY_SORT_INDEX(position, i);
+            }
+          }
+        ));
+
+        std::swap(src, dest);
+        std::swap(srcIndices, destIndices);
+        isSwapped = !isSwapped;
+      }
+
+      keys = isSwapped ? destBuffer : keysBuffer;
+      indices = srcIndices;
+    }
+
+    // Counts values in [minValue, maxValue) into uniform bins
+    template <class T2>
+    occa::memory typelessHistogram(const occa::memory input,
+                                   const int binCount,
+                                   const T2 minValue,
+                                   const T2 maxValue) const {
+      const int blockCount = getBlockCount();
+
+      occa::memory output = device_.template malloc<int>(binCount);
+      // A single block counts directly into the output
+      occa::memory blockCounts = (
+        blockCount == 1
+        ? output
+        : device_.template malloc<int>(blockCount * binCount)
+      );
+
+      occa::scope scope = getBlockArrayScope();
+      scope.add("occa_array_ptr", input);
+      scope.add("occa_array_output", output);
+      scope.add("occa_array_counts", blockCounts);
+      scope.add("occa_array_bin_count", binCount);
+      scope.add("occa_array_min_value", minValue);
+      scope.add("occa_array_max_value", maxValue);
+      scope.add("occa_array_bin_scale", binCount / ((double) maxValue - (double) minValue));
+      scope.props["defines/T2"] = dtype::get<T2>().name();
+
+      OCCA_JIT(scope, (
+        OCCA_ARRAY_BLOCK_FOR_LOOP {
+          const int countOffset = occa_array_bin_count * blockIndex;
+          for (int bin = 0; bin < occa_array_bin_count; ++bin) {
+            occa_array_counts[countOffset + bin] = 0;
+          }
+          OCCA_ARRAY_BLOCK_FOR_LOOP_INDICES {
+            const T2 value = occa_array_ptr[i];
+            if ((occa_array_min_value <= value) && (value < occa_array_max_value)) {
+              const int bin = (int) (((double) value - (double) occa_array_min_value) * occa_array_bin_scale);
+              ++occa_array_counts[countOffset + (bin < occa_array_bin_count ? bin : occa_array_bin_count - 1)];
+            }
+          }
+        }
+      ));
+
+      if (blockCount > 1) {
+        OCCA_JIT(scope, (
+          for (int bin = 0; bin < occa_array_bin_count; ++bin; @tile(64, @outer, @inner)) {
+            int count = 0;
+            for (int block = 0; block < occa_array_block_count; ++block) {
+              count += occa_array_counts[(block * occa_array_bin_count) + bin];
+            }
+            occa_array_output[bin] = count;
+          }
+        ));
+      }
+
+      return output;
     }
     //==================================
   };
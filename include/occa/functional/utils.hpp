@@ -1,6 +1,9 @@
 #ifndef OCCA_FUNCTIONAL_UTILS_HEADER
 #define OCCA_FUNCTIONAL_UTILS_HEADER
 
+#include <limits>
+#include <mutex>
+
 #include <occa/defines/macros.hpp>
 #include <occa/functional/types.hpp>
 #include <occa/functional/scope.hpp>
@@ -53,12 +56,27 @@ namespace occa {
     //====================================
 
     //---[ Array ]------------------------
+    // Value which doesn't change the reduction result
     template <class T>
-    T hostReduction(reductionType type, occa::memory mem) {
-      const int entryCount = (int) mem.length();
-      T *values = new T[entryCount];
-      mem.copyTo(values);
+    T reductionIdentity(reductionType type) {
+      switch (type) {
+        case reductionType::multiply:
+          return (T) 1;
+        case reductionType::bitAnd:
+          return (T) ~0;
+        case reductionType::boolAnd:
+          return (T) true;
+        case reductionType::min:
+          return std::numeric_limits<T>::max();
+        case reductionType::max:
+          return std::numeric_limits<T>::lowest();
+        default:
+          return (T) 0;
+      }
+    }
 
+    template <class T>
+    T hostReduction(reductionType type, const T *values, const int entryCount) {
       T reductionValue = values[0];
       switch (type) {
         case reductionType::sum:
@@ -110,19 +128,30 @@ namespace occa {
           break;
       }
 
-      delete [] values;
-
       return reductionValue;
     }
 
     template <>
-    bool hostReduction<bool>(reductionType type, occa::memory mem);
+    bool hostReduction<bool>(reductionType type, const bool *values, const int entryCount);
 
     template <>
-    float hostReduction<float>(reductionType type, occa::memory mem);
+    float hostReduction<float>(reductionType type, const float *values, const int entryCount);
 
     template <>
-    double hostReduction<double>(reductionType type, occa::memory mem);
+    double hostReduction<double>(reductionType type, const double *values, const int entryCount);
+
+    // Scratch memory for reduction partials, shared by every array on a device
+    // The buffer is locked while the object lives so concurrent reductions don't share it
+    class reductionBuffer {
+    private:
+      std::unique_lock<std::mutex> lock;
+
+    public:
+      occa::memory memory;
+
+      reductionBuffer(occa::device device,
+                      const udim_t bytes);
+    };
     //====================================
   }
 }
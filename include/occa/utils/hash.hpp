@@ -18,7 +18,7 @@ namespace occa {
    *   An object used to represent a hash value.
    *   It's intent isn't for security purposes, but rather to distinguish "things".
    *
-   *   > It currently uses FNV hashing since it's quick, but it can be changed if something more useful shows up.
+   *   > It's computed with [[hasher_t]], a streaming 256-bit hash that processes input in 32-byte stripes.
    *
    * @endDoc
    */
@@ -166,6 +166,53 @@ namespace occa {
   std::ostream& operator << (std::ostream &out,
                            const hash_t &hash);
 
+  /**
+   * @startDoc{hasher_t}
+   *
+   * Description:
+   *   Streaming hash builder, feeding data through [[hasher_t.update]] gives the same
+   *   [[hash_t]] as hashing the concatenated data at once.
+   *
+   *   Input is consumed in 32-byte stripes by 4 independent 64-bit lanes,
+   *   so large inputs such as source files hash at memory bandwidth rather than byte by byte.
+   *
+   *   ?> Hashes are seeded with `OCCA_CACHE_VERSION`, bumping it invalidates cached kernels.
+   *
+   * @endDoc
+   */
+  class hasher_t {
+  private:
+    uint64_t lanes[4];
+    unsigned char stripe[32];
+    int stripeBytes;
+    udim_t totalBytes;
+
+  public:
+    hasher_t();
+
+    /**
+     * @startDoc{update}
+     *
+     * Description:
+     *   Appends `bytes` bytes from `ptr` to the hashed data
+     *
+     * @endDoc
+     */
+    void update(const void *ptr, udim_t bytes);
+    void update(const std::string &str);
+
+    /**
+     * @startDoc{digest}
+     *
+     * Description:
+     *   Returns the [[hash_t]] of the data appended so far.
+     *   More data can still be appended afterwards.
+     *
+     * @endDoc
+     */
+    hash_t digest() const;
+  };
+
   hash_t hash(const void *ptr, udim_t bytes);
 
   template <class T>
@@ -192,6 +239,8 @@ namespace occa {
 
   hash_t hash(const char *c);
   hash_t hash(const std::string &str);
+
+  // File hashes are cached process-wide by (path, device, inode, mtime, size)
   hash_t hashFile(const std::string &filename);
 }
 
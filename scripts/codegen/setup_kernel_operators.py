@@ -134,14 +134,14 @@ def operator_definition(N):
   kernelArg args[] = {{
     {array_args}
   }};
-  modeKernel->setArguments(args, {N});
+  setArguments(args, {N});
   run();
 }}
 '''.format(N=N,
            array_args=array_args(N, ' ' * 4))
     else:
         content += ''') const {
-  modeKernel->arguments.clear();
+  arguments.clear();
   run();
 }
 '''
@@ -88,32 +88,53 @@ occaDim occaKernelMaxInnerDims(occaKernel kernel) {
   return cDims;
 }
 
+// C kernels only wrap the mode kernel, so their dimensions and
+//   pushed arguments are stored in it instead of an occa::kernel handle
 void occaKernelSetRunDims(occaKernel kernel,
                           occaDim outerDims,
                           occaDim innerDims) {
-  occa::c::kernel(kernel).setRunDims(
-    occa::dim(outerDims.x, outerDims.y, outerDims.z),
-    occa::dim(innerDims.x, innerDims.y, innerDims.z)
-  );
+  occa::kernel kernel_ = occa::c::kernel(kernel);
+  OCCA_ERROR("Uninitialized kernel",
+             kernel_.isInitialized());
+
+  occa::modeKernel_t &modeKernel = *(kernel_.getModeKernel());
+  modeKernel.outerDims = occa::dim(outerDims.x, outerDims.y, outerDims.z);
+  modeKernel.innerDims = occa::dim(innerDims.x, innerDims.y, innerDims.z);
 }
 
 void occaKernelPushArg(occaKernel kernel,
                        occaType arg) {
+  occa::kernel kernel_ = occa::c::kernel(kernel);
+  OCCA_ERROR("Uninitialized kernel",
+             kernel_.isInitialized());
+
+  occa::modeKernel_t &modeKernel = *(kernel_.getModeKernel());
   if (&arg != &occaNull) {
-    occa::c::kernel(kernel).pushArg(
+    modeKernel.pushArgument(
       occa::c::kernelArg(arg)
     );
   } else {
-    occa::c::kernel(kernel).pushArg(occa::null);
+    modeKernel.pushArgument(occa::null);
   }
 }
 
 void occaKernelClearArgs(occaKernel kernel) {
-  occa::c::kernel(kernel).clearArgs();
+  occa::kernel kernel_ = occa::c::kernel(kernel);
+  if (kernel_.isInitialized()) {
+    kernel_.getModeKernel()->arguments.clear();
+  }
 }
 
 void occaKernelRunFromArgs(occaKernel kernel) {
-  occa::c::kernel(kernel).run();
+  occa::kernel kernel_ = occa::c::kernel(kernel);
+  OCCA_ERROR("Uninitialized kernel",
+             kernel_.isInitialized());
+
+  const occa::kernelArgDataVector &args = kernel_.getModeKernel()->arguments;
+  for (const occa::kernelArgData &arg : args) {
+    kernel_.pushArg(arg);
+  }
+  kernel_.run();
 }
 
 // `occaKernelRun` is reserved for a variadic macro
@@ -134,15 +155,11 @@ void occaKernelVaRun(occaKernel kernel,
   OCCA_ERROR("Uninitialized kernel",
              kernel_.isInitialized());
 
-  occa::modeKernel_t &modeKernel = *(kernel_.getModeKernel());
-  modeKernel.arguments.clear();
-  modeKernel.arguments.reserve(argc);
-
   va_list runArgs;
   va_copy(runArgs, args);
   for (int i = 0; i < argc; ++i) {
     occaType arg = va_arg(runArgs, occaType);
-    modeKernel.pushArgument(
+    kernel_.pushArg(
       occa::c::kernelArg(arg)
     );
   }
@@ -158,12 +175,8 @@ void occaKernelRunWithArgs(occaKernel kernel,
   OCCA_ERROR("Uninitialized kernel",
              kernel_.isInitialized());
 
-  occa::modeKernel_t &modeKernel = *(kernel_.getModeKernel());
-  modeKernel.arguments.clear();
-  modeKernel.arguments.reserve(argc);
-
   for (int i = 0; i < argc; ++i) {
-    modeKernel.pushArgument(
+    kernel_.pushArg(
       occa::c::kernelArg(args[i])
     );
   }
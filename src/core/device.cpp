@@ -1,3 +1,5 @@
+#include <map>
+
 #include <occa/core/device.hpp>
 #include <occa/core/base.hpp>
 #include <occa/internal/core/device.hpp>
@@ -7,6 +9,7 @@
 #include <occa/internal/utils/sys.hpp>
 #include <occa/internal/utils/env.hpp>
 #include <occa/internal/io.hpp>
+#include <occa/utils/exception.hpp>
 
 namespace occa {
   //---[ Utils ]------------------------
@@ -47,6 +50,46 @@ namespace occa {
     objectProps["mode"] = mode;
     return objectProps;
   }
+
+  // Expands the search space into every combination of its candidate values
+  static void getTuningCandidates(const occa::json &searchSpace,
+                                  const std::string &path,
+                                  std::vector<occa::json> &candidates) {
+    if (searchSpace.isArray()) {
+      const jsonArray &values = searchSpace.array();
+      OCCA_ERROR("Search space [" << path << "] has no candidate values",
+                 values.size());
+
+      std::vector<occa::json> newCandidates;
+      for (const occa::json &candidate : candidates) {
+        for (const occa::json &value : values) {
+          occa::json newCandidate = candidate;
+          newCandidate[path] = value;
+          newCandidates.push_back(newCandidate);
+        }
+      }
+      candidates.swap(newCandidates);
+      return;
+    }
+
+    OCCA_ERROR("Search space [" << path << "] must be an object or an array of candidate values",
+               searchSpace.isObject());
+
+    for (const auto &it : searchSpace.object()) {
+      getTuningCandidates(it.second,
+                          path.size() ? (path + "/" + it.first) : it.first,
+                          candidates);
+    }
+  }
+  //====================================
+
+  //---[ Kernel Spec ]------------------
+  kernelSpec::kernelSpec(const std::string &filename_,
+                         const std::string &kernelName_,
+                         const occa::json &props_) :
+    filename(filename_),
+    kernelName(kernelName_),
+    props(props_) {}
   //====================================
 
   device::device() :
@@ -232,6 +275,38 @@ namespace occa {
     return 0;
   }
 
+  udim_t device::peakMemoryAllocated() const {
+    if (modeDevice) {
+      return modeDevice->peakBytesAllocated;
+    }
+    return 0;
+  }
+
+  void device::trimMemoryPool() {
+    if (modeDevice) {
+      modeDevice->trimMemoryPool();
+    }
+  }
+
+  occa::json device::memoryPoolInfo() const {
+    assertInitialized();
+    return modeDevice->memoryPoolInfo();
+  }
+
+  udim_t device::kernelCacheHits() const {
+    if (modeDevice) {
+      return modeDevice->getKernelCacheHits();
+    }
+    return 0;
+  }
+
+  udim_t device::kernelCacheMisses() const {
+    if (modeDevice) {
+      return modeDevice->getKernelCacheMisses();
+    }
+    return 0;
+  }
+
   void device::finish() {
     if (!modeDevice) {
       return;
@@ -355,33 +430,84 @@ namespace occa {
     return kernelHash;
   }
 
+  std::string device::tuningFile(const hash_t &sourceHash,
+                                 const std::string &kernelName) const {
+    assertInitialized();
+
+    return (
+      io::cachePath()
+      + "tuning/"
+      + hash().getString() + "/"
+      + (sourceHash ^ occa::hash(kernelName)).getString()
+      + ".json"
+    );
+  }
+
+  occa::json device::loadTunedProperties(const hash_t &sourceHash,
+                                         const std::string &kernelName) const {
+    const std::string filename = tuningFile(sourceHash, kernelName);
+
+    occa::json tunedProps;
+    if (modeDevice->getTunedProperties(filename, tunedProps)) {
+      return tunedProps;
+    }
+
+    if (io::isFile(filename)) {
+      tunedProps = json::read(filename)["props"];
+    }
+    modeDevice->setTunedProperties(filename, tunedProps);
+
+    return tunedProps;
+  }
+
+  occa::json device::applyTunedProperties(const occa::json &props,
+                                          const hash_t &sourceHash,
+                                          const std::string &kernelName) const {
+    if (!props.get("tuning/apply", true)) {
+      return props;
+    }
+
+    const occa::json tunedProps = loadTunedProperties(sourceHash, kernelName);
+    if (!tunedProps.isInitialized()) {
+      return props;
+    }
+
+    // Properties passed by the caller take precedence
+    return tunedProps + props;
+  }
+
   kernel device::buildKernel(const std::string &filename,
                              const std::string &kernelName,
                              const occa::json &props) const {
     occa::json allProps;
     hash_t kernelHash;
     const std::string realFilename = io::findInPaths(filename, env::OCCA_KERNEL_PATH);
-    setupKernelInfo(props, hashFile(realFilename),
+    const hash_t sourceHash = hashFile(realFilename);
+    // The kernel hash includes the included files, so edited headers aren't served from the cache
+    setupKernelInfo(applyTunedProperties(props, sourceHash, kernelName),
+                    sourceHash,
                     allProps, kernelHash);
 
-    // TODO: [#185] Fix kernel cache frees
-    // // Check cache first
-    // kernel &cachedKernel = modeDevice->getCachedKernel(kernelHash,
-    //                                                    kernelName);
-    // if (cachedKernel.isInitialized()) {
-    //   return cachedKernel;
-    // }
+    // Check cache first
+    kernel cachedKernel = modeDevice->getCachedKernel(kernelHash,
+                                                      kernelName);
+    if (cachedKernel.isInitialized()) {
+      return cachedKernel;
+    }
 
     const std::string hashDir = io::hashDir(realFilename, kernelHash);
     allProps["hash"] = kernelHash.getFullString();
 
-    kernel cachedKernel = modeDevice->buildKernel(realFilename,
-                                                  kernelName,
-                                                  kernelHash,
-                                                  allProps);
+    modeDevice->extractBundledKernel(kernelHash, hashDir);
+
+    cachedKernel = modeDevice->buildKernel(realFilename,
+                                           kernelName,
+                                           kernelHash,
+                                           allProps);
 
     if (cachedKernel.isInitialized()) {
       cachedKernel.modeKernel->hash = kernelHash;
+      modeDevice->setCachedKernel(kernelHash, kernelName, cachedKernel);
     } else {
       sys::rmrf(hashDir);
     }
@@ -389,6 +515,237 @@ namespace occa {
     return cachedKernel;
   }
 
+  std::vector<kernel> device::buildKernels(const std::vector<kernelSpec> &specs,
+                                           strVector &errors) const {
+    assertInitialized();
+
+    const int specCount = (int) specs.size();
+    std::vector<kernel> kernels(specCount);
+    errors.assign(specCount, "");
+
+    // Hash everything up front and build each (hash, kernel name) pair once
+    std::map<std::string, kernelBuild_t*> buildMap;
+    kernelBuildVector builds;
+    std::vector<kernelBuild_t*> specBuilds(specCount, NULL);
+
+    for (int i = 0; i < specCount; ++i) {
+      const kernelSpec &spec = specs[i];
+      try {
+        occa::json allProps;
+        hash_t kernelHash;
+        const std::string realFilename = io::findInPaths(spec.filename, env::OCCA_KERNEL_PATH);
+        const hash_t sourceHash = hashFile(realFilename);
+        setupKernelInfo(applyTunedProperties(spec.props, sourceHash, spec.kernelName),
+                        sourceHash,
+                        allProps, kernelHash);
+        allProps["hash"] = kernelHash.getFullString();
+
+        kernels[i] = modeDevice->getCachedKernel(kernelHash, spec.kernelName);
+        if (kernels[i].isInitialized()) {
+          continue;
+        }
+
+        const std::string buildKey = modeDevice->getKernelHash(kernelHash,
+                                                               spec.kernelName);
+        kernelBuild_t *&build = buildMap[buildKey];
+        if (!build) {
+          modeDevice->extractBundledKernel(kernelHash,
+                                           io::hashDir(realFilename, kernelHash));
+          build = new kernelBuild_t(realFilename,
+                                    spec.kernelName,
+                                    kernelHash,
+                                    allProps);
+          builds.push_back(build);
+        }
+        specBuilds[i] = build;
+      } catch (occa::exception &exc) {
+        errors[i] = exc.message;
+      }
+    }
+
+    modeDevice->buildKernels(builds);
+
+    for (kernelBuild_t *build : builds) {
+      if (build->modeKernel) {
+        build->modeKernel->hash = build->kernelHash;
+        continue;
+      }
+      if (!build->error.size()) {
+        build->error = "Unable to build kernel [" + build->kernelName + "]";
+      }
+      sys::rmrf(io::hashDir(build->filename, build->kernelHash));
+    }
+
+    for (int i = 0; i < specCount; ++i) {
+      kernelBuild_t *build = specBuilds[i];
+      if (!build) {
+        continue;
+      }
+      if (build->modeKernel) {
+        kernels[i] = kernel(build->modeKernel);
+        modeDevice->setCachedKernel(build->kernelHash, build->kernelName, kernels[i]);
+      } else {
+        errors[i] = build->error;
+      }
+    }
+
+    for (kernelBuild_t *build : builds) {
+      delete build;
+    }
+
+    return kernels;
+  }
+
+  std::vector<kernel> device::buildKernels(const std::vector<kernelSpec> &specs) const {
+    strVector errors;
+    std::vector<kernel> kernels = buildKernels(specs, errors);
+
+    std::stringstream ss;
+    for (int i = 0; i < (int) specs.size(); ++i) {
+      if (errors[i].size()) {
+        ss << "\n[" << specs[i].kernelName << "] from [" << specs[i].filename << "]: "
+           << errors[i];
+      }
+    }
+    const std::string errorMessage = ss.str();
+    OCCA_ERROR("Unable to build kernels:" << errorMessage,
+               !errorMessage.size());
+
+    return kernels;
+  }
+
+  kernel device::tuneKernel(const std::string &filename,
+                            const std::string &kernelName,
+                            const occa::json &searchSpace,
+                            const kernelLauncher_t &launcher,
+                            const occa::json &props) {
+    assertInitialized();
+
+    OCCA_ERROR("Search space must be an object of candidate values",
+               searchSpace.isObject() && searchSpace.object().size());
+
+    const occa::json allProps = kernelProperties(props);
+    const int warmup = allProps.get("tuning/warmup", 1);
+    const int iterations = allProps.get("tuning/iterations", 5);
+    const bool verbose = allProps.get("verbose", false);
+
+    OCCA_ERROR("[tuning/iterations] must be positive",
+               iterations > 0);
+
+    std::vector<occa::json> candidates(1, occa::json(jsonObject()));
+    getTuningCandidates(searchSpace, "", candidates);
+    const int candidateCount = (int) candidates.size();
+
+    // Variants ignore previous results for properties outside the search space
+    occa::json variantProps = props;
+    variantProps["tuning/apply"] = false;
+
+    std::vector<kernelSpec> specs;
+    for (const occa::json &candidate : candidates) {
+      specs.push_back(kernelSpec(filename, kernelName, variantProps + candidate));
+    }
+
+    strVector errors;
+    std::vector<kernel> variants = buildKernels(specs, errors);
+
+    occa::json results;
+    results["kernel"] = kernelName;
+    results["variants"].asArray();
+
+    int bestIndex = -1;
+    double bestTime = 0;
+    for (int i = 0; i < candidateCount; ++i) {
+      occa::json variantResult;
+      variantResult["props"] = candidates[i];
+
+      kernel &variant = variants[i];
+      if (!variant.isInitialized()) {
+        variantResult["error"] = errors[i];
+        results["variants"] += variantResult;
+        if (verbose) {
+          io::stdout << "Tuning [" << kernelName << "] " << candidates[i].dump(0)
+                     << ": Failed to build\n";
+        }
+        continue;
+      }
+
+      for (int it = 0; it < warmup; ++it) {
+        launcher(variant);
+      }
+      finish();
+
+      // Keep the fastest run to filter out system noise
+      double variantTime = 0;
+      for (int it = 0; it < iterations; ++it) {
+        streamTag startTag = tagStream();
+        launcher(variant);
+        streamTag endTag = tagStream();
+        waitFor(endTag);
+
+        const double seconds = timeBetween(startTag, endTag);
+        if (!it || (seconds < variantTime)) {
+          variantTime = seconds;
+        }
+      }
+
+      variantResult["seconds"] = variantTime;
+      results["variants"] += variantResult;
+      if (verbose) {
+        io::stdout << "Tuning [" << kernelName << "] " << candidates[i].dump(0)
+                   << ": " << variantTime << " s\n";
+      }
+
+      if ((bestIndex < 0) || (variantTime < bestTime)) {
+        bestIndex = i;
+        bestTime = variantTime;
+      }
+    }
+
+    if (bestIndex < 0) {
+      std::stringstream ss;
+      for (int i = 0; i < candidateCount; ++i) {
+        ss << "\n" << candidates[i].dump(0) << ": " << errors[i];
+      }
+      OCCA_FORCE_ERROR("Unable to build any variant of kernel [" << kernelName << "]:"
+                       << ss.str());
+    }
+
+    results["props"] = candidates[bestIndex];
+    results["seconds"] = bestTime;
+
+    const std::string realFilename = io::findInPaths(filename, env::OCCA_KERNEL_PATH);
+    const hash_t sourceHash = hashFile(realFilename);
+    const std::string resultsFile = tuningFile(sourceHash, kernelName);
+
+    io::lock_t lock(hash() ^ sourceHash ^ occa::hash(kernelName), "occa-tuning");
+    if (lock.isMine()) {
+      results.write(resultsFile);
+      lock.release();
+    }
+    // Read the new results on the next build
+    modeDevice->removeTunedProperties(resultsFile);
+
+    return variants[bestIndex];
+  }
+
+  void device::loadBundle(const std::string &filename) {
+    assertInitialized();
+    modeDevice->loadKernelBundle(filename);
+  }
+
+  occa::json device::tunedKernelProperties(const std::string &filename,
+                                           const std::string &kernelName) const {
+    assertInitialized();
+
+    const std::string realFilename = io::findInPaths(filename, env::OCCA_KERNEL_PATH);
+    const occa::json tunedProps = loadTunedProperties(hashFile(realFilename), kernelName);
+
+    if (!tunedProps.isInitialized()) {
+      return occa::json(jsonObject());
+    }
+    return tunedProps;
+  }
+
   kernel device::buildKernelFromString(const std::string &content,
                                        const std::string &kernelName,
                                        const occa::json &props) const {
@@ -445,6 +802,9 @@ namespace occa {
     mem.setDtype(dtype);
 
     modeDevice->bytesAllocated += bytes;
+    if (modeDevice->peakBytesAllocated < modeDevice->bytesAllocated) {
+      modeDevice->peakBytesAllocated = modeDevice->bytesAllocated;
+    }
 
     return mem;
   }
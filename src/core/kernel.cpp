@@ -13,20 +13,30 @@
 namespace occa {
   //---[ kernel ]-----------------------
   kernel::kernel() :
-    modeKernel(NULL) {}
+    modeKernel(NULL),
+    hasRunDims(false) {}
 
   kernel::kernel(modeKernel_t *modeKernel_) :
-    modeKernel(NULL) {
+    modeKernel(NULL),
+    hasRunDims(false) {
     setModeKernel(modeKernel_);
   }
 
   kernel::kernel(const kernel &k) :
-    modeKernel(NULL) {
+    modeKernel(NULL),
+    arguments(k.arguments),
+    hasRunDims(k.hasRunDims),
+    outerDims(k.outerDims),
+    innerDims(k.innerDims) {
     setModeKernel(k.modeKernel);
   }
 
   kernel& kernel::operator = (const kernel &k) {
     setModeKernel(k.modeKernel);
+    arguments = k.arguments;
+    hasRunDims = k.hasRunDims;
+    outerDims = k.outerDims;
+    innerDims = k.innerDims;
     return *this;
   }
 
@@ -47,6 +57,8 @@ namespace occa {
   void kernel::setModeKernel(modeKernel_t *modeKernel_) {
     if (modeKernel != modeKernel_) {
       removeKernelRef();
+      arguments.clear();
+      hasRunDims = false;
       modeKernel = modeKernel_;
       if (modeKernel) {
         modeKernel->addKernelRef(this);
@@ -133,10 +145,11 @@ namespace occa {
             : hash_t());
   }
 
-  void kernel::setRunDims(occa::dim outerDims, occa::dim innerDims) {
+  void kernel::setRunDims(occa::dim outerDims_, occa::dim innerDims_) {
     if (modeKernel) {
-      modeKernel->innerDims = innerDims;
-      modeKernel->outerDims = outerDims;
+      hasRunDims = true;
+      outerDims = outerDims_;
+      innerDims = innerDims_;
     }
   }
 
@@ -158,26 +171,55 @@ namespace occa {
             : dim(occa::UDIM_DEFAULT, occa::UDIM_DEFAULT, occa::UDIM_DEFAULT));
   }
 
+  const dim& kernel::getRunOuterDims() const {
+    return hasRunDims ? outerDims : modeKernel->outerDims;
+  }
+
+  const dim& kernel::getRunInnerDims() const {
+    return hasRunDims ? innerDims : modeKernel->innerDims;
+  }
+
   void kernel::pushArg(const kernelArg &arg) {
     assertInitialized();
-    modeKernel->pushArgument(arg);
+    addArgument(arg);
   }
 
-  void kernel::clearArgs() {
-    if (modeKernel) {
-      modeKernel->arguments.clear();
+  void kernel::addArgument(const kernelArg &arg) const {
+    const int argCount = (int) arg.size();
+    for (int i = 0; i < argCount; ++i) {
+      const kernelArgData &argi = arg[i];
+      modeKernel->assertArgInDevice(argi, (int) arguments.size());
+      arguments.push_back(argi);
+    }
+
+    OCCA_ERROR("(" << modeKernel->name << ") Kernels can have at most [" << OCCA_MAX_ARGS << "] arguments",
+               ((int) arguments.size() + 1) < OCCA_MAX_ARGS);
+  }
+
+  void kernel::setArguments(const kernelArg *args,
+                            const int count) const {
+    arguments.clear();
+    for (int i = 0; i < count; ++i) {
+      addArgument(args[i]);
     }
   }
 
+  void kernel::clearArgs() {
+    arguments.clear();
+  }
+
   void kernel::run() const {
     assertInitialized();
 
-    if (modeKernel->isNoop()) {
+    const dim &runOuterDims = getRunOuterDims();
+    const dim &runInnerDims = getRunInnerDims();
+    if (runOuterDims.isZero() && runInnerDims.isZero()) {
       return;
     }
 
-    modeKernel->setupRun();
-    modeKernel->run();
+    modeKernel->setupArgumentsForCall(arguments,
+                                      modeKernel->validateArguments(arguments));
+    modeKernel->runWithArguments(arguments, runOuterDims, runInnerDims);
   }
 
   void kernel::run(std::initializer_list<kernelArg> args) const {
@@ -192,7 +234,31 @@ namespace occa {
 
 #include "kernelOperators.cpp_codegen"
 
+  kernelLaunch kernel::bind(std::initializer_list<kernelArg> args) const {
+    assertInitialized();
+
+    kernelArgDataVector argData;
+    for (const kernelArg &arg : args) {
+      const int argCount = arg.size();
+      for (int i = 0; i < argCount; ++i) {
+        modeKernel->assertArgInDevice(arg[i], (int) argData.size());
+        argData.push_back(arg[i]);
+      }
+    }
+
+    return kernelLaunch(*this, argData);
+  }
+
   void kernel::free() {
+    if (!modeKernel) {
+      return;
+    }
+    // Cached kernels are shared by every buildKernel call returning them
+    if (modeKernel->modeDevice &&
+        modeKernel->modeDevice->releaseCachedKernel(modeKernel)) {
+      setModeKernel(NULL);
+      return;
+    }
     // ~modeKernel_t NULLs all wrappers
     delete modeKernel;
     modeKernel = NULL;
@@ -200,6 +266,96 @@ namespace occa {
   //====================================
 
 
+  //---[ kernelLaunch ]-----------------
+  kernelLaunch::kernelLaunch() :
+    validated(false) {}
+
+  kernelLaunch::kernelLaunch(const occa::kernel &kernel__,
+                             const kernelArgDataVector &args_) :
+    kernel_(kernel__),
+    args(args_),
+    validated(false) {
+    assertInitialized();
+
+    modeKernel_t &modeKernel = *(kernel_.modeKernel);
+    OCCA_ERROR("(" << modeKernel.name << ") Kernels can have at most [" << OCCA_MAX_ARGS << "] arguments",
+               ((int) args.size() + 1) < OCCA_MAX_ARGS);
+
+    validated = modeKernel.validateArguments(args);
+  }
+
+  bool kernelLaunch::isInitialized() const {
+    return kernel_.modeKernel != NULL;
+  }
+
+  occa::kernel kernelLaunch::getKernel() const {
+    return kernel_;
+  }
+
+  int kernelLaunch::argumentCount() const {
+    return (int) args.size();
+  }
+
+  void kernelLaunch::assertInitialized() const {
+    OCCA_ERROR("Kernel launch not initialized or has been freed",
+               kernel_.modeKernel != NULL);
+  }
+
+  void kernelLaunch::assertIndex(const int index) const {
+    OCCA_ERROR("(" << kernel_.modeKernel->name << ") Argument index [" << index << "] is out of bounds,"
+               " the kernel launch has [" << args.size() << "] arguments",
+               (0 <= index) && (index < (int) args.size()));
+  }
+
+  void kernelLaunch::setScalarArg(const int index, const primitive &value) {
+    assertInitialized();
+    assertIndex(index);
+
+    // Only the value changes, the bound type was already validated
+    kernelArgData &arg = args[index];
+    OCCA_ERROR("(" << kernel_.modeKernel->name << ") Argument [" << (index + 1) << "] was bound as ["
+               << arg.value.dtype() << "], received [" << value.dtype() << "]",
+               !arg.modeMemory && (arg.value.type == value.type));
+
+    arg.value.value = value.value;
+  }
+
+  void kernelLaunch::setArg(const int index, const kernelArg &arg) {
+    assertInitialized();
+    assertIndex(index);
+
+    modeKernel_t &modeKernel = *(kernel_.modeKernel);
+    OCCA_ERROR("(" << modeKernel.name << ") Argument [" << (index + 1) << "] can only be replaced by a single value",
+               arg.size() == 1);
+
+    const kernelArgData &argData = arg[0];
+    modeKernel.assertArgInDevice(argData, index);
+    if (validated) {
+      modeKernel.validateArgument(index, argData);
+    }
+    args[index] = argData;
+  }
+
+  void kernelLaunch::run() const {
+    assertInitialized();
+
+    modeKernel_t &modeKernel = *(kernel_.modeKernel);
+    const dim &runOuterDims = kernel_.getRunOuterDims();
+    const dim &runInnerDims = kernel_.getRunInnerDims();
+    if (runOuterDims.isZero() && runInnerDims.isZero()) {
+      return;
+    }
+
+    modeKernel.setupArgumentsForCall(args, validated);
+    modeKernel.runWithArguments(args, runOuterDims, runInnerDims);
+  }
+
+  void kernelLaunch::operator () () const {
+    run();
+  }
+  //====================================
+
+
   //---[ Kernel Properties ]------------
   // Properties:
   //   defines       : Object
@@ -452,6 +452,11 @@ namespace occa {
     copyTo(dest, -1, 0, 0, props);
   }
 
+  occa::memoryView memory::view(const dim_t offset,
+                                const dim_t count) const {
+    return memoryView(*this, offset, count);
+  }
+
   occa::memory memory::cast(const dtype_t &dtype_) const {
     occa::memory mem = slice(0);
     mem.setDtype(dtype_);
@@ -477,6 +482,9 @@ namespace occa {
   }
 
   void memory::detach() {
+    if (modeMemory) {
+      modeMemory->assertDetachable();
+    }
     deleteRefs(false);
   }
 
@@ -517,6 +525,189 @@ namespace occa {
     modeMemory = NULL;
   }
 
+  //---[ memoryView ]-------------------
+  memoryView::memoryView() :
+      modeMemory(NULL),
+      offset_(0),
+      size_(0),
+      dtype_(&dtype::byte) {}
+
+  memoryView::memoryView(const memory &mem) :
+      modeMemory(mem.getModeMemory()),
+      offset_(0),
+      size_(mem.size()),
+      dtype_(&mem.dtype()) {}
+
+  memoryView::memoryView(const memory &mem,
+                         const dim_t offset,
+                         const dim_t count) :
+      memoryView(memoryView(mem).view(offset, count)) {}
+
+  memoryView::memoryView(modeMemory_t *modeMemory_,
+                         const udim_t offset,
+                         const udim_t bytes,
+                         const dtype_t *dtype__) :
+      modeMemory(modeMemory_),
+      offset_(offset),
+      size_(bytes),
+      dtype_(dtype__) {}
+
+  void memoryView::assertInitialized() const {
+    OCCA_ERROR("Memory view not initialized or its memory has been freed",
+               modeMemory != NULL);
+  }
+
+  void memoryView::assertInRange(const char *name,
+                                 const udim_t offset,
+                                 const udim_t bytes) const {
+    OCCA_ERROR(name << " view has size [" << size_ << "],"
+               << " trying to access [" << offset << ", " << (offset + bytes) << "]",
+               (offset + bytes) <= size_);
+  }
+
+  bool memoryView::isInitialized() const {
+    return modeMemory != NULL;
+  }
+
+  occa::memory memoryView::getMemory() const {
+    return occa::memory(modeMemory);
+  }
+
+  modeMemory_t* memoryView::getModeMemory() const {
+    return modeMemory;
+  }
+
+  occa::device memoryView::getDevice() const {
+    return occa::device(modeMemory
+                        ? modeMemory->modeDevice
+                        : NULL);
+  }
+
+  template <>
+  void* memoryView::ptr<void>() const {
+    return (modeMemory
+            ? (void*) (((char*) modeMemory->getPtr()) + offset_)
+            : NULL);
+  }
+
+  udim_t memoryView::offset() const {
+    return offset_;
+  }
+
+  udim_t memoryView::size() const {
+    return size_;
+  }
+
+  udim_t memoryView::length() const {
+    if (modeMemory == NULL) {
+      return 0;
+    }
+    return size_ / dtype_->bytes();
+  }
+
+  const dtype_t& memoryView::dtype() const {
+    return *dtype_;
+  }
+
+  memoryView memoryView::view(const dim_t offset,
+                              const dim_t count) const {
+    assertInitialized();
+
+    const int dtypeSize = dtype_->bytes();
+    const dim_t byteOffset = dtypeSize * offset;
+    const dim_t bytes = dtypeSize * ((count == -1)
+                                     ? ((dim_t) length() - offset)
+                                     : count);
+
+    OCCA_ERROR("Cannot have a negative offset (" << byteOffset << ")",
+               byteOffset >= 0);
+
+    OCCA_ERROR("Trying to view negative bytes (" << bytes << ")",
+               bytes >= 0);
+
+    OCCA_ERROR("Cannot have offset and bytes greater than the view size ("
+               << byteOffset << " + " << bytes << " > " << size_ << ")",
+               (udim_t) (byteOffset + bytes) <= size_);
+
+    return memoryView(modeMemory,
+                      offset_ + byteOffset,
+                      bytes,
+                      dtype_);
+  }
+
+  memoryView::operator kernelArg() const {
+    if (!modeMemory || !size_) {
+      return kernelArg(nullptr);
+    }
+    // Keep the base memory for validation and UVA syncing
+    kernelArgData kArg(modeMemory->getKernelArgAtOffset(offset_));
+    kArg.modeMemory = modeMemory;
+    return kernelArg(kArg);
+  }
+
+  void memoryView::copyFrom(const void *src,
+                            const dim_t bytes,
+                            const dim_t offset,
+                            const occa::json &props) const {
+    assertInitialized();
+
+    OCCA_ERROR("Cannot have a negative offset (" << offset << ")",
+               offset >= 0);
+
+    const udim_t bytes_ = ((bytes == -1) ? (size_ - offset) : bytes);
+    assertInRange("Destination", offset, bytes_);
+
+    modeMemory->copyFrom(src, bytes_, offset_ + offset, props);
+  }
+
+  void memoryView::copyFrom(const memoryView &src,
+                            const dim_t bytes,
+                            const dim_t destOffset,
+                            const dim_t srcOffset,
+                            const occa::json &props) const {
+    src.copyTo(*this, bytes, destOffset, srcOffset, props);
+  }
+
+  void memoryView::copyTo(void *dest,
+                          const dim_t bytes,
+                          const dim_t offset,
+                          const occa::json &props) const {
+    assertInitialized();
+
+    OCCA_ERROR("Cannot have a negative offset (" << offset << ")",
+               offset >= 0);
+
+    const udim_t bytes_ = ((bytes == -1) ? (size_ - offset) : bytes);
+    assertInRange("Source", offset, bytes_);
+
+    modeMemory->copyTo(dest, bytes_, offset_ + offset, props);
+  }
+
+  void memoryView::copyTo(const memoryView &dest,
+                          const dim_t bytes,
+                          const dim_t destOffset,
+                          const dim_t srcOffset,
+                          const occa::json &props) const {
+    assertInitialized();
+    dest.assertInitialized();
+
+    OCCA_ERROR("Cannot have a negative offset (" << destOffset << ")",
+               destOffset >= 0);
+
+    OCCA_ERROR("Cannot have a negative offset (" << srcOffset << ")",
+               srcOffset >= 0);
+
+    const udim_t bytes_ = ((bytes == -1) ? (size_ - srcOffset) : bytes);
+    assertInRange("Source", srcOffset, bytes_);
+    dest.assertInRange("Destination", destOffset, bytes_);
+
+    dest.modeMemory->copyFrom(modeMemory, bytes_,
+                              dest.offset_ + destOffset,
+                              offset_ + srcOffset,
+                              props);
+  }
+  //====================================
+
   memory null;
 
   std::ostream& operator << (std::ostream &out,
@@ -8,10 +8,114 @@
 #include <occa/functional/scope.hpp>
 
 namespace occa {
+  //---[ Signatures ]-------------------
+  jitArgSignature_t::jitArgSignature_t(const scopeKernelArg &arg) :
+    name(arg.name),
+    dtypeName((arg.dtype || dtype::void_).name()),
+    isConst(arg.isConst) {
+    for (const kernelArgData &argData : arg.args) {
+      isPointer.push_back(argData.isPointer());
+    }
+  }
+
+  bool jitArgSignature_t::matches(const scopeKernelArg &arg) const {
+    const int argDataCount = (int) isPointer.size();
+    if ((isConst != arg.isConst)
+        || (argDataCount != (int) arg.args.size())) {
+      return false;
+    }
+    for (int i = 0; i < argDataCount; ++i) {
+      if (isPointer[i] != arg.args[i].isPointer()) {
+        return false;
+      }
+    }
+    return (
+      (name == arg.name)
+      && (dtypeName == (arg.dtype || dtype::void_).name())
+    );
+  }
+
+  jitKernel_t::jitKernel_t(const occa::scope &scope,
+                           occa::kernel kernel_) :
+    modeDevice(scope.device.getModeDevice()),
+    props(scope.props),
+    kernel(kernel_) {
+    for (const scopeKernelArg &arg : scope.args) {
+      args.push_back(jitArgSignature_t(arg));
+    }
+
+    // Match kernel arguments to the scope arguments once
+    const lang::kernelMetadata_t &metadata = kernel.getModeKernel()->getMetadata();
+    const int scopeArgCount = (int) scope.args.size();
+
+    for (const lang::argMetadata_t &arg : metadata.arguments) {
+      int index = 0;
+      while ((index < scopeArgCount)
+             && (scope.args[index].name != arg.name)) {
+        ++index;
+      }
+      OCCA_ERROR("Missing argument [" << arg.name << "]",
+                 index < scopeArgCount);
+      argIndices.push_back(index);
+    }
+  }
+
+  bool jitKernel_t::matches(const occa::scope &scope) const {
+    // Kernels are freed along with their device
+    if (!kernel.getModeKernel()
+        || (modeDevice != scope.device.getModeDevice())) {
+      return false;
+    }
+
+    const int argCount = (int) args.size();
+    if (argCount != (int) scope.args.size()) {
+      return false;
+    }
+    for (int i = 0; i < argCount; ++i) {
+      if (!args[i].matches(scope.args[i])) {
+        return false;
+      }
+    }
+    return props == scope.props;
+  }
+  //====================================
+
   kernelBuilder::kernelBuilder(const std::string &source_,
                                const std::string &kernelName_) :
     source(strip(source_)),
-    kernelName(strip(kernelName_)) {}
+    kernelName(strip(kernelName_)),
+    lastJitKernel(-1) {
+    const int charCount = (int) source.size();
+
+    // Remove first and last () characters
+    if (charCount
+        && (source[0] == '(')
+        && (source[charCount - 1] == ')')) {
+      source = source.substr(1, charCount - 2);
+    }
+  }
+
+  kernelBuilder::kernelBuilder(const kernelBuilder &other) :
+    lastJitKernel(-1) {
+    *this = other;
+  }
+
+  kernelBuilder& kernelBuilder::operator = (const kernelBuilder &other) {
+    if (this == &other) {
+      return *this;
+    }
+
+    std::lock_guard<std::mutex> otherLock(other.mutex);
+    std::lock_guard<std::mutex> lock(mutex);
+
+    source = other.source;
+    kernelName = other.kernelName;
+    kernelMap = other.kernelMap;
+    jitKernels = other.jitKernels;
+    lastJitKernel = other.lastJitKernel;
+
+    return *this;
+  }
 
   bool kernelBuilder::isInitialized() {
     return (0 < kernelName.size());
@@ -22,13 +126,6 @@ namespace occa {
   }
 
   std::string kernelBuilder::buildKernelSource(const occa::scope &scope) {
-    const int charCount = (int) source.size();
-
-    // Remove first and last () characters
-    if ((source[0] == '(') && (source[charCount - 1] == ')')) {
-      source = source.substr(1, charCount - 2);
-    }
-
     std::stringstream ss;
     ss << "@kernel void " << kernelName << "("
        << scope.getDeclarationSource()
@@ -38,6 +135,11 @@ namespace occa {
   }
 
   occa::kernel kernelBuilder::getOrBuildKernel(const occa::scope &scope) {
+    std::lock_guard<std::mutex> lock(mutex);
+    return unsafeGetOrBuildKernel(scope);
+  }
+
+  occa::kernel kernelBuilder::unsafeGetOrBuildKernel(const occa::scope &scope) {
     occa::device device = scope.getDevice();
     const hash_t hash = (
       occa::hash(device) ^ occa::hash(scope)
@@ -45,37 +147,78 @@ namespace occa {
 
     occa::kernel &kernel = kernelMap[hash];
     if (!kernel.isInitialized()) {
+      // Lets host modes inline the functions passed to functional kernels
+      occa::json kernelProps = scope.props;
+      if (!kernelProps.has("serial/static_functions")) {
+        kernelProps["serial/static_functions"] = true;
+      }
       kernel = device.buildKernelFromString(
         buildKernelSource(scope),
         kernelName,
-        scope.props
+        kernelProps
       );
     }
     return kernel;
   }
 
+  jitKernel_t& kernelBuilder::getJitKernel(const occa::scope &scope) {
+    // Launches usually repeat the previous scope layout
+    if ((lastJitKernel >= 0)
+        && jitKernels[lastJitKernel].matches(scope)) {
+      return jitKernels[lastJitKernel];
+    }
+
+    const int jitKernelCount = (int) jitKernels.size();
+    for (int i = 0; i < jitKernelCount; ++i) {
+      if (jitKernels[i].matches(scope)) {
+        lastJitKernel = i;
+        return jitKernels[i];
+      }
+    }
+
+    // Fall back to hashing the scope, which also matches equivalent dtypes
+    jitKernel_t jitKernel(scope, unsafeGetOrBuildKernel(scope));
+
+    // Replace signatures of freed kernels rather than growing the list
+    for (int i = 0; i < jitKernelCount; ++i) {
+      if (!jitKernels[i].kernel.isInitialized()) {
+        jitKernels[i] = jitKernel;
+        lastJitKernel = i;
+        return jitKernels[i];
+      }
+    }
+
+    jitKernels.push_back(jitKernel);
+    lastJitKernel = jitKernelCount;
+    return jitKernels.back();
+  }
+
   void kernelBuilder::run(const occa::scope &scope) {
-    occa::kernel kernel = getOrBuildKernel(scope);
+    // Kernel arguments are stored in the kernel, so launches are serialized
+    std::lock_guard<std::mutex> lock(mutex);
 
-    // Get argument metadata
-    const lang::kernelMetadata_t &metadata = kernel.getModeKernel()->getMetadata();
-    const std::vector<lang::argMetadata_t> &arguments = metadata.arguments;
+    jitKernel_t &jitKernel = getJitKernel(scope);
+    occa::kernel &kernel = jitKernel.kernel;
 
     // Insert arguments in the proper order
     kernel.clearArgs();
-    for (const lang::argMetadata_t &arg : arguments) {
-      kernel.pushArg(scope.getArg(arg.name));
+    for (const int index : jitKernel.argIndices) {
+      kernel.pushArg(scope.args[index]);
     }
 
     kernel.run();
   }
 
   void kernelBuilder::free() {
+    std::lock_guard<std::mutex> lock(mutex);
+
     hashedKernelMapIterator it = kernelMap.begin();
     while (it != kernelMap.end()) {
       it->second.free();
       ++it;
     }
     kernelMap.clear();
+    jitKernels.clear();
+    lastJitKernel = -1;
   }
 }
@@ -1,14 +1,29 @@
+#include <algorithm>
+#include <map>
+
 #include <occa/defines.hpp>
 #include <occa/functional/utils.hpp>
 
 namespace occa {
   namespace functional {
-    template <>
-    bool hostReduction<bool>(reductionType type, occa::memory mem) {
-      const int entryCount = (int) mem.length();
-      bool *values = new bool[entryCount];
-      mem.copyTo(values);
+    class deviceReductionBuffer {
+    public:
+      std::mutex mutex;
+      occa::memory memory;
+    };
+
+    typedef std::map<modeDevice_t*, deviceReductionBuffer*> deviceReductionBufferMap;
 
+    static std::mutex reductionBuffersMutex;
+
+    // Never freed so buffers are safe to release during static destruction
+    static deviceReductionBufferMap& reductionBuffers() {
+      static deviceReductionBufferMap *buffers = new deviceReductionBufferMap();
+      return *buffers;
+    }
+
+    template <>
+    bool hostReduction<bool>(reductionType type, const bool *values, const int entryCount) {
       bool reductionValue = values[0];
       switch (type) {
         case reductionType::bitOr:
@@ -48,17 +63,11 @@ namespace occa {
           break;
       }
 
-      delete [] values;
-
       return reductionValue;
     }
 
     template <>
-    float hostReduction<float>(reductionType type, occa::memory mem) {
-      const int entryCount = (int) mem.length();
-      float *values = new float[entryCount];
-      mem.copyTo(values);
-
+    float hostReduction<float>(reductionType type, const float *values, const int entryCount) {
       float reductionValue = values[0];
       switch (type) {
         case reductionType::sum:
@@ -94,17 +103,11 @@ namespace occa {
           break;
       }
 
-      delete [] values;
-
       return reductionValue;
     }
 
     template <>
-    double hostReduction<double>(reductionType type, occa::memory mem) {
-      const int entryCount = (int) mem.length();
-      double *values = new double[entryCount];
-      mem.copyTo(values);
-
+    double hostReduction<double>(reductionType type, const double *values, const int entryCount) {
       double reductionValue = values[0];
       switch (type) {
         case reductionType::sum:
@@ -140,9 +143,31 @@ namespace occa {
           break;
       }
 
-      delete [] values;
-
       return reductionValue;
     }
+  
+    reductionBuffer::reductionBuffer(occa::device device,
+                                     const udim_t bytes) {
+      deviceReductionBuffer *buffer;
+      {
+        std::lock_guard<std::mutex> buffersLock(reductionBuffersMutex);
+        deviceReductionBuffer *&buffer_ = reductionBuffers()[device.getModeDevice()];
+        if (!buffer_) {
+          buffer_ = new deviceReductionBuffer();
+        }
+        buffer = buffer_;
+      }
+
+      lock = std::unique_lock<std::mutex>(buffer->mutex);
+
+      // Memory is freed along with its device, which could be replaced by a new device at the same address
+      occa::memory &mem = buffer->memory;
+      if (!mem.isInitialized()
+          || (mem.getModeDevice() != device.getModeDevice())
+          || (mem.size() < bytes)) {
+        mem = device.malloc(std::max<udim_t>(bytes, 1024), dtype::byte);
+      }
+      memory = mem;
+    }
   }
 }
@@ -3,6 +3,7 @@
 #include <occa.hpp>
 
 #include <occa/internal/bin/occa.hpp>
+#include <occa/internal/core/kernelBundle.hpp>
 #include <occa/internal/utils/env.hpp>
 #include <occa/internal/lang/modes/serial.hpp>
 #include <occa/internal/lang/modes/openmp.hpp>
@@ -232,6 +233,53 @@ namespace occa {
       return true;
     }
 
+    bool runBundle(const json &args) {
+      const json &options = args["options"];
+      const json &arguments = args["arguments"];
+
+      const std::string manifestFile = arguments[0];
+      const std::string outputFile = arguments[1];
+
+      if (!io::exists(manifestFile)) {
+        printError("File [" + manifestFile + "] doesn't exist" );
+        ::exit(1);
+      }
+
+      json manifest = json::read(manifestFile);
+      const json &kernels = manifest["kernels"];
+      if (!kernels.isArray() || !kernels.size()) {
+        printError("Manifest [" + manifestFile + "] has no [kernels] to bundle");
+        ::exit(1);
+      }
+
+      // Relative kernel files are found from the manifest directory
+      const std::string manifestDir = io::dirname(manifestFile);
+
+      std::vector<kernelSpec> specs;
+      for (int i = 0; i < kernels.size(); ++i) {
+        const json &kernelInfo = kernels[i];
+        std::string filename = kernelInfo["file"];
+        if (!io::isAbsolutePath(filename)) {
+          filename = manifestDir + filename;
+        }
+        specs.push_back(
+          kernelSpec(filename, kernelInfo["kernel"], kernelInfo["props"])
+        );
+      }
+
+      json deviceProps = (
+        manifest["device"]
+        + getOptionProperties(options["device-props"])
+      );
+
+      device device(deviceProps);
+      kernelBundle_t::write(outputFile, device, specs);
+
+      io::stdout << "Bundled " << specs.size() << " kernels into [" << outputFile << "]\n";
+
+      return true;
+    }
+
     bool runEnv(const json &args) {
       io::stdout << "  Basic:\n"
                  << "    - OCCA_DIR                   : " << envEcho("OCCA_DIR") << "\n"
@@ -263,6 +311,7 @@ namespace occa {
                  << "    - OCCA_CFLAGS                : " << envEcho("OCCA_CFLAGS") << "\n"
                  << "    - OCCA_LDFLAGS               : " << envEcho("OCCA_LDFLAGS") << "\n"
                  << "    - OCCA_COMPILER_SHARED_FLAGS : " << envEcho("OCCA_COMPILER_SHARED_FLAGS") << "\n"
+                 << "    - OCCA_COMPILER_JOBS         : " << envEcho("OCCA_COMPILER_JOBS") << "\n"
                  << "    - OCCA_INCLUDE_PATH          : " << envEcho("OCCA_INCLUDE_PATH") << "\n"
                  << "    - OCCA_LIBRARY_PATH          : " << envEcho("OCCA_LIBRARY_PATH") << "\n"
                  << "    - OCCA_KERNEL_PATH           : " << envEcho("OCCA_KERNEL_PATH") << "\n"
@@ -395,6 +444,24 @@ namespace occa {
                                      "Kernel name")
                        .isRequired());
 
+      cli::command bundleCommand;
+      bundleCommand
+          .withName("bundle")
+          .withCallback(runBundle)
+          .withDescription("Compile the kernels listed in a manifest into one bundle file")
+          .addOption(cli::option('d', "device-props",
+                                 "Device properties, merged with the manifest [device] properties")
+                     .reusable()
+                     .withArg())
+          .addArgument(cli::argument("MANIFEST",
+                                     "A JSON file with the [device] properties and [kernels] list")
+                       .isRequired()
+                       .expandsFiles())
+          .addArgument(cli::argument("OUTPUT",
+                                     "Bundle file to write")
+                       .isRequired()
+                       .expandsFiles());
+
       cli::command envCommand;
       envCommand
           .withName("env")
@@ -435,6 +502,7 @@ namespace occa {
         .addCommand(clearCommand)
         .addCommand(translateCommand)
         .addCommand(compileCommand)
+        .addCommand(bundleCommand)
         .addCommand(envCommand)
         .addCommand(infoCommand)
         .addCommand(modesCommand)
@@ -356,7 +356,7 @@ namespace occa {
       return occa::kernel((occa::modeKernel_t*) value.value.ptr);
     }
 
-    occa::kernelBuilder kernelBuilder(occaType value) {
+    occa::kernelBuilder& kernelBuilder(occaType value) {
       OCCA_ERROR("Input is not an occaKernelBuilder",
                  value.type == typeType::kernelBuilder);
       return *((occa::kernelBuilder*) value.value.ptr);
@@ -933,7 +933,7 @@ void occaPrintTypeInfo(occaType value) {
         info["type"]  = "kernelBuilder";
         info["value"] = (void*) value.value.ptr;
 
-        occa::kernelBuilder kernelBuilder = occa::c::kernelBuilder(value);
+        occa::kernelBuilder &kernelBuilder = occa::c::kernelBuilder(value);
         if (kernelBuilder.isInitialized()) {
           info["kernel_name"] = kernelBuilder.getKernelName();
         } else {
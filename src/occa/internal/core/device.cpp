@@ -1,19 +1,37 @@
 #include <occa/internal/core/device.hpp>
 #include <occa/internal/core/kernel.hpp>
+#include <occa/internal/core/kernelBundle.hpp>
 #include <occa/internal/core/memory.hpp>
 #include <occa/internal/core/stream.hpp>
 #include <occa/internal/core/streamTag.hpp>
 #include <occa/internal/utils/env.hpp>
 #include <occa/internal/io.hpp>
+#include <occa/utils/exception.hpp>
 
 namespace occa {
+  kernelBuild_t::kernelBuild_t(const std::string &filename_,
+                               const std::string &kernelName_,
+                               const hash_t &kernelHash_,
+                               const occa::json &kernelProps_) :
+    filename(filename_),
+    kernelName(kernelName_),
+    kernelHash(kernelHash_),
+    kernelProps(kernelProps_),
+    modeKernel(NULL) {}
+
   modeDevice_t::modeDevice_t(const occa::json &properties_) :
     mode((std::string) properties_["mode"]),
     properties(properties_),
     needsLauncherKernel(false),
-    bytesAllocated(0) {}
+    bytesAllocated(0),
+    peakBytesAllocated(0),
+    kernelCacheHits(0),
+    kernelCacheMisses(0) {}
 
   modeDevice_t::~modeDevice_t() {
+    cachedKernelsMutex.free();
+    tunedPropertiesMutex.free();
+
     // Null all wrappers
     while (deviceRing.head) {
       device *mem = (device*) deviceRing.head;
@@ -28,6 +46,11 @@ namespace occa {
     freeRing<modeMemory_t>(memoryRing);
     freeRing<modeStream_t>(streamRing);
     freeRing<modeStreamTag_t>(streamTagRing);
+
+    for (kernelBundle_t *bundle : kernelBundles) {
+      delete bundle;
+    }
+    kernelBundles.clear();
   }
 
   void modeDevice_t::dontUseRefs() {
@@ -115,19 +138,149 @@ namespace occa {
                          kernel->name);
   }
 
-  kernel& modeDevice_t::getCachedKernel(const hash_t &kernelHash,
-                                        const std::string &kernelName) {
+  kernel modeDevice_t::getCachedKernel(const hash_t &kernelHash,
+                                       const std::string &kernelName) {
+    const std::string cacheKey = getKernelHash(kernelHash, kernelName);
+
+    cachedKernelsMutex.lock();
+    kernel cachedKernel;
+    cachedKernelMapIterator it = cachedKernels.find(cacheKey);
+    if (it != cachedKernels.end() && it->second.isInitialized()) {
+      cachedKernel = it->second;
+      ++kernelCacheHits;
+    } else {
+      ++kernelCacheMisses;
+    }
+    cachedKernelsMutex.unlock();
+
+    return cachedKernel;
+  }
+
+  void modeDevice_t::setCachedKernel(const hash_t &kernelHash,
+                                     const std::string &kernelName,
+                                     const kernel &kernel_) {
+    if (!kernel_.getModeKernel()) {
+      return;
+    }
+    const std::string cacheKey = getKernelHash(kernelHash, kernelName);
+
+    cachedKernelsMutex.lock();
+    // Keep the first kernel if another thread built the same one
+    kernel &cachedKernel = cachedKernels[cacheKey];
+    if (!cachedKernel.isInitialized()) {
+      cachedKernel = kernel_;
+      cachedKernel.getModeKernel()->cacheKey = cacheKey;
+    }
+    cachedKernelsMutex.unlock();
+  }
+
+  void modeDevice_t::trimMemoryPool() {}
 
-    return cachedKernels[getKernelHash(kernelHash, kernelName)];
+  occa::json modeDevice_t::memoryPoolInfo() const {
+    occa::json info;
+    info["enabled"] = false;
+    return info;
+  }
+
+  void modeDevice_t::buildKernels(kernelBuildVector &builds) {
+    for (kernelBuild_t *build : builds) {
+      try {
+        build->modeKernel = buildKernel(build->filename,
+                                        build->kernelName,
+                                        build->kernelHash,
+                                        build->kernelProps);
+      } catch (occa::exception &exc) {
+        build->error = exc.message;
+      }
+    }
+  }
+
+  bool modeDevice_t::releaseCachedKernel(modeKernel_t *kernel) {
+    if (kernel == NULL || !kernel->cacheKey.size()) {
+      return false;
+    }
+
+    cachedKernelsMutex.lock();
+    cachedKernelMapIterator it = cachedKernels.find(kernel->cacheKey);
+    const bool isCached = (
+      it != cachedKernels.end()
+      && it->second.getModeKernel() == kernel
+    );
+    // The caller's handle and the cache's handle
+    const bool isShared = isCached && (kernel->kernelRefs() > 2);
+    if (isCached && !isShared) {
+      cachedKernels.erase(it);
+    }
+    cachedKernelsMutex.unlock();
+
+    return isShared;
   }
 
   void modeDevice_t::removeCachedKernel(modeKernel_t *kernel) {
-    if (kernel == NULL) {
+    if (kernel == NULL || !kernel->cacheKey.size()) {
       return;
     }
-    cachedKernelMapIterator it = cachedKernels.find(getKernelHash(kernel));
-    if (it != cachedKernels.end()) {
+
+    cachedKernelsMutex.lock();
+    // The cached wrapper was NULL-ed if it pointed to [kernel]
+    cachedKernelMapIterator it = cachedKernels.find(kernel->cacheKey);
+    if (it != cachedKernels.end() && !it->second.isInitialized()) {
       cachedKernels.erase(it);
     }
+    cachedKernelsMutex.unlock();
+  }
+
+  udim_t modeDevice_t::getKernelCacheHits() {
+    cachedKernelsMutex.lock();
+    const udim_t hits = kernelCacheHits;
+    cachedKernelsMutex.unlock();
+    return hits;
+  }
+
+  udim_t modeDevice_t::getKernelCacheMisses() {
+    cachedKernelsMutex.lock();
+    const udim_t misses = kernelCacheMisses;
+    cachedKernelsMutex.unlock();
+    return misses;
+  }
+
+  bool modeDevice_t::getTunedProperties(const std::string &tuningFile,
+                                        occa::json &props) {
+    tunedPropertiesMutex.lock();
+    std::map<std::string, occa::json>::iterator it = tunedProperties.find(tuningFile);
+    const bool found = (it != tunedProperties.end());
+    if (found) {
+      props = it->second;
+    }
+    tunedPropertiesMutex.unlock();
+
+    return found;
+  }
+
+  void modeDevice_t::setTunedProperties(const std::string &tuningFile,
+                                        const occa::json &props) {
+    tunedPropertiesMutex.lock();
+    tunedProperties[tuningFile] = props;
+    tunedPropertiesMutex.unlock();
+  }
+
+  void modeDevice_t::removeTunedProperties(const std::string &tuningFile) {
+    tunedPropertiesMutex.lock();
+    tunedProperties.erase(tuningFile);
+    tunedPropertiesMutex.unlock();
+  }
+
+  void modeDevice_t::loadKernelBundle(const std::string &filename) {
+    kernelBundles.push_back(new kernelBundle_t(filename));
+  }
+
+  bool modeDevice_t::extractBundledKernel(const hash_t &kernelHash,
+                                          const std::string &hashDir) {
+    for (kernelBundle_t *bundle : kernelBundles) {
+      if (bundle->extractKernel(kernelHash, hashDir)) {
+        return true;
+      }
+    }
+    return false;
   }
 }
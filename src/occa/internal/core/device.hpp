@@ -3,11 +3,32 @@
 
 #include <occa/core/device.hpp>
 #include <occa/types/json.hpp>
+#include <occa/utils/mutex.hpp>
 #include <occa/internal/utils/gc.hpp>
 #include <occa/internal/utils/uva.hpp>
 #include <occa/internal/lang/kernelMetadata.hpp>
 
 namespace occa {
+  class kernelBundle_t;
+
+  class kernelBuild_t {
+   public:
+    std::string filename;
+    std::string kernelName;
+    hash_t kernelHash;
+    occa::json kernelProps;
+
+    modeKernel_t *modeKernel;
+    std::string error;
+
+    kernelBuild_t(const std::string &filename_,
+                  const std::string &kernelName_,
+                  const hash_t &kernelHash_,
+                  const occa::json &kernelProps_);
+  };
+
+  typedef std::vector<kernelBuild_t*> kernelBuildVector;
+
   class modeDevice_t {
    public:
     std::string mode;
@@ -27,8 +48,21 @@ namespace occa {
     std::vector<modeStream_t*> streams;
 
     udim_t bytesAllocated;
+    udim_t peakBytesAllocated;
 
+    // In-memory kernels keyed by (kernel hash, kernel name)
     cachedKernelMap cachedKernels;
+    mutex_t cachedKernelsMutex;
+    udim_t kernelCacheHits;
+    udim_t kernelCacheMisses;
+
+    // Properties picked by device.tuneKernel keyed by their tuning file,
+    //   uninitialized when there are no results
+    std::map<std::string, occa::json> tunedProperties;
+    mutex_t tunedPropertiesMutex;
+
+    // Prebuilt kernels served before compiling, see device.loadBundle
+    std::vector<kernelBundle_t*> kernelBundles;
 
     modeDevice_t(const occa::json &json_);
 
@@ -95,16 +129,48 @@ namespace occa {
 
     std::string getKernelHash(modeKernel_t *kernel);
 
-    kernel& getCachedKernel(const hash_t &kernelHash,
-                            const std::string &kernelName);
+    // Returns an uninitialized kernel on a cache miss
+    kernel getCachedKernel(const hash_t &kernelHash,
+                           const std::string &kernelName);
+
+    void setCachedKernel(const hash_t &kernelHash,
+                         const std::string &kernelName,
+                         const kernel &kernel_);
+
+    // Returns true if other handles still use the cached [kernel],
+    //   otherwise drops the cache's handle so it can be deleted
+    bool releaseCachedKernel(modeKernel_t *kernel);
 
+    // Called by ~modeKernel_t after its wrappers are NULL-ed
     void removeCachedKernel(modeKernel_t *kernel);
 
+    udim_t getKernelCacheHits();
+    udim_t getKernelCacheMisses();
+
+    // Returns false if [tuningFile] wasn't loaded yet
+    bool getTunedProperties(const std::string &tuningFile,
+                            occa::json &props);
+
+    void setTunedProperties(const std::string &tuningFile,
+                            const occa::json &props);
+
+    void removeTunedProperties(const std::string &tuningFile);
+
+    void loadKernelBundle(const std::string &filename);
+
+    // Restores the kernel's cache directory from a loaded bundle, if any has it
+    bool extractBundledKernel(const hash_t &kernelHash,
+                              const std::string &hashDir);
+
     virtual modeKernel_t* buildKernel(const std::string &filename,
                                       const std::string &kernelName,
                                       const hash_t hash,
                                       const occa::json &props) = 0;
 
+    // Builds each entry, storing the kernel or the build error in it
+    // Backends can override it to overlap independent builds
+    virtual void buildKernels(kernelBuildVector &builds);
+
     virtual modeKernel_t* buildKernelFromBinary(const std::string &filename,
                                                 const std::string &kernelName,
                                                 const occa::json &props) = 0;
@@ -120,6 +186,10 @@ namespace occa {
                                      const occa::json &props) = 0;
 
     virtual udim_t memorySize() const = 0;
+
+    // Backends without a memory pool report it as disabled
+    virtual void trimMemoryPool();
+    virtual occa::json memoryPoolInfo() const;
     //  |===============================
     //==================================
   };
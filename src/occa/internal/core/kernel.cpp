@@ -23,24 +23,44 @@ namespace occa {
     }
     // Remove ref from device
     if (modeDevice) {
+      modeDevice->removeCachedKernel(this);
       modeDevice->removeKernelRef(this);
     }
+
+    launchMutex.free();
+    refMutex.free();
   }
 
   void modeKernel_t::dontUseRefs() {
+    refMutex.lock();
     kernelRing.dontUseRefs();
+    refMutex.unlock();
   }
 
   void modeKernel_t::addKernelRef(kernel *ker) {
+    refMutex.lock();
     kernelRing.addRef(ker);
+    refMutex.unlock();
   }
 
   void modeKernel_t::removeKernelRef(kernel *ker) {
+    refMutex.lock();
     kernelRing.removeRef(ker);
+    refMutex.unlock();
+  }
+
+  bool modeKernel_t::needsFree() {
+    refMutex.lock();
+    const bool needsFree_ = kernelRing.needsFree();
+    refMutex.unlock();
+    return needsFree_;
   }
 
-  bool modeKernel_t::needsFree() const {
-    return kernelRing.needsFree();
+  int modeKernel_t::kernelRefs() {
+    refMutex.lock();
+    const int refs = kernelRing.length();
+    refMutex.unlock();
+    return refs;
   }
 
   void modeKernel_t::assertArgumentLimit() const {
@@ -80,52 +100,68 @@ namespace occa {
     assertArgumentLimit();
   }
 
-  void modeKernel_t::setupRun() {
-    const int argc = (int) arguments.size();
-
+  bool modeKernel_t::validateArguments(const kernelArgDataVector &args) const {
     const bool validateTypes = (
       metadata.isInitialized()
       && properties.get("type_validation", true)
     );
+    if (!validateTypes) {
+      return false;
+    }
 
-    if (validateTypes) {
-      const int metaArgc = (int) metadata.arguments.size();
+    const int argc = (int) args.size();
+    const int metaArgc = (int) metadata.arguments.size();
 
-      OCCA_ERROR("(" << hash << ":" << name << ") Kernel expects ["
-                 << metaArgc << "] argument"
-                 << (metaArgc != 1 ? "s," : ",")
-                 << " received ["
-                 << argc << ']',
-                 argc == metaArgc);
+    OCCA_ERROR("(" << hash << ":" << name << ") Kernel expects ["
+               << metaArgc << "] argument"
+               << (metaArgc != 1 ? "s," : ",")
+               << " received ["
+               << argc << ']',
+               argc == metaArgc);
 
-      // TODO: Get original arg #
-      for (int i = 0; i < argc; ++i) {
-        kernelArgData &arg = arguments[i];
-        lang::argMetadata_t &argInfo = metadata.arguments[i];
-
-        modeMemory_t *mem = arg.getModeMemory();
-        const bool isNull = arg.value.isNull();
-        const bool isPtr = mem || isNull;
-        if (isPtr != argInfo.isPtr) {
-          if (argInfo.isPtr) {
-            OCCA_FORCE_ERROR("(" << hash << ":" << name << ") Kernel expects an occa::memory for argument ["
-                             << (i + 1) << "]");
-          } else {
-            OCCA_FORCE_ERROR("(" << hash << ":" << name << ") Kernel expects a non-occa::memory type for argument ["
-                             << (i + 1) << "]");
-          }
-        }
+    // TODO: Get original arg #
+    for (int i = 0; i < argc; ++i) {
+      validateArgument(i, args[i]);
+    }
+    return true;
+  }
 
-        if (!isPtr || isNull) {
-          continue;
-        }
+  void modeKernel_t::validateArgument(const int index,
+                                      const kernelArgData &arg) const {
+    const lang::argMetadata_t &argInfo = metadata.arguments[index];
+
+    modeMemory_t *mem = arg.getModeMemory();
+    const bool isNull = arg.value.isNull();
+    const bool isPtr = mem || isNull;
+    if (isPtr != argInfo.isPtr) {
+      if (argInfo.isPtr) {
+        OCCA_FORCE_ERROR("(" << hash << ":" << name << ") Kernel expects an occa::memory for argument ["
+                         << (index + 1) << "]");
+      } else {
+        OCCA_FORCE_ERROR("(" << hash << ":" << name << ") Kernel expects a non-occa::memory type for argument ["
+                         << (index + 1) << "]");
+      }
+    }
+
+    if (!isPtr || isNull) {
+      return;
+    }
 
-        OCCA_ERROR("(" << hash << ":" << name << ") Argument [" << (i + 1) << "] has wrong runtime type.\n"
-                   << "Expected type: " << argInfo.dtype << '\n'
-                   << "Received type: " << *(mem->dtype_) << '\n',
-                   mem->dtype_->canBeCastedTo(argInfo.dtype));
+    OCCA_ERROR("(" << hash << ":" << name << ") Argument [" << (index + 1) << "] has wrong runtime type.\n"
+               << "Expected type: " << argInfo.dtype << '\n'
+               << "Received type: " << *(mem->dtype_) << '\n',
+               mem->dtype_->canBeCastedTo(argInfo.dtype));
+  }
 
-        arg.setupForKernelCall(argInfo.isConst);
+  void modeKernel_t::setupArgumentsForCall(const kernelArgDataVector &args,
+                                           const bool validated) const {
+    const int argc = (int) args.size();
+    if (validated) {
+      for (int i = 0; i < argc; ++i) {
+        const kernelArgData &arg = args[i];
+        if (arg.getModeMemory() && !arg.value.isNull()) {
+          arg.setupForKernelCall(metadata.arguments[i].isConst);
+        }
       }
       return;
     }
@@ -133,14 +169,37 @@ namespace occa {
     // Non-OKL kernel setup
     // All memory arguments are expected to be non-const for UVA purposes
     for (int i = 0; i < argc; ++i) {
-      kernelArgData &arg = arguments[i];
-      modeMemory_t *mem = arg.getModeMemory();
-      if (mem) {
+      const kernelArgData &arg = args[i];
+      if (arg.getModeMemory()) {
         arg.setupForKernelCall(false);
       }
     }
   }
 
+  void modeKernel_t::runWithArguments(const kernelArgDataVector &args,
+                                      const dim &outerDims_,
+                                      const dim &innerDims_) {
+    launchMutex.lock();
+    const dim kernelOuterDims = outerDims;
+    const dim kernelInnerDims = innerDims;
+
+    // Reuses the capacity of the kernel arguments, no allocation after the first launch
+    arguments = args;
+    outerDims = outerDims_;
+    innerDims = innerDims_;
+    try {
+      run();
+    } catch (...) {
+      outerDims = kernelOuterDims;
+      innerDims = kernelInnerDims;
+      launchMutex.unlock();
+      throw;
+    }
+    outerDims = kernelOuterDims;
+    innerDims = kernelInnerDims;
+    launchMutex.unlock();
+  }
+
   bool modeKernel_t::isNoop() const {
     return (
       outerDims.isZero() && innerDims.isZero()
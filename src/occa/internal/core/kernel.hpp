@@ -3,6 +3,7 @@
 
 #include <occa/core/kernel.hpp>
 #include <occa/types/json.hpp>
+#include <occa/utils/mutex.hpp>
 #include <occa/internal/utils/gc.hpp>
 #include <occa/internal/lang/kernelMetadata.hpp>
 
@@ -15,14 +16,20 @@ namespace occa {
     std::string sourceFilename, binaryFilename;
     occa::json properties;
     hash_t hash;
+    // Set if the device cached this kernel
+    std::string cacheKey;
 
-    // Requirements to launch kernel
+    // Requirements to launch kernel, the dimensions are the defaults for kernel handles
     dim outerDims, innerDims;
     std::vector<kernelArgData> arguments;
     lang::kernelMetadata_t metadata;
 
-    // References
+    // Guards the launch state above while run() reads it
+    mutex_t launchMutex;
+
+    // References, guarded by refMutex since cached kernels are shared between threads
     gc::ring_t<kernel> kernelRing;
+    mutex_t refMutex;
 
     modeKernel_t(modeDevice_t *modeDevice_,
                  const std::string &name_,
@@ -32,7 +39,8 @@ namespace occa {
     void dontUseRefs();
     void addKernelRef(kernel *ker);
     void removeKernelRef(kernel *ker);
-    bool needsFree() const;
+    bool needsFree();
+    int kernelRefs();
 
     void assertArgumentLimit() const;
     void assertArgInDevice(const kernelArgData &arg,
@@ -44,7 +52,14 @@ namespace occa {
 
     void setSourceMetadata(lang::parser_t &parser);
 
-    void setupRun();
+    // Returns true if the arguments were checked against the kernel metadata
+    bool validateArguments(const kernelArgDataVector &args) const;
+    void validateArgument(const int index,
+                          const kernelArgData &arg) const;
+
+    // Syncs UVA memory arguments before a launch
+    void setupArgumentsForCall(const kernelArgDataVector &args,
+                               const bool validated) const;
 
     bool isNoop() const;
 
@@ -58,6 +73,12 @@ namespace occa {
     virtual const lang::kernelMetadata_t& getMetadata() const = 0;
 
     virtual void run() const = 0;
+
+    // Runs with per-launch state since handles to a cached kernel can launch concurrently.
+    //   The default sets [arguments] and the dimensions for run() under launchMutex
+    virtual void runWithArguments(const kernelArgDataVector &args,
+                                  const dim &outerDims_,
+                                  const dim &innerDims_);
     //==================================
   };
 }
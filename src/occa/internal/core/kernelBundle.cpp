@@ -0,0 +1,256 @@
+#include <cstring>
+#include <fstream>
+
+#include <occa/internal/core/kernelBundle.hpp>
+#include <occa/internal/io.hpp>
+#include <occa/internal/utils/env.hpp>
+#include <occa/internal/utils/string.hpp>
+#include <occa/internal/utils/sys.hpp>
+#include <occa/utils/exception.hpp>
+
+#if (OCCA_OS & (OCCA_LINUX_OS | OCCA_MACOS_OS))
+#  include <fcntl.h>
+#  include <sys/mman.h>
+#  include <sys/stat.h>
+#  include <unistd.h>
+#endif
+
+namespace occa {
+  const std::string kernelBundle_t::header = "OCCA-BUNDLE\n";
+  const int kernelBundle_t::version = 1;
+
+  static void addBundleFiles(const std::string &dir,
+                             const std::string &relativeDir,
+                             occa::json &files,
+                             std::string &contents) {
+    for (const std::string &file : io::files(dir + relativeDir)) {
+      const std::string path = relativeDir + io::basename(file);
+      const std::string content = io::read(file, enums::FILE_TYPE_BINARY);
+
+      occa::json fileInfo;
+      fileInfo.asArray();
+      fileInfo += path;
+      fileInfo += (udim_t) contents.size();
+      fileInfo += (udim_t) content.size();
+      files += fileInfo;
+
+      contents += content;
+    }
+    for (const std::string &subdir : io::directories(dir + relativeDir)) {
+      addBundleFiles(dir,
+                     relativeDir + io::basename(io::removeEndSlash(subdir)) + "/",
+                     files,
+                     contents);
+    }
+  }
+
+  kernelBundle_t::kernelBundle_t(const std::string &filename_) :
+    filename(io::expandFilename(filename_)),
+    data(NULL),
+    bytes(0),
+    isMapped(false),
+    contents(NULL) {
+#if (OCCA_OS & (OCCA_LINUX_OS | OCCA_MACOS_OS))
+    const int fd = ::open(filename.c_str(), O_RDONLY);
+    OCCA_ERROR("Unable to open kernel bundle [" << filename << "]",
+               fd >= 0);
+
+    struct stat fileStat;
+    if (!::fstat(fd, &fileStat) && fileStat.st_size) {
+      bytes = fileStat.st_size;
+      void *mappedPtr = ::mmap(NULL, bytes, PROT_READ, MAP_PRIVATE, fd, 0);
+      if (mappedPtr != MAP_FAILED) {
+        data = (char*) mappedPtr;
+        isMapped = true;
+      }
+    }
+    ::close(fd);
+#endif
+    if (!data) {
+      data = io::c_read(filename, &bytes, enums::FILE_TYPE_BINARY);
+    }
+
+    // The destructor doesn't run if the bundle is rejected
+    try {
+      loadIndex();
+    } catch (...) {
+      freeData();
+      throw;
+    }
+  }
+
+  kernelBundle_t::~kernelBundle_t() {
+    freeData();
+  }
+
+  void kernelBundle_t::freeData() {
+#if (OCCA_OS & (OCCA_LINUX_OS | OCCA_MACOS_OS))
+    if (isMapped) {
+      ::munmap(data, bytes);
+      data = NULL;
+      return;
+    }
+#endif
+    delete [] data;
+    data = NULL;
+  }
+
+  void kernelBundle_t::loadIndex() {
+    const size_t headerBytes = header.size();
+    const char *indexStart = data + headerBytes;
+    const char *indexEnd = (
+      (bytes > headerBytes)
+      ? (const char*) ::memchr(indexStart, '\0', bytes - headerBytes)
+      : NULL
+    );
+    OCCA_ERROR("File [" << filename << "] is not a kernel bundle",
+               indexEnd && !::strncmp(data, header.c_str(), headerBytes));
+
+    index = json::parse(std::string(indexStart, indexEnd - indexStart));
+    contents = indexEnd + 1;
+
+    OCCA_ERROR("Kernel bundle [" << filename << "] has an unsupported version",
+               (int) index.get("version", 0) == version);
+
+    // Files are copied straight out of the bundle, so every entry has to fit in it
+    const occa::json &hashes = index["hashes"];
+    OCCA_ERROR("Kernel bundle [" << filename << "] is missing its [hashes] index",
+               hashes.isObject());
+
+    const udim_t contentBytes = bytes - (contents - data);
+    for (const auto &it : hashes.object()) {
+      const occa::json &files = it.second;
+      OCCA_ERROR("Kernel bundle [" << filename << "] has an invalid file list for [" << it.first << "]",
+                 files.isArray());
+
+      const int fileCount = files.size();
+      for (int i = 0; i < fileCount; ++i) {
+        const occa::json &fileInfo = files[i];
+        const bool isValidEntry = (
+          fileInfo.isArray()
+          && (fileInfo.size() == 3)
+          && fileInfo[0].isString()
+          && fileInfo[1].isNumber()
+          && fileInfo[2].isNumber()
+        );
+        OCCA_ERROR("Kernel bundle [" << filename << "] has an invalid file entry for [" << it.first << "]",
+                   isValidEntry);
+
+        const std::string path = fileInfo[0];
+        OCCA_ERROR("Kernel bundle [" << filename << "] has an unsafe file path [" << path << "]",
+                   path.size()
+                   && (path[0] != '/')
+                   && (path.find("..") == std::string::npos));
+
+        const int64_t offset = fileInfo[1];
+        const int64_t fileBytes = fileInfo[2];
+        OCCA_ERROR("Kernel bundle [" << filename << "] is truncated or corrupt,"
+                   << " file [" << path << "] doesn't fit in the bundle",
+                   (0 <= offset)
+                   && (0 <= fileBytes)
+                   && ((udim_t) offset <= contentBytes)
+                   && ((udim_t) fileBytes <= (contentBytes - (udim_t) offset)));
+      }
+    }
+  }
+
+  bool kernelBundle_t::hasKernel(const hash_t &kernelHash) const {
+    return index["hashes"].has(kernelHash.getFullString());
+  }
+
+  bool kernelBundle_t::extractKernel(const hash_t &kernelHash,
+                                     const std::string &hashDir) const {
+    const occa::json &files = index["hashes"][kernelHash.getFullString()];
+    if (!files.isArray()) {
+      return false;
+    }
+
+    const int fileCount = files.size();
+    bool isExtracted = true;
+    for (int i = 0; (i < fileCount) && isExtracted; ++i) {
+      isExtracted = io::isFile(hashDir + (std::string) files[i][0]);
+    }
+    if (isExtracted) {
+      return true;
+    }
+
+    io::lock_t lock(kernelHash, "kernel-bundle");
+    if (!lock.isMine()) {
+      // Another process extracted it
+      return true;
+    }
+
+    // Write the .success markers last so a partial extraction is never loaded
+    for (int pass = 0; pass < 2; ++pass) {
+      for (int i = 0; i < fileCount; ++i) {
+        const occa::json &fileInfo = files[i];
+        const std::string path = fileInfo[0];
+        if (startsWith(path, ".success/") != (pass == 1)) {
+          continue;
+        }
+
+        const std::string target = hashDir + path;
+        if (io::isFile(target)) {
+          continue;
+        }
+        sys::mkpath(io::dirname(target));
+
+        std::ofstream out(target.c_str(), std::ios::out | std::ios::binary);
+        OCCA_ERROR("Unable to write [" << target << "]",
+                   out.good());
+        out.write(contents + (udim_t) fileInfo[1],
+                  (udim_t) fileInfo[2]);
+      }
+    }
+    return true;
+  }
+
+  void kernelBundle_t::write(const std::string &filename,
+                             const occa::device &device,
+                             const std::vector<kernelSpec> &specs) {
+    std::vector<kernel> kernels = device.buildKernels(specs);
+
+    occa::json index;
+    index["version"] = version;
+    index["mode"] = device.mode();
+    index["device_hash"] = device.hash().getFullString();
+    index["kernels"].asArray();
+
+    jsonObject hashes;
+    std::string contents;
+    for (int i = 0; i < (int) specs.size(); ++i) {
+      const kernelSpec &spec = specs[i];
+      const hash_t kernelHash = kernels[i].hash();
+      const std::string hashKey = kernelHash.getFullString();
+
+      occa::json kernelInfo;
+      kernelInfo["file"] = spec.filename;
+      kernelInfo["kernel"] = spec.kernelName;
+      kernelInfo["hash"] = hashKey;
+      index["kernels"] += kernelInfo;
+
+      if (hashes.find(hashKey) != hashes.end()) {
+        continue;
+      }
+
+      const std::string realFilename = io::findInPaths(spec.filename, env::OCCA_KERNEL_PATH);
+      occa::json files;
+      files.asArray();
+      addBundleFiles(io::hashDir(realFilename, kernelHash), "", files, contents);
+      hashes[hashKey] = files;
+    }
+    index["hashes"] = hashes;
+
+    const std::string expFilename = io::expandFilename(filename);
+    sys::mkpath(io::dirname(expFilename));
+
+    std::ofstream out(expFilename.c_str(), std::ios::out | std::ios::binary);
+    OCCA_ERROR("Unable to write kernel bundle [" << expFilename << "]",
+               out.good());
+
+    const std::string indexStr = index.dump(0);
+    out.write(header.c_str(), header.size());
+    out.write(indexStr.c_str(), indexStr.size() + 1);
+    out.write(contents.c_str(), contents.size());
+  }
+}
@@ -0,0 +1,57 @@
+#ifndef OCCA_INTERNAL_CORE_KERNELBUNDLE_HEADER
+#define OCCA_INTERNAL_CORE_KERNELBUNDLE_HEADER
+
+#include <vector>
+
+#include <occa/core/device.hpp>
+#include <occa/types/json.hpp>
+
+namespace occa {
+  // Single-file archive of cached kernel builds:
+  //
+  //   OCCA-BUNDLE\n
+  //   <JSON index>\0
+  //   <file contents>
+  //
+  // The index lists the bundled kernels and, for each kernel hash, the files
+  //   from its cache directory as [path, offset, bytes] in the file contents
+  class kernelBundle_t {
+   public:
+    static const std::string header;
+    static const int version;
+
+    std::string filename;
+    occa::json index;
+
+   private:
+    char *data;
+    size_t bytes;
+    bool isMapped;
+    const char *contents;
+
+   public:
+    kernelBundle_t(const std::string &filename_);
+    ~kernelBundle_t();
+
+   private:
+    void freeData();
+
+    // Parses and validates the index against the bundle size
+    void loadIndex();
+
+   public:
+    bool hasKernel(const hash_t &kernelHash) const;
+
+    // Writes the kernel's cached files to hashDir if they are missing
+    // Returns false if the kernel isn't bundled
+    bool extractKernel(const hash_t &kernelHash,
+                       const std::string &hashDir) const;
+
+    // Builds the kernels and bundles their cache directories
+    static void write(const std::string &filename,
+                      const occa::device &device,
+                      const std::vector<kernelSpec> &specs);
+  };
+}
+
+#endif
@@ -34,6 +34,15 @@ namespace occa {
     return ptr;
   }
 
+  void modeMemory_t::assertDetachable() const {}
+
+  primitive modeMemory_t::getKernelArgAtOffset(const udim_t offset) const {
+    OCCA_ERROR("Backend does not support passing memory views with an offset to kernels,"
+               << " use memory::slice instead",
+               offset == 0);
+    return getKernelArgPtr();
+  }
+
   void modeMemory_t::dontUseRefs() {
     memoryRing.dontUseRefs();
   }
@@ -42,10 +42,16 @@ namespace occa {
 
     virtual void* getKernelArgPtr() const = 0;
 
+    // Kernel argument for the memory starting [offset] bytes in, used by memoryView
+    virtual primitive getKernelArgAtOffset(const udim_t offset) const;
+
     virtual modeMemory_t* addOffset(const dim_t offset) = 0;
 
     virtual void* getPtr();
 
+    // Throws before memory.detach() if the caller couldn't release the block itself
+    virtual void assertDetachable() const;
+
     virtual void copyTo(void *dest,
                         const udim_t bytes,
                         const udim_t offset = 0,
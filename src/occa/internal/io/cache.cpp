@@ -110,6 +110,7 @@ namespace occa {
       props["human_date"] = sys::humanDate();
       props["version/occa"] = OCCA_VERSION_STR;
       props["version/okl"]  = OKL_VERSION_STR;
+      props["version/cache"] = OCCA_CACHE_VERSION;
     }
 
     void writeBuildFile(const std::string &filename,
@@ -0,0 +1,438 @@
+#include <map>
+#include <set>
+#include <vector>
+
+#include <occa/internal/lang/modes/innerLoopFusion.hpp>
+#include <occa/internal/lang/modes/oklForStatement.hpp>
+#include <occa/internal/lang/expr.hpp>
+#include <occa/internal/lang/variable.hpp>
+
+namespace occa {
+  namespace lang {
+    namespace okl {
+      class variableAccesses_t {
+       public:
+        bool isWritten;
+        // Accesses other than [var[index]...], such as passing the pointer around
+        bool hasUnindexedAccess;
+        std::vector<exprNodeVector> indices;
+
+        variableAccesses_t() :
+          isWritten(false),
+          hasUnindexedAccess(false) {}
+      };
+
+      typedef std::map<variable_t*, variableAccesses_t> variableAccessesMap;
+
+      class loopAccesses_t {
+       public:
+        variable_t *iterator;
+        variableAccessesMap accesses;
+        // Variables whose value can change between iterations
+        std::set<variable_t*> variantVariables;
+
+        loopAccesses_t(forStatement &forSmnt,
+                       variable_t &iterator_) :
+          iterator(&iterator_) {
+
+          variantVariables.insert(iterator);
+
+          statementArray::from(forSmnt)
+            .nestedForEach([&](statement_t *smnt) {
+              if (smnt->type() & statementType::declaration) {
+                for (variableDeclaration &decl : ((declarationStatement*) smnt)->declarations) {
+                  variantVariables.insert(&decl.variable());
+                }
+              }
+              for (smntExprNode &smntExpr : smnt->getDirectExprNodes()) {
+                addExpr(smntExpr.node, false, false);
+              }
+            });
+
+          for (auto &it : accesses) {
+            if (it.second.isWritten) {
+              variantVariables.insert(it.first);
+            }
+          }
+        }
+
+        void addExpr(exprNode *node,
+                     const bool isWrite,
+                     const bool isCallArg) {
+          if (!node) {
+            return;
+          }
+
+          const udim_t nodeType = node->type();
+
+          if (nodeType & exprNodeType::variable) {
+            variable_t &var = ((variableNode*) node)->value;
+            variableAccesses_t &varAccesses = accesses[&var];
+            varAccesses.hasUnindexedAccess = true;
+            // Pointers passed to functions can be written through
+            varAccesses.isWritten |= (
+              isWrite
+              || (isCallArg && var.vartype.isPointerType())
+            );
+            return;
+          }
+
+          if (nodeType & exprNodeType::subscript) {
+            // Unroll [var[i][j]...] into its variable and indices
+            exprNodeVector indices;
+            exprNode *value = node;
+            while (value->type() & exprNodeType::subscript) {
+              subscriptNode &subscript = *((subscriptNode*) value);
+              indices.insert(indices.begin(), subscript.index);
+              value = subscript.value;
+            }
+            for (exprNode *index : indices) {
+              addExpr(index, false, false);
+            }
+
+            if (value->type() & exprNodeType::variable) {
+              variableAccesses_t &varAccesses = accesses[&(((variableNode*) value)->value)];
+              varAccesses.isWritten |= isWrite;
+              varAccesses.indices.push_back(indices);
+            } else {
+              addExpr(value, isWrite, isCallArg);
+            }
+            return;
+          }
+
+          if (nodeType & exprNodeType::binary) {
+            binaryOpNode &opNode = *((binaryOpNode*) node);
+            addExpr(opNode.leftValue,
+                    isWrite || (opNode.opType() & operatorType::assignment),
+                    isCallArg);
+            addExpr(opNode.rightValue, false, isCallArg);
+            return;
+          }
+
+          if (nodeType & (exprNodeType::leftUnary | exprNodeType::rightUnary)) {
+            exprOpNode &opNode = *((exprOpNode*) node);
+            exprNode *value = (
+              (nodeType & exprNodeType::leftUnary)
+              ? ((leftUnaryOpNode*) node)->value
+              : ((rightUnaryOpNode*) node)->value
+            );
+            // Taking the address lets the variable be written elsewhere
+            const bool writesValue = (
+              opNode.opType() & (operatorType::increment
+                                 | operatorType::decrement
+                                 | operatorType::address)
+            );
+            addExpr(value, isWrite || writesValue, isCallArg);
+            return;
+          }
+
+          if (nodeType & exprNodeType::call) {
+            callNode &call = *((callNode*) node);
+            addExpr(call.value, false, false);
+            for (exprNode *arg : call.args) {
+              addExpr(arg, false, true);
+            }
+            return;
+          }
+
+          exprNodeVector children;
+          node->pushChildNodes(children);
+          for (exprNode *child : children) {
+            addExpr(child, isWrite, isCallArg);
+          }
+        }
+
+        bool isInvariant(exprNode *node) const {
+          exprNodeVector nodes = node->getNestedChildren();
+          nodes.push_back(node);
+          for (exprNode *child : nodes) {
+            if (child->type() & exprNodeType::call) {
+              return false;
+            }
+            if ((child->type() & exprNodeType::variable)
+                && variantVariables.count(&(((variableNode*) child)->value))) {
+              return false;
+            }
+          }
+          return true;
+        }
+
+        // Matches [±iterator + invariant], which maps work-items to distinct indices
+        bool isIteratorOffset(exprNode *node) const {
+          const udim_t nodeType = node->type();
+
+          if (nodeType & exprNodeType::variable) {
+            return &(((variableNode*) node)->value) == iterator;
+          }
+          if (nodeType & exprNodeType::parentheses) {
+            return isIteratorOffset(((parenthesesNode*) node)->value);
+          }
+          if (nodeType & exprNodeType::leftUnary) {
+            leftUnaryOpNode &opNode = *((leftUnaryOpNode*) node);
+            return (
+              (opNode.opType() & (operatorType::positive | operatorType::negative))
+              && isIteratorOffset(opNode.value)
+            );
+          }
+          if (nodeType & exprNodeType::binary) {
+            binaryOpNode &opNode = *((binaryOpNode*) node);
+            if (!(opNode.opType() & (operatorType::add | operatorType::sub))) {
+              return false;
+            }
+            return (
+              (isIteratorOffset(opNode.leftValue) && isInvariant(opNode.rightValue))
+              || (isInvariant(opNode.leftValue) && isIteratorOffset(opNode.rightValue))
+            );
+          }
+          return false;
+        }
+
+        // Every access must go through the same per-work-item index
+        bool hasWorkItemIndices(variable_t &var,
+                                std::string &indexStr) const {
+          auto it = accesses.find(&var);
+          if (it == accesses.end()) {
+            return true;
+          }
+
+          const variableAccesses_t &varAccesses = it->second;
+          if (varAccesses.hasUnindexedAccess) {
+            return false;
+          }
+
+          for (const exprNodeVector &indices : varAccesses.indices) {
+            std::string str;
+            int iteratorIndices = 0;
+            for (exprNode *index : indices) {
+              if (isIteratorOffset(index)) {
+                ++iteratorIndices;
+              } else if (!isInvariant(index)) {
+                return false;
+              }
+              str += '[' + index->toString() + ']';
+            }
+            if (iteratorIndices != 1) {
+              return false;
+            }
+            if (!indexStr.size()) {
+              indexStr = str;
+            } else if (indexStr != str) {
+              return false;
+            }
+          }
+          return true;
+        }
+      };
+
+      static bool isInnerMostInnerLoop(statement_t *smnt) {
+        if (!smnt
+            || !(smnt->type() & statementType::for_)
+            || !smnt->hasAttribute("inner")) {
+          return false;
+        }
+        return statementArray::from(*smnt)
+          .flatFilterByStatementType(statementType::for_, "inner")
+          .length() == 1;
+      }
+
+      static std::string headerToString(forStatement &forSmnt) {
+        std::string str;
+        statement_t *smnts[3] = { forSmnt.init, forSmnt.check, forSmnt.update };
+        for (statement_t *smnt : smnts) {
+          str += (smnt ? smnt->toString() : std::string()) + ';';
+        }
+        for (const attributeArg_t &arg : forSmnt.attributes["inner"].args) {
+          str += (arg.expr ? arg.expr->toString() : std::string()) + ',';
+        }
+        return str;
+      }
+
+      static bool isUnrestrictedPointer(variable_t &var) {
+        return (
+          var.vartype.isPointerType()
+          && !var.vartype.arrays.size()
+          && !var.hasAttribute("restrict")
+        );
+      }
+
+      static bool mayAlias(variable_t &var1,
+                           variable_t &var2) {
+        // Arrays own their memory and @restrict pointers promise not to alias
+        return (
+          isUnrestrictedPointer(var1)
+          && isUnrestrictedPointer(var2)
+        );
+      }
+
+      // Checks that writes in [writer] are only seen by the same work-item in [reader]
+      static bool writesAreWorkItemLocal(const loopAccesses_t &writer,
+                                         const loopAccesses_t &reader) {
+        for (auto &writeIt : writer.accesses) {
+          variable_t &writtenVar = *(writeIt.first);
+          if (!writeIt.second.isWritten
+              || writtenVar.hasAttribute("exclusive")) {
+            continue;
+          }
+
+          for (auto &readIt : reader.accesses) {
+            variable_t &readVar = *(readIt.first);
+            if (&readVar != &writtenVar) {
+              if (mayAlias(writtenVar, readVar)) {
+                return false;
+              }
+              continue;
+            }
+
+            std::string indexStr;
+            if (!writer.hasWorkItemIndices(writtenVar, indexStr)
+                || !reader.hasWorkItemIndices(writtenVar, indexStr)) {
+              return false;
+            }
+          }
+        }
+        return true;
+      }
+
+      // Checks for return or goto statements, or for break (and optionally continue)
+      //   statements that apply to [forSmnt] rather than to a nested loop or switch
+      static bool leavesIteration(forStatement &forSmnt,
+                                  const bool checkContinue) {
+        if (statementArray::from(forSmnt)
+            .flatFilterByStatementType(statementType::return_
+                                       | statementType::goto_)
+            .length()) {
+          return true;
+        }
+
+        return !statementArray::from(forSmnt)
+          .flatFilterByStatementType(statementType::break_
+                                     | statementType::continue_)
+          .filter([&](statement_t *smnt) {
+            const bool isBreak = (smnt->type() & statementType::break_);
+            if (!isBreak && !checkContinue) {
+              return false;
+            }
+            for (statement_t *up = smnt->up; up && (up != &forSmnt); up = up->up) {
+              const int sType = up->type();
+              if ((sType & (statementType::for_ | statementType::while_))
+                  || (isBreak && (sType & statementType::switch_))) {
+                return false;
+              }
+            }
+            return true;
+          })
+          .isEmpty();
+      }
+
+      int fuseInnerLoops(blockStatement &root) {
+        int fusedLoops = 0;
+
+        // Parents of @inner loops are kept while their children are fused
+        std::vector<blockStatement*> parentSmnts;
+        std::set<blockStatement*> foundParentSmnts;
+        statementArray::from(root)
+          .flatFilterByStatementType(statementType::for_, "inner")
+          .forEach([&](statement_t *smnt) {
+            blockStatement *parent = smnt->up;
+            if (parent && !foundParentSmnts.count(parent)) {
+              foundParentSmnts.insert(parent);
+              parentSmnts.push_back(parent);
+            }
+          });
+
+        for (blockStatement *parent : parentSmnts) {
+          int i = 0;
+          while ((i + 1) < parent->size()) {
+            statement_t *child = (*parent)[i];
+            statement_t *nextChild = (*parent)[i + 1];
+            if (!isInnerMostInnerLoop(child)
+                || !isInnerMostInnerLoop(nextChild)
+                || !canFuseInnerLoops((forStatement&) *child,
+                                      (forStatement&) *nextChild)) {
+              ++i;
+              continue;
+            }
+            // Keep fusing following loops into the same loop
+            fuseInnerLoop((forStatement&) *child,
+                          (forStatement&) *nextChild);
+            ++fusedLoops;
+          }
+        }
+
+        return fusedLoops;
+      }
+
+      bool canFuseInnerLoops(forStatement &forSmnt,
+                             forStatement &nextForSmnt) {
+        if (headerToString(forSmnt) != headerToString(nextForSmnt)) {
+          return false;
+        }
+
+        // Leaving an iteration early would skip the fused statements
+        if (leavesIteration(forSmnt, true)
+            || leavesIteration(nextForSmnt, false)) {
+          return false;
+        }
+
+        const statementArray barriers = (
+          statementArray::from(forSmnt).flatFilterByAttribute("barrier")
+        );
+        const statementArray nextBarriers = (
+          statementArray::from(nextForSmnt).flatFilterByAttribute("barrier")
+        );
+        if (barriers.length() || nextBarriers.length()) {
+          return false;
+        }
+
+        oklForStatement oklForSmnt(forSmnt, "", false);
+        oklForStatement nextOklForSmnt(nextForSmnt, "", false);
+        if (!oklForSmnt.isValid() || !nextOklForSmnt.isValid()) {
+          return false;
+        }
+
+        const loopAccesses_t accesses(forSmnt, *oklForSmnt.iterator);
+        const loopAccesses_t nextAccesses(nextForSmnt, *nextOklForSmnt.iterator);
+
+        return (
+          writesAreWorkItemLocal(accesses, nextAccesses)
+          && writesAreWorkItemLocal(nextAccesses, accesses)
+        );
+      }
+
+      void fuseInnerLoop(forStatement &forSmnt,
+                         forStatement &nextForSmnt) {
+        oklForStatement oklForSmnt(forSmnt, "", false);
+        oklForStatement nextOklForSmnt(nextForSmnt, "", false);
+        variable_t &iterator = *oklForSmnt.iterator;
+        variable_t &nextIterator = *nextOklForSmnt.iterator;
+        const std::string nextIteratorName = nextIterator.name();
+
+        blockStatement &nextBody = *(new blockStatement(&forSmnt,
+                                                        nextForSmnt.source));
+        nextBody.swapChildren(nextForSmnt);
+        nextBody.swapScope(nextForSmnt);
+
+        // Point the moved body to the fused loop's iterator
+        statementArray::from(nextBody)
+          .flatFilterByExprType(exprNodeType::variable)
+          .inplaceMap([&](smntExprNode smntExpr) -> exprNode* {
+            variableNode &varNode = (variableNode&) *smntExpr.node;
+            if (&(varNode.value) != &nextIterator) {
+              return &varNode;
+            }
+            return new variableNode(varNode.token, iterator);
+          });
+
+        forSmnt.addLast(nextBody);
+
+        nextForSmnt.up->remove(nextForSmnt);
+        delete &nextForSmnt;
+
+        // The unused iterator is owned by the swapped scope
+        if (nextBody.hasDirectlyInScope(nextIteratorName)) {
+          nextBody.removeFromScope(nextIteratorName);
+        }
+      }
+    }
+  }
+}
@@ -0,0 +1,35 @@
+#ifndef OCCA_INTERNAL_LANG_MODES_INNERLOOPFUSION_HEADER
+#define OCCA_INTERNAL_LANG_MODES_INNERLOOPFUSION_HEADER
+
+#include <occa/internal/lang/statement.hpp>
+
+namespace occa {
+  namespace lang {
+    namespace okl {
+      // Fuses adjacent inner-most @inner loops with identical headers for host modes:
+      //
+      //   for (int j = 0; j < 16; ++j; @inner) { A }      for (int j = 0; j < 16; ++j; @inner) {
+      //   for (int j = 0; j < 16; ++j; @inner) { B }  ->    A
+      //                                                     { B }
+      //                                                   }
+      //
+      // Loops are only fused if no work-item can observe another work-item's
+      //   results across the two loops:
+      //   - Memory written in one loop and accessed in the other must be indexed by
+      //     [±iterator + invariant] in every access
+      //   - Pointers without @restrict may alias each other
+      //   - The first loop can't leave an iteration early (break, continue, return, goto)
+      //
+      // Returns the number of loops fused away
+      int fuseInnerLoops(blockStatement &root);
+
+      bool canFuseInnerLoops(forStatement &forSmnt,
+                             forStatement &nextForSmnt);
+
+      void fuseInnerLoop(forStatement &forSmnt,
+                         forStatement &nextForSmnt);
+    }
+  }
+}
+
+#endif
@@ -264,21 +264,29 @@ namespace occa {
           return NULL;
         }
 
+        // Distance between the bounds in the loop direction
         exprNode *initInParen = initValue->wrapInParentheses();
+        exprNode *checkInParen = checkValue->wrapInParentheses();
         exprNode *count = (
-          new binaryOpNode(iterator->source,
-                           positiveUpdate ? op::sub : op::add,
-                           *checkValue,
-                           *initInParen)
+          positiveUpdate
+          ? new binaryOpNode(iterator->source,
+                             op::sub,
+                             *checkInParen,
+                             *initInParen)
+          : new binaryOpNode(iterator->source,
+                             op::sub,
+                             *initInParen,
+                             *checkInParen)
         );
         delete initInParen;
+        delete checkInParen;
 
         if (checkIsInclusive) {
           primitiveNode inc(iterator->source, 1);
 
           exprNode *countWithInc = (
             new binaryOpNode(iterator->source,
-                             positiveUpdate ? op::sub : op::add,
+                             op::add,
                              *count,
                              inc)
           );
@@ -287,15 +295,16 @@ namespace occa {
         }
 
         if (updateValue) {
+          // Round up: (count + update - 1) / update
           exprNode *updateInParen = updateValue->wrapInParentheses();
 
           primitiveNode one(iterator->source, 1);
           binaryOpNode boundCheck(iterator->source,
-                                  positiveUpdate ? op::add : op::sub,
+                                  op::add,
                                   *count,
                                   *updateInParen);
           binaryOpNode boundCheck2(iterator->source,
-                                   positiveUpdate ? op::sub : op::add,
+                                   op::sub,
                                    boundCheck,
                                    one);
           exprNode *boundCheckInParen = boundCheck2.wrapInParentheses();
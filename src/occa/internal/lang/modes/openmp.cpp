@@ -1,6 +1,7 @@
 #include <occa/internal/lang/modes/openmp.hpp>
-#include <occa/internal/lang/expr/expr.hpp>
+#include <occa/internal/lang/expr.hpp>
 #include <occa/internal/lang/builtins/attributes/atomic.hpp>
+#include <occa/internal/utils/string.hpp>
 
 namespace occa {
   namespace lang {
@@ -54,13 +55,101 @@ namespace occa {
           pragmaStatement *pragmaSmnt = (
             new pragmaStatement((blockStatement*) parent,
                                 pragmaToken(outerBlock.source->origin,
-                                            "omp parallel for"))
+                                            getOmpPragma(outerSmnt)))
           );
           parentBlock.addBefore(outerSmnt,
                                 *pragmaSmnt);
         }
       }
 
+      std::string openmpParser::getOmpPragma(statement_t &outerSmnt) {
+        std::string pragma = "omp parallel for";
+
+        const int collapse = getCollapseDepth(
+          outerSmnt,
+          settings.get("openmp/collapse", 1)
+        );
+        if (collapse > 1) {
+          pragma += " collapse(" + occa::toString(collapse) + ")";
+        }
+
+        const std::string schedule = settings.get<std::string>("openmp/schedule", "");
+        if (schedule.size()) {
+          pragma += " schedule(" + schedule;
+          const int chunk = settings.get("openmp/chunk", 0);
+          if (chunk > 0) {
+            pragma += ", " + occa::toString(chunk);
+          }
+          pragma += ")";
+        }
+
+        const std::string procBind = settings.get<std::string>("openmp/proc_bind", "");
+        if (procBind.size()) {
+          pragma += " proc_bind(" + procBind + ")";
+        }
+
+        const int threads = settings.get("openmp/threads", 0);
+        if (threads > 0) {
+          pragma += " num_threads(" + occa::toString(threads) + ")";
+        }
+
+        return pragma;
+      }
+
+      int openmpParser::getCollapseDepth(statement_t &outerSmnt,
+                                         const int maxDepth) {
+        // Only perfectly nested @outer loops with independent bounds can be collapsed
+        int depth = 1;
+        statement_t *smnt = &outerSmnt;
+        std::set<variable_t*> outerIterators;
+        while (depth < maxDepth) {
+          addLoopIterators((forStatement&) *smnt, outerIterators);
+
+          statementArray &children = ((blockStatement*) smnt)->children;
+          if ((children.length() != 1)
+              || !isOuterForLoop(children[0])
+              || loopHeaderUses((forStatement&) *children[0], outerIterators)) {
+            break;
+          }
+          smnt = children[0];
+          ++depth;
+        }
+        return depth;
+      }
+
+      void openmpParser::addLoopIterators(forStatement &forSmnt,
+                                          std::set<variable_t*> &iterators) {
+        if (!forSmnt.init
+            || !(forSmnt.init->type() & statementType::declaration)) {
+          return;
+        }
+        for (variableDeclaration &decl : ((declarationStatement*) forSmnt.init)->declarations) {
+          iterators.insert(&(decl.variable()));
+        }
+      }
+
+      bool openmpParser::loopHeaderUses(forStatement &forSmnt,
+                                        const std::set<variable_t*> &variables) {
+        statement_t *headerSmnts[3] = {forSmnt.init, forSmnt.check, forSmnt.update};
+        for (statement_t *headerSmnt : headerSmnts) {
+          if (!headerSmnt) {
+            continue;
+          }
+          bool usesVariable = false;
+          headerSmnt->getDirectExprNodes()
+            .flatFilterByExprType(exprNodeType::variable)
+            .forEach([&](smntExprNode smntExpr) {
+                usesVariable |= (bool) variables.count(
+                  &(((variableNode*) smntExpr.node)->value)
+                );
+              });
+          if (usesVariable) {
+            return true;
+          }
+        }
+        return false;
+      }
+
       bool openmpParser::isOuterForLoop(statement_t *smnt) {
         return (
           (smnt->type() & statementType::for_)
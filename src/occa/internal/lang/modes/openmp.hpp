@@ -1,6 +1,8 @@
 #ifndef OCCA_INTERNAL_LANG_MODES_OPENMP_HEADER
 #define OCCA_INTERNAL_LANG_MODES_OPENMP_HEADER
 
+#include <set>
+
 #include <occa/internal/lang/modes/serial.hpp>
 
 namespace occa {
@@ -14,8 +16,22 @@ namespace occa {
 
         void setupOmpPragmas();
 
+        // Builds the [omp parallel for] pragma from the [openmp/...] settings
+        std::string getOmpPragma(statement_t &outerSmnt);
+
+        // Number of perfectly nested @outer loops starting at [outerSmnt], up to [maxDepth]
+        int getCollapseDepth(statement_t &outerSmnt,
+                             const int maxDepth);
+
         bool isOuterForLoop(statement_t *smnt);
 
+        static void addLoopIterators(forStatement &forSmnt,
+                                     std::set<variable_t*> &iterators);
+
+        // Whether the init, check or update of [forSmnt] reads any of [variables]
+        static bool loopHeaderUses(forStatement &forSmnt,
+                                   const std::set<variable_t*> &variables);
+
         void setupAtomics();
 
         static bool transformBlockStatement(blockStatement &blockSmnt);
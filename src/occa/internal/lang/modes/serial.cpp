@@ -1,9 +1,14 @@
+#include <map>
 #include <set>
+#include <vector>
 
 #include <occa/internal/lang/modes/serial.hpp>
 #include <occa/internal/lang/modes/okl.hpp>
+#include <occa/internal/lang/modes/innerLoopFusion.hpp>
 #include <occa/internal/lang/builtins/types.hpp>
 #include <occa/internal/lang/expr.hpp>
+#include <occa/internal/io/output.hpp>
+#include <occa/internal/utils/string.hpp>
 
 namespace occa {
   namespace lang {
@@ -16,7 +21,9 @@ namespace occa {
         okl::addOklAttributes(*this);
       }
 
-      void serialParser::onClear() {}
+      void serialParser::onClear() {
+        vectorizationReport.clear();
+      }
 
       void serialParser::afterParsing() {
         if (!success) return;
@@ -27,8 +34,17 @@ namespace occa {
         if (!success) return;
         setupKernels();
 
+        // Fused loops can keep more @exclusive variables scalar
+        if (!success) return;
+        if (settings.get("okl/fuse_inner_loops", false)) {
+          fuseInnerLoops(root);
+        }
+
         if (!success) return;
         setupExclusives();
+
+        if (!success) return;
+        setupVectorization();
       }
 
       void serialParser::setupHeaders() {
@@ -65,6 +81,58 @@ namespace occa {
         if (!success) return;
 
         root.children.forEachKernelStatement(setupKernel);
+        if (settings.get("serial/static_functions", false)) {
+          setupHelperFunctions();
+        }
+      }
+
+      void serialParser::setupHelperFunctions() {
+        // Kernels are the only symbols loaded from the library, so giving helper
+        //   functions internal linkage lets the compiler inline them into kernels
+        // Prototypes need the same linkage as their definition
+        std::map<std::string, std::vector<statement_t*>> functionSmnts;
+        root.children
+            .filterByStatementType(statementType::function | statementType::functionDecl)
+            .forEach([&](statement_t *smnt) {
+                functionSmnts[getFunction(*smnt).name()].push_back(smnt);
+              });
+
+        for (auto &it : functionSmnts) {
+          std::vector<statement_t*> &smnts = it.second;
+
+          bool isDefined = false;
+          bool keepsLinkage = false;
+          for (statement_t *smnt : smnts) {
+            const qualifiers_t &qualifiers = getFunction(*smnt).returnType.qualifiers;
+            isDefined = isDefined || (smnt->type() & statementType::functionDecl);
+            keepsLinkage = (
+              keepsLinkage
+              || smnt->hasAttribute("kernel")
+              || qualifiers.has(extern_)
+              || qualifiers.has(externC)
+              || qualifiers.has(externCpp)
+            );
+          }
+          // Functions without a definition come from somewhere else
+          if (!isDefined || keepsLinkage) {
+            continue;
+          }
+
+          for (statement_t *smnt : smnts) {
+            qualifiers_t &qualifiers = getFunction(*smnt).returnType.qualifiers;
+            if (!qualifiers.has(static_)) {
+              qualifiers.addFirst(smnt->source->origin,
+                                  static_);
+            }
+          }
+        }
+      }
+
+      function_t& serialParser::getFunction(statement_t &smnt) {
+        if (smnt.type() & statementType::functionDecl) {
+          return ((functionDeclStatement&) smnt).function();
+        }
+        return ((functionStatement&) smnt).function();
       }
 
       void serialParser::setupKernel(functionDeclStatement &kernelSmnt) {
@@ -104,6 +172,10 @@ namespace occa {
       }
 
       void serialParser::setupExclusives() {
+        // Keep @exclusive variables scalar when possible
+        setupScalarExclusives();
+        if (!success) return;
+
         // Get @exclusive declarations
         bool hasExclusiveVariables = false;
         statementArray::from(root)
@@ -141,6 +213,132 @@ namespace occa {
           });
       }
 
+      void serialParser::setupScalarExclusives() {
+        // An @exclusive variable only used inside one inner-most @inner loop isn't
+        //   live across @inner loops (or barriers), so it can be declared as a local
+        //   variable in that loop rather than an array indexed by work-item
+        std::vector<declarationStatement*> declSmnts;
+        std::map<variable_t*, declarationStatement*> exclusiveDeclSmnts;
+        statementArray::from(root)
+          .nestedForEachDeclaration([&](variableDeclaration &decl, declarationStatement &declSmnt) {
+            variable_t &var = decl.variable();
+            if (!var.hasAttribute("exclusive")
+                || (declSmnt.declarations.size() != 1)) {
+              return;
+            }
+            // Moving a non-constant initializer would change when it is evaluated
+            if (decl.hasValue() && !decl.value->canEvaluate()) {
+              return;
+            }
+            declSmnts.push_back(&declSmnt);
+            exclusiveDeclSmnts[&var] = &declSmnt;
+          });
+
+        if (!declSmnts.size()) {
+          return;
+        }
+
+        std::map<declarationStatement*, std::vector<statement_t*>> useSmnts;
+        statementArray::from(root)
+          .flatFilterByExprType(exprNodeType::variable, "exclusive")
+          .forEach([&](smntExprNode smntExpr) {
+            variable_t &var = ((variableNode*) smntExpr.node)->value;
+
+            auto it = exclusiveDeclSmnts.find(&var);
+            if ((it != exclusiveDeclSmnts.end())
+                && (smntExpr.smnt != it->second)) {
+              useSmnts[it->second].push_back(smntExpr.smnt);
+            }
+          });
+
+        for (declarationStatement *declSmnt : declSmnts) {
+          forStatement *innerSmnt = getScalarExclusiveLoop(*declSmnt,
+                                                           useSmnts[declSmnt]);
+          if (!innerSmnt) {
+            continue;
+          }
+
+          variable_t &var = declSmnt->declarations[0].variable();
+          const std::string name = var.name();
+          if (innerSmnt->hasDirectlyInScope(name)) {
+            continue;
+          }
+
+          // Move the declaration and its scope keyword into the @inner loop
+          blockStatement &parent = *(declSmnt->up);
+          parent.remove(*declSmnt);
+          parent.removeFromScope(name, false);
+
+          innerSmnt->addFirst(*declSmnt);
+          innerSmnt->addToScope(var);
+
+          var.attributes.erase("exclusive");
+          declSmnt->attributes.erase("exclusive");
+        }
+      }
+
+      statement_t* serialParser::getUseScope(statement_t &smnt) {
+        // Loop headers run outside of the loop iterations
+        statement_t *up = smnt.up;
+        if (up && (up->type() & statementType::for_)) {
+          forStatement &forSmnt = (forStatement&) *up;
+          if ((&smnt == forSmnt.init)
+              || (&smnt == forSmnt.check)
+              || (&smnt == forSmnt.update)) {
+            return forSmnt.up;
+          }
+        }
+        return up;
+      }
+
+      forStatement* serialParser::getScalarExclusiveLoop(declarationStatement &declSmnt,
+                                                         const std::vector<statement_t*> &useSmnts) {
+        if (!useSmnts.size()) {
+          return NULL;
+        }
+
+        // Find the @inner loop holding the first use
+        statement_t *innerSmnt = getUseScope(*useSmnts[0]);
+        while (innerSmnt && !innerSmnt->hasAttribute("inner")) {
+          innerSmnt = innerSmnt->up;
+        }
+        if (!innerSmnt) {
+          return NULL;
+        }
+
+        for (statement_t *useSmnt : useSmnts) {
+          statement_t *smnt = getUseScope(*useSmnt);
+          while (smnt && (smnt != innerSmnt)) {
+            smnt = smnt->up;
+          }
+          if (!smnt) {
+            return NULL;
+          }
+        }
+
+        // Values carried across nested @inner loops need the per-work-item arrays
+        const statementArray nestedInnerSmnts = (
+          statementArray::from(*innerSmnt)
+          .flatFilterByStatementType(statementType::for_, "inner")
+        );
+        if (nestedInnerSmnts.length() > 1) {
+          return NULL;
+        }
+
+        // Values carried across iterations of a regular loop also need the arrays
+        for (statement_t *smnt = innerSmnt->up; smnt != declSmnt.up; smnt = smnt->up) {
+          if (!smnt) {
+            return NULL;
+          }
+          if ((smnt->type() & (statementType::for_ | statementType::while_))
+              && !smnt->hasAttribute("inner")) {
+            return NULL;
+          }
+        }
+
+        return (forStatement*) innerSmnt;
+      }
+
       void serialParser::setupExclusiveDeclaration(declarationStatement &declSmnt) {
         // Find inner-most outer loop
         statement_t *smnt = declSmnt.up;
@@ -301,6 +499,126 @@ namespace occa {
                                  expr,
                                  indexVarNode);
       }
+
+      void serialParser::setupVectorization() {
+        const bool vectorize = settings.get("serial/vectorize", false);
+        const int alignment = settings.get("serial/assume_aligned", 0);
+        if (!vectorize && !alignment) {
+          return;
+        }
+
+        root.children.forEachKernelStatement([&](functionDeclStatement &kernelSmnt) {
+          if (!success) return;
+          if (alignment) {
+            addAlignmentHints(kernelSmnt, alignment);
+          }
+          if (vectorize) {
+            addSimdPragmas(kernelSmnt);
+          }
+        });
+
+        if (settings.get("verbose", false)) {
+          for (const std::string &line : vectorizationReport) {
+            io::stdout << line << '\n';
+          }
+        }
+      }
+
+      void serialParser::addAlignmentHints(functionDeclStatement &kernelSmnt,
+                                           const int alignment) {
+        if ((alignment < 0) || (alignment & (alignment - 1))) {
+          kernelSmnt.printError("[serial/assume_aligned] must be a power of 2, found ["
+                                + occa::toString(alignment) + "]");
+          success = false;
+          return;
+        }
+
+#if OCCA_OS != OCCA_WINDOWS_OS
+        // Only @restrict pointers are hinted since the caller already promises
+        //   they are unique views into their buffers
+        function_t &func = kernelSmnt.function();
+        for (int i = (int) func.args.size() - 1; i >= 0; --i) {
+          variable_t &arg = *(func.args[i]);
+          vartype_t &type = arg.vartype;
+          if (!arg.hasAttribute("restrict")
+              || !type.pointers.size()
+              || type.pointers.back().has(const_)) {
+            continue;
+          }
+          const std::string &name = arg.name();
+          kernelSmnt.addFirst(
+            *(new sourceCodeStatement(
+                &kernelSmnt,
+                kernelSmnt.source,
+                name + " = (decltype(" + name + ")) __builtin_assume_aligned("
+                + name + ", " + occa::toString(alignment) + ");"
+              ))
+          );
+        }
+#endif
+      }
+
+      void serialParser::addSimdPragmas(functionDeclStatement &kernelSmnt) {
+        const std::string &kernelName = kernelSmnt.function().name();
+
+        // @inner iterations are independent work-items, so the inner-most loops
+        //   can be vectorized unless they synchronize or leave the loop early
+        statementArray::from(kernelSmnt)
+          .flatFilterByStatementType(statementType::for_, "inner")
+          .forEach([&](statement_t *smnt) {
+            forStatement &forSmnt = (forStatement&) *smnt;
+
+            // Skip @inner loops with nested @inner loops
+            const statementArray innerSmnts = (
+              statementArray::from(forSmnt)
+              .flatFilterByStatementType(statementType::for_, "inner")
+            );
+            if (innerSmnts.length() > 1) {
+              return;
+            }
+
+            const fileOrigin &origin = forSmnt.source->origin;
+            std::string entry = (
+              (origin.file ? origin.file->filename : std::string("(source)"))
+              + ":" + occa::toString(origin.position.line)
+              + " " + kernelName + ": @inner loop "
+            );
+
+            const std::string blocker = getSimdBlocker(forSmnt);
+            if (blocker.size()) {
+              vectorizationReport.push_back(entry + "not vectorized (" + blocker + ")");
+              return;
+            }
+
+            forSmnt.up->addBefore(
+              forSmnt,
+              *(new pragmaStatement(forSmnt.up,
+                                    pragmaToken(origin, "omp simd")))
+            );
+            vectorizationReport.push_back(entry + "vectorized");
+          });
+      }
+
+      std::string serialParser::getSimdBlocker(forStatement &forSmnt) {
+        // Exclusive variables are indexed through a shared counter
+        if (forSmnt.hasInScope(exclusiveIndexName)) {
+          return "uses @exclusive variables";
+        }
+
+        statementArray smnts = statementArray::from(forSmnt);
+        if (smnts.flatFilterByAttribute("atomic").length()) {
+          return "uses @atomic";
+        }
+        if (smnts.flatFilterByAttribute("barrier").length()) {
+          return "uses @barrier";
+        }
+        if (smnts.flatFilterByStatementType(statementType::break_
+                                            | statementType::return_
+                                            | statementType::goto_).length()) {
+          return "has break, return or goto statements";
+        }
+        return "";
+      }
     }
   }
 }
@@ -10,6 +10,11 @@ namespace occa {
        public:
         static const std::string exclusiveIndexName;
 
+        // One line per @inner loop considered by [serial/vectorize]:
+        //   "<file>:<line> <kernel>: @inner loop vectorized"
+        //   "<file>:<line> <kernel>: @inner loop not vectorized (<reason>)"
+        strVector vectorizationReport;
+
         serialParser(const occa::json &settings_ = occa::json());
 
         virtual void onClear();
@@ -22,7 +27,16 @@ namespace occa {
 
         static void setupKernel(functionDeclStatement &kernelSmnt);
 
+        // serial/static_functions: Give non-kernel functions internal linkage
+        void setupHelperFunctions();
+
+        static function_t& getFunction(statement_t &smnt);
+
         void setupExclusives();
+        void setupScalarExclusives();
+        static statement_t* getUseScope(statement_t &smnt);
+        static forStatement* getScalarExclusiveLoop(declarationStatement &declSmnt,
+                                                    const std::vector<statement_t*> &useSmnts);
         void setupExclusiveDeclaration(declarationStatement &declSmnt);
         void setupExclusiveIndices();
 
@@ -31,6 +45,16 @@ namespace occa {
         exprNode* addExclusiveVariableArrayAccessor(statement_t &smnt,
                                                     exprNode &expr,
                                                     variable_t &var);
+
+        // Opt-in hints for the host compiler's auto-vectorizer:
+        //   serial/vectorize:      [#pragma omp simd] on inner-most @inner loops
+        //   serial/assume_aligned: Alignment in bytes of @restrict pointer arguments
+        void setupVectorization();
+        void addAlignmentHints(functionDeclStatement &kernelSmnt,
+                               const int alignment);
+        void addSimdPragmas(functionDeclStatement &kernelSmnt);
+
+        static std::string getSimdBlocker(forStatement &forSmnt);
       };
     }
   }
@@ -0,0 +1,258 @@
+#include <occa/internal/lang/modes/threads.hpp>
+#include <occa/internal/lang/modes/oklForStatement.hpp>
+#include <occa/internal/lang/builtins/attributes/atomic.hpp>
+#include <occa/internal/lang/builtins/types.hpp>
+#include <occa/internal/lang/expr.hpp>
+
+namespace occa {
+  namespace lang {
+    namespace okl {
+      const std::string threadsParser::taskArgName = "_occa_task";
+
+      // Matches the layout of threads::workerTask_t
+      static const std::string threadsHeader = (
+        "struct occaThreadsTask_t {\n"
+        "  int (*claim)(occaThreadsTask_t *task, int loopCount, int *begin, int *end);\n"
+        "};\n"
+        "\n"
+        "static inline int occaThreadsClaim(void *task, int loopCount, int *begin, int *end) {\n"
+        "  occaThreadsTask_t *task_ = (occaThreadsTask_t*) task;\n"
+        "  return task_->claim(task_, loopCount, begin, end);\n"
+        "}\n"
+        "\n"
+        "static std::mutex occaThreadsAtomicMutex;\n"
+        "\n"
+        // Basic @atomic updates: integers use __atomic builtins, float and double
+        //   use a compare-and-swap loop and anything else locks the mutex
+        "template <class T>\n"
+        "struct occaThreadsAtomicKind {\n"
+        "  enum {\n"
+        "    builtin = std::is_integral<T>::value && !std::is_same<T, bool>::value,\n"
+        "    cas = std::is_floating_point<T>::value && (sizeof(T) <= sizeof(double))\n"
+        "  };\n"
+        "};\n"
+        "\n"
+        "template <class T, class V>\n"
+        "static inline typename std::enable_if<occaThreadsAtomicKind<T>::builtin>::type\n"
+        "occaThreadsAtomicAdd(T &value, const V &update, const bool subtract) {\n"
+        "  if (subtract) {\n"
+        "    __atomic_fetch_sub(&value, (T) update, __ATOMIC_RELAXED);\n"
+        "  } else {\n"
+        "    __atomic_fetch_add(&value, (T) update, __ATOMIC_RELAXED);\n"
+        "  }\n"
+        "}\n"
+        "\n"
+        "template <class T, class V>\n"
+        "static inline typename std::enable_if<occaThreadsAtomicKind<T>::cas>::type\n"
+        "occaThreadsAtomicAdd(T &value, const V &update, const bool subtract) {\n"
+        "  T expected, desired;\n"
+        "  __atomic_load(&value, &expected, __ATOMIC_RELAXED);\n"
+        "  do {\n"
+        "    desired = subtract ? (T) (expected - update) : (T) (expected + update);\n"
+        "  } while (!__atomic_compare_exchange(&value, &expected, &desired, true,\n"
+        "                                      __ATOMIC_RELAXED, __ATOMIC_RELAXED));\n"
+        "}\n"
+        "\n"
+        "template <class T, class V>\n"
+        "static inline typename std::enable_if<!occaThreadsAtomicKind<T>::builtin\n"
+        "                                      && !occaThreadsAtomicKind<T>::cas>::type\n"
+        "occaThreadsAtomicAdd(T &value, const V &update, const bool subtract) {\n"
+        "  std::lock_guard<std::mutex> lock(occaThreadsAtomicMutex);\n"
+        "  if (subtract) {\n"
+        "    value -= update;\n"
+        "  } else {\n"
+        "    value += update;\n"
+        "  }\n"
+        "}"
+      );
+
+      threadsParser::threadsParser(const occa::json &settings_) :
+        serialParser(settings_) {}
+
+      void threadsParser::afterParsing() {
+        serialParser::afterParsing();
+
+        if (!success) return;
+        setupThreadsHeader();
+
+        if (!success) return;
+        setupKernelTasks();
+
+        if (!success) return;
+        setupAtomics();
+      }
+
+      void threadsParser::setupThreadsHeader() {
+        root.addFirst(
+          *(new sourceCodeStatement(&root, root.source, threadsHeader))
+        );
+
+        directiveToken mutexToken(root.source->origin,
+                                  "include <mutex>");
+        root.addFirst(
+          *(new directiveStatement(&root, mutexToken))
+        );
+
+        directiveToken typeTraitsToken(root.source->origin,
+                                       "include <type_traits>");
+        root.addFirst(
+          *(new directiveStatement(&root, typeTraitsToken))
+        );
+      }
+
+      void threadsParser::setupKernelTasks() {
+        root.children
+          .forEachKernelStatement([&](functionDeclStatement &kernelSmnt) {
+            // Add the worker task as the last argument
+            variable_t taskArg(void_, taskArgName);
+            taskArg += pointer_t();
+
+            attribute_t &implicitArgAttr = *(getAttribute("implicitArg"));
+            attributeToken_t taskAttr(implicitArgAttr, *(taskArg.source));
+            taskArg.addAttribute(taskAttr);
+
+            kernelSmnt.function().addArgument(taskArg);
+
+            statementArray::from(kernelSmnt)
+              .flatFilterByAttribute("outer")
+              .filterByStatementType(statementType::for_)
+              .filter([&](statement_t *smnt) {
+                return isOuterMostOuterLoop((forStatement&) *smnt);
+              })
+              .forEach([&](statement_t *smnt) {
+                if (success) {
+                  setupOuterLoop((forStatement&) *smnt);
+                }
+              });
+          });
+      }
+
+      void threadsParser::setupOuterLoop(forStatement &forSmnt) {
+        oklForStatement oklForSmnt(forSmnt);
+        if (!oklForSmnt.isValid()) {
+          success = false;
+          return;
+        }
+
+        token_t *source = forSmnt.source;
+
+        // Loop over the claimed iterations and recover the original iterator
+        identifierToken indexSource(oklForSmnt.iterator->source->origin,
+                                    "_occa_outer_index");
+        identifierNode indexNode(&indexSource,
+                                 "_occa_outer_index");
+
+        exprNode *loopCount = oklForSmnt.getIterationCount();
+        const std::string loopCountSource = loopCount->toString();
+        delete loopCount;
+
+        variableDeclaration decl(
+          *oklForSmnt.iterator,
+          oklForSmnt.makeDeclarationValue(indexNode)
+        );
+
+        delete forSmnt.init;
+        delete forSmnt.check;
+        delete forSmnt.update;
+        forSmnt.setLoopStatements(
+          new sourceCodeStatement(&forSmnt, source,
+                                  "int _occa_outer_index = _occa_outer_begin;"),
+          new sourceCodeStatement(&forSmnt, source,
+                                  "_occa_outer_index < _occa_outer_end;"),
+          new sourceCodeStatement(&forSmnt, source,
+                                  "++_occa_outer_index")
+        );
+
+        declarationStatement &declSmnt = (
+          *(new declarationStatement(&forSmnt, source))
+        );
+        declSmnt.declarations.push_back(decl);
+        forSmnt.addFirst(declSmnt);
+
+        // Claim chunks of iterations until the loop is done
+        blockStatement &parent = *(forSmnt.up);
+        blockStatement &loopBlock = *(new blockStatement(&parent, source));
+        forSmnt.replaceWith(loopBlock);
+
+        whileStatement &whileSmnt = *(new whileStatement(&loopBlock, source));
+        whileSmnt.setCondition(
+          new sourceCodeStatement(
+            &whileSmnt, source,
+            "occaThreadsClaim(" + taskArgName + ", "
+            + loopCountSource
+            + ", &_occa_outer_begin, &_occa_outer_end)"
+          )
+        );
+
+        loopBlock.add(
+          *(new sourceCodeStatement(&loopBlock, source,
+                                    "int _occa_outer_begin, _occa_outer_end;"))
+        );
+        loopBlock.add(whileSmnt);
+        whileSmnt.add(forSmnt);
+      }
+
+      bool threadsParser::isOuterMostOuterLoop(forStatement &forSmnt) {
+        for (auto &parentSmnt : forSmnt.getParentPath()) {
+          if ((parentSmnt->type() & statementType::for_)
+              && parentSmnt->hasAttribute("outer")) {
+            return false;
+          }
+        }
+        return true;
+      }
+
+      void threadsParser::setupAtomics() {
+        success &= attributes::atomic::applyCodeTransformation(
+          root,
+          transformBlockStatement,
+          transformBasicExpressionStatement
+        );
+      }
+
+      bool threadsParser::transformBlockStatement(blockStatement &blockSmnt) {
+        blockSmnt.addFirst(
+          *(new sourceCodeStatement(
+              &blockSmnt, blockSmnt.source,
+              "std::lock_guard<std::mutex> _occa_atomic_lock(occaThreadsAtomicMutex);"
+            ))
+        );
+        return true;
+      }
+
+      bool threadsParser::transformBasicExpressionStatement(expressionStatement &exprSmnt) {
+        const opType_t &opType = expr(exprSmnt.expr).opType();
+
+        // Cases:
+        //   @atomic ++i;  @atomic i++;  @atomic i += 1;
+        //   @atomic --i;  @atomic i--;  @atomic i -= 1;
+        printer pout;
+        pout << "occaThreadsAtomicAdd(";
+        if (opType & operatorType::leftUnary) {
+          pout << expr(((leftUnaryOpNode*) exprSmnt.expr)->value) << ", 1";
+        } else if (opType & operatorType::rightUnary) {
+          pout << expr(((rightUnaryOpNode*) exprSmnt.expr)->value) << ", 1";
+        } else {
+          binaryOpNode &binaryNode = (binaryOpNode&) *exprSmnt.expr;
+          pout << expr(binaryNode.leftValue) << ", " << expr(binaryNode.rightValue);
+        }
+
+        const bool subtract = opType & (operatorType::decrement | operatorType::subEq);
+        pout << ", " << (subtract ? "true" : "false") << ");";
+
+        statement_t &atomicSmnt = (
+          *(new sourceCodeStatement(
+              exprSmnt.up,
+              exprSmnt.source,
+              pout.str()
+            ))
+        );
+
+        exprSmnt.replaceWith(atomicSmnt);
+        delete &exprSmnt;
+
+        return true;
+      }
+    }
+  }
+}
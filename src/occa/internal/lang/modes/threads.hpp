@@ -0,0 +1,51 @@
+#ifndef OCCA_INTERNAL_LANG_MODES_THREADS_HEADER
+#define OCCA_INTERNAL_LANG_MODES_THREADS_HEADER
+
+#include <occa/internal/lang/modes/serial.hpp>
+
+namespace occa {
+  namespace lang {
+    namespace okl {
+      // Every worker thread runs the whole kernel and the outer-most @outer loops
+      //   are split into chunks of iterations claimed through the [_occa_task] argument:
+      //
+      //   for (int i = 0; i < N; ++i; @outer) {...}
+      //
+      //   ->
+      //
+      //   {
+      //     int _occa_outer_begin, _occa_outer_end;
+      //     while (occaThreadsClaim(_occa_task, N - 0, &_occa_outer_begin, &_occa_outer_end)) {
+      //       for (int _occa_outer_index = _occa_outer_begin; ...; ++_occa_outer_index) {
+      //         int i = 0 + _occa_outer_index;
+      //         ...
+      //       }
+      //     }
+      //   }
+      class threadsParser : public serialParser {
+       public:
+        static const std::string taskArgName;
+
+        threadsParser(const occa::json &settings_ = occa::json());
+
+        virtual void afterParsing();
+
+        void setupThreadsHeader();
+
+        void setupKernelTasks();
+
+        void setupOuterLoop(forStatement &forSmnt);
+
+        static bool isOuterMostOuterLoop(forStatement &forSmnt);
+
+        void setupAtomics();
+
+        static bool transformBlockStatement(blockStatement &blockSmnt);
+
+        static bool transformBasicExpressionStatement(expressionStatement &exprSmnt);
+      };
+    }
+  }
+}
+
+#endif
@@ -1,3 +1,6 @@
+#include <map>
+
+#include <occa/utils/hash.hpp>
 #include <occa/internal/utils/lex.hpp>
 #include <occa/internal/utils/string.hpp>
 #include <occa/internal/lang/tokenizer.hpp>
@@ -5,6 +8,92 @@
 
 namespace occa {
   namespace lang {
+    //---[ Header Cache ]---------------
+    class cachedHeader_t {
+    public:
+      hash_t hash;
+      bool isCacheable;
+      tokenVector tokens;
+
+      cachedHeader_t(const hash_t &hash_) :
+        hash(hash_),
+        isCacheable(false) {}
+
+      ~cachedHeader_t() {
+        freeTokenVector(tokens);
+      }
+    };
+
+    class cachedHeaderMap_t {
+    public:
+      std::map<std::string, cachedHeader_t*> headers;
+
+      ~cachedHeaderMap_t() {
+        clear();
+      }
+
+      void clear() {
+        std::map<std::string, cachedHeader_t*>::iterator it = headers.begin();
+        while (it != headers.end()) {
+          delete it->second;
+          ++it;
+        }
+        headers.clear();
+      }
+    };
+
+    // Tokens share ref-counted file origins, so caches aren't shared across threads
+    static cachedHeaderMap_t& cachedHeaders() {
+      static thread_local cachedHeaderMap_t headers;
+      return headers;
+    }
+
+    // #include and #line read the raw source through the tokenizer
+    //   so headers using them can't be replayed from tokens
+    static bool hasSourceDirective(const tokenVector &tokens) {
+      const int tokenCount = (int) tokens.size();
+      for (int i = 0; i < (tokenCount - 1); ++i) {
+        if (!(tokens[i]->getOpType() & operatorType::hash)
+            || !(tokens[i + 1]->type() & tokenType::identifier)) {
+          continue;
+        }
+        const std::string &directive = tokens[i + 1]->to<identifierToken>().value;
+        if ((directive == "include") || (directive == "line")) {
+          return true;
+        }
+      }
+      return false;
+    }
+
+    static cachedHeader_t& getCachedHeader(const std::string &filename) {
+      const hash_t fileHash = hashFile(filename);
+
+      cachedHeader_t *&header = cachedHeaders().headers[filename];
+      if (header && (header->hash == fileHash)) {
+        return *header;
+      }
+      delete header;
+      header = new cachedHeader_t(fileHash);
+
+      tokenizer_t tstream(fileOrigin(*(new file_t(filename))));
+      token_t *token;
+      while (!tstream.isEmpty()) {
+        tstream.setNext(token);
+        header->tokens.push_back(token);
+      }
+
+      header->isCacheable = (
+        !tstream.errors
+        && !hasSourceDirective(header->tokens)
+      );
+      if (!header->isCacheable) {
+        freeTokenVector(header->tokens);
+      }
+
+      return *header;
+    }
+    //==================================
+
     int getEncodingType(const std::string &str) {
       int encoding      = 0;
       int encodingCount = 0;
@@ -221,13 +310,64 @@ namespace occa {
         outputCache.clear();
       }
 
-      // TODO: Use a fileCache
+      if (pushCachedSource(filename)) {
+        return;
+      }
+
       file_t *file = new file_t(filename);
       origin.push(true,
                   *file,
                   file->content.c_str());
     }
 
+    bool tokenizer_t::pushCachedSource(const std::string &filename) {
+      cachedHeader_t &header = getCachedHeader(filename);
+      if (!header.isCacheable) {
+        return false;
+      }
+
+      // Point the header tokens back to the #include
+      fileOrigin *includeOrigin = new fileOrigin(origin);
+      includeOrigin->addRef();
+      includeOrigin->fromInclude = true;
+
+      const int tokenCount = (int) header.tokens.size();
+      for (int i = 0; i < tokenCount; ++i) {
+        token_t *token = header.tokens[i]->clone();
+        token->origin.setUp(includeOrigin);
+        outputCache.push_back(token);
+
+        const int type = token->type();
+        if (type != tokenType::newline) {
+          lastNonNewlineTokenType = type;
+        }
+      }
+      // Finishing a source outputs a newline
+      push();
+      outputCache.push_back(new newlineToken(popTokenOrigin()));
+      lastTokenType = tokenType::newline;
+
+      if (!includeOrigin->removeRef()) {
+        delete includeOrigin;
+      }
+      return true;
+    }
+
+    int tokenizer_t::cachedHeaderCount() {
+      int count = 0;
+      std::map<std::string, cachedHeader_t*> &headers = cachedHeaders().headers;
+      std::map<std::string, cachedHeader_t*>::iterator it = headers.begin();
+      while (it != headers.end()) {
+        count += it->second->isCacheable;
+        ++it;
+      }
+      return count;
+    }
+
+    void tokenizer_t::clearHeaderCache() {
+      cachedHeaders().clear();
+    }
+
     void tokenizer_t::popSource() {
       OCCA_ERROR("Unable to call tokenizer_t::popSource",
                  origin.up);
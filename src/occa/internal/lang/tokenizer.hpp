@@ -76,6 +76,12 @@ namespace occa {
       void pushSource(const std::string &filename);
       void popSource();
 
+      // Included headers are lexed once per thread and their tokens reused
+      //   while the header's contents are unchanged
+      bool pushCachedSource(const std::string &filename);
+      static int cachedHeaderCount();
+      static void clearHeaderCache();
+
       void push();
       void pop(const bool rewind = false);
       void popAndRewind();
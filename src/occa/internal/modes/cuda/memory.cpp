@@ -37,6 +37,11 @@ namespace occa {
       return (void*) &cuPtr;
     }
 
+    primitive memory::getKernelArgAtOffset(const udim_t offset) const {
+      // Kernel arguments hold the address of the CUdeviceptr, so store it by value
+      return (uint64_t) (cuPtr + offset);
+    }
+
     modeMemory_t* memory::addOffset(const dim_t offset) {
       memory *m = new memory(modeDevice,
                              size - offset,
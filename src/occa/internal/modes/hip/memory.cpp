@@ -38,6 +38,10 @@ namespace occa {
       return (void*) hipPtr;
     }
 
+    primitive memory::getKernelArgAtOffset(const udim_t offset) const {
+      return (void*) addHipPtrOffset(hipPtr, offset);
+    }
+
     modeMemory_t* memory::addOffset(const dim_t offset) {
       memory *m = new memory(modeDevice,
                              size - offset,
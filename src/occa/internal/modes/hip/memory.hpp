@@ -29,6 +29,8 @@ namespace occa {
 
       void* getKernelArgPtr() const;
 
+      primitive getKernelArgAtOffset(const udim_t offset) const;
+
       modeMemory_t* addOffset(const dim_t offset);
 
       void* getPtr();
@@ -8,7 +8,15 @@
 namespace occa {
   namespace openmp {
     device::device(const occa::json &properties_) :
-      serial::device(properties_) {}
+      serial::device(properties_) {
+      // Device [openmp/...] properties are the defaults for every kernel
+      if (properties.has("openmp")) {
+        properties["kernel/openmp"] = (
+          properties["openmp"]
+          + properties["kernel/openmp"]
+        );
+      }
+    }
 
     hash_t device::hash() const {
       return (
@@ -18,10 +26,15 @@ namespace occa {
     }
 
     hash_t device::kernelHash(const occa::json &props) const {
-      return (
+      hash_t kernelHash_ = (
         serial::device::kernelHash(props)
         ^ occa::hash("openmp")
       );
+      // The [openmp/...] properties change the generated pragmas
+      if (props.has("openmp")) {
+        kernelHash_ ^= occa::hash(props["openmp"]);
+      }
+      return kernelHash_;
     }
 
     bool device::parseFile(const std::string &filename,
@@ -52,12 +65,10 @@ namespace occa {
       return true;
     }
 
-    modeKernel_t* device::buildKernel(const std::string &filename,
-                                      const std::string &kernelName,
-                                      const hash_t kernelHash,
-                                      const occa::json &kernelProps) {
-
-      occa::json allKernelProps = properties + kernelProps;
+    bool device::setupOpenMPProps(const occa::json &kernelProps,
+                                  occa::json &allKernelProps) {
+      allKernelProps = properties + kernelProps;
+      validateKernelProps(allKernelProps);
 
       std::string compiler = allKernelProps["compiler"];
       int vendor = allKernelProps["vendor"];
@@ -80,6 +91,15 @@ namespace occa {
       if (usingOpenMP) {
         allKernelProps["compiler_flags"] += " " + lastCompilerOpenMPFlag;
       }
+      return usingOpenMP;
+    }
+
+    modeKernel_t* device::buildKernel(const std::string &filename,
+                                      const std::string &kernelName,
+                                      const hash_t kernelHash,
+                                      const occa::json &kernelProps) {
+      occa::json allKernelProps;
+      const bool usingOpenMP = setupOpenMPProps(kernelProps, allKernelProps);
 
       modeKernel_t *k = serial::device::buildKernel(filename,
                                                     kernelName,
@@ -94,5 +114,27 @@ namespace occa {
 
       return k;
     }
+
+    void device::buildKernels(kernelBuildVector &builds) {
+      // Builds can use different compilers, so each one keeps its own flag
+      std::vector<bool> usingOpenMP;
+      for (kernelBuild_t *build : builds) {
+        occa::json allKernelProps;
+        usingOpenMP.push_back(setupOpenMPProps(build->kernelProps, allKernelProps));
+        build->kernelProps = allKernelProps;
+      }
+
+      serial::device::buildKernels(builds);
+
+      const int buildCount = (int) builds.size();
+      for (int i = 0; i < buildCount; ++i) {
+        modeKernel_t *k = builds[i]->modeKernel;
+        if (k && usingOpenMP[i]) {
+          k->modeDevice->removeKernelRef(k);
+          k->modeDevice = this;
+          addKernelRef(k);
+        }
+      }
+    }
   }
 }
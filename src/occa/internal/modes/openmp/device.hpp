@@ -12,6 +12,11 @@ namespace occa {
       std::string lastCompiler;
       std::string lastCompilerOpenMPFlag;
 
+      // Adds the OpenMP compiler flag to [allKernelProps]
+      //   and returns whether the compiler supports OpenMP
+      bool setupOpenMPProps(const occa::json &kernelProps,
+                            occa::json &allKernelProps);
+
     public:
       device(const occa::json &properties_);
 
@@ -28,6 +33,8 @@ namespace occa {
                                         const std::string &kernelName,
                                         const hash_t kernelHash,
                                         const occa::json &kernelProps);
+
+      virtual void buildKernels(kernelBuildVector &builds);
     };
   }
 }
@@ -3,6 +3,7 @@
 #include <occa/internal/utils/env.hpp>
 #include <occa/internal/io.hpp>
 #include <occa/internal/utils/sys.hpp>
+#include <occa/internal/utils/compilerDriver.hpp>
 
 namespace occa {
   namespace openmp {
@@ -54,16 +55,19 @@ namespace occa {
         // Try to compile a minimal OpenMP file to see whether
         // the compiler supports OpenMP or not
         std::string flag = baseCompilerFlag(vendor_);
-        ss << compiler
-           << ' '    << flag
-           << ' '    << srcFilename
-           << " -o " << binaryFilename
-           << " > /dev/null 2>&1";
 
-        const std::string compileLine = ss.str();
-        const int compileError = system(compileLine.c_str());
+        strVector command = sys::splitCommandLine(compiler);
+        if (flag.size()) {
+          command.push_back(flag);
+        }
+        command.push_back(srcFilename);
+        command.push_back("-o");
+        command.push_back(binaryFilename);
+
+        sys::compileJob_t compileJob(command);
+        sys::compilerDriver().run(compileJob);
 
-        if (compileError) {
+        if (!compileJob.succeeded()) {
           flag = openmp::notSupported;
         }
 
@@ -81,5 +85,43 @@ namespace occa {
       return "/openmp"; // VS Compilers support OpenMP
 #endif
     }
+
+    void validateKernelProps(const occa::json &props) {
+      if (!props.has("openmp")) {
+        return;
+      }
+
+      const int threads = props.get("openmp/threads", 1);
+      OCCA_ERROR("[openmp/threads] must be positive, found [" << threads << "]",
+                 threads > 0);
+
+      const int collapse = props.get("openmp/collapse", 1);
+      OCCA_ERROR("[openmp/collapse] must be positive, found [" << collapse << "]",
+                 collapse > 0);
+
+      const std::string schedule = props.get<std::string>("openmp/schedule", "static");
+      OCCA_ERROR("[openmp/schedule] must be one of [static, dynamic, guided, auto, runtime],"
+                 " found [" << schedule << "]",
+                 (schedule == "static")
+                 || (schedule == "dynamic")
+                 || (schedule == "guided")
+                 || (schedule == "auto")
+                 || (schedule == "runtime"));
+
+      const int chunk = props.get("openmp/chunk", 1);
+      OCCA_ERROR("[openmp/chunk] must be positive, found [" << chunk << "]",
+                 chunk > 0);
+      OCCA_ERROR("[openmp/chunk] requires a [static], [dynamic] or [guided] schedule",
+                 !props.has("openmp/chunk")
+                 || ((schedule != "auto") && (schedule != "runtime")));
+
+      const std::string procBind = props.get<std::string>("openmp/proc_bind", "close");
+      OCCA_ERROR("[openmp/proc_bind] must be one of [close, spread, primary, master],"
+                 " found [" << procBind << "]",
+                 (procBind == "close")
+                 || (procBind == "spread")
+                 || (procBind == "primary")
+                 || (procBind == "master"));
+    }
   }
 }
@@ -3,6 +3,8 @@
 #ifndef OCCA_INTERNAL_MODES_OPENMP_UTILS_HEADER
 #define OCCA_INTERNAL_MODES_OPENMP_UTILS_HEADER
 
+#include <occa/types/json.hpp>
+
 namespace occa {
   namespace openmp {
     extern std::string notSupported;
@@ -10,6 +12,10 @@ namespace occa {
     std::string baseCompilerFlag(const int vendor_);
     std::string compilerFlag(const int vendor_,
                              const std::string &compiler);
+
+    // Checks the [openmp/...] properties used to build the [omp parallel for] clauses:
+    //   threads, schedule, chunk, proc_bind and collapse
+    void validateKernelProps(const occa::json &props);
   }
 }
 
@@ -1,22 +1,62 @@
+#include <algorithm>
+#include <map>
+
 #include <occa/core/base.hpp>
 #include <occa/internal/utils/env.hpp>
 #include <occa/internal/io.hpp>
+#include <occa/utils/exception.hpp>
 #include <occa/internal/utils/sys.hpp>
+#include <occa/internal/utils/topology.hpp>
+#include <occa/internal/utils/compilerDriver.hpp>
 #include <occa/internal/modes/serial/device.hpp>
 #include <occa/internal/modes/serial/kernel.hpp>
 #include <occa/internal/modes/serial/memory.hpp>
+#include <occa/internal/modes/serial/memoryPlacement.hpp>
 #include <occa/internal/modes/serial/stream.hpp>
 #include <occa/internal/modes/serial/streamTag.hpp>
 #include <occa/internal/lang/modes/serial.hpp>
 
 namespace occa {
   namespace serial {
+    kernelCompile_t::kernelCompile_t(const std::string &filename_,
+                                     const std::string &kernelName_,
+                                     const hash_t &kernelHash_,
+                                     const occa::json &kernelProps_,
+                                     const bool isLauncherKernel_) :
+      filename(filename_),
+      kernelName(kernelName_),
+      kernelHash(kernelHash_),
+      kernelProps(kernelProps_),
+      isLauncherKernel(isLauncherKernel_),
+      hashDir(io::hashDir(filename_, kernelHash_)),
+      binaryFile(isLauncherKernel_
+                 ? kc::launcherBinaryFile
+                 : kc::binaryFile),
+      binaryFilename(hashDir + binaryFile),
+      foundBinary(false),
+      isValid(true) {}
+
     device::device(const occa::json &properties_) :
-      occa::modeDevice_t(properties_) {}
+      occa::modeDevice_t(properties_),
+      memoryPool(NULL) {
+      if (properties.get("memory_pool/enabled", false)) {
+        const dim_t maxCachedBytes = properties.get<dim_t>("memory_pool/max_cached_bytes", 0);
+        OCCA_ERROR("[memory_pool/max_cached_bytes] can't be negative, found [" << maxCachedBytes << "]",
+                   maxCachedBytes >= 0);
+        memoryPool = new memoryPool_t((udim_t) maxCachedBytes);
+      }
+    }
 
-    device::~device() {}
+    device::~device() {
+      delete memoryPool;
+    }
 
-    void device::finish() const {}
+    void device::finish() const {
+      stream *stream_ = getAsyncStream();
+      if (stream_) {
+        stream_->finish();
+      }
+    }
 
     bool device::hasSeparateMemorySpace() const {
       return false;
@@ -30,7 +70,7 @@ namespace occa {
     }
 
     hash_t device::kernelHash(const occa::json &props) const {
-      return (
+      hash_t kernelHash_ = (
         occa::hash(props["compiler"])
         ^ props["compiler_flags"]
         ^ props["compiler_env_script"]
@@ -39,6 +79,14 @@ namespace occa {
         ^ props["compiler_linker_flags"]
         ^ props["compiler_shared_flags"]
       );
+      // The [serial/...] properties change the generated source and compiler flags
+      if (props.has("serial")) {
+        kernelHash_ ^= occa::hash(props["serial"]);
+      }
+      if (props.get("okl/fuse_inner_loops", false)) {
+        kernelHash_ ^= occa::hash("okl/fuse_inner_loops");
+      }
+      return kernelHash_;
     }
 
     //---[ Stream ]---------------------
@@ -47,10 +95,19 @@ namespace occa {
     }
 
     occa::streamTag device::tagStream() {
+      stream *stream_ = getAsyncStream();
+      if (stream_) {
+        return new occa::serial::streamTag(this, stream_->queue);
+      }
       return new occa::serial::streamTag(this, sys::currentTime());
     }
 
-    void device::waitFor(occa::streamTag tag) {}
+    void device::waitFor(occa::streamTag tag) {
+      occa::serial::streamTag *srTag = (
+        dynamic_cast<occa::serial::streamTag*>(tag.getModeStreamTag())
+      );
+      srTag->wait();
+    }
 
     double device::timeBetween(const occa::streamTag &startTag,
                                const occa::streamTag &endTag) {
@@ -61,7 +118,47 @@ namespace occa {
         dynamic_cast<occa::serial::streamTag*>(endTag.getModeStreamTag())
       );
 
-      return (srEndTag->time - srStartTag->time);
+      return (srEndTag->getTime() - srStartTag->getTime());
+    }
+
+    stream* device::getAsyncStream() const {
+      stream *stream_ = (stream*) currentStream.getModeStream();
+      if (stream_ && stream_->isAsync()) {
+        return stream_;
+      }
+      return NULL;
+    }
+
+    void device::addAsyncStream(stream *stream_) {
+      std::lock_guard<std::mutex> lock(asyncStreamsMutex);
+      asyncStreams.push_back(stream_);
+    }
+
+    void device::removeAsyncStream(stream *stream_) {
+      std::lock_guard<std::mutex> lock(asyncStreamsMutex);
+      asyncStreams.erase(
+        std::remove(asyncStreams.begin(), asyncStreams.end(), stream_),
+        asyncStreams.end()
+      );
+    }
+
+    pendingTicketVector device::getPendingTickets() const {
+      pendingTicketVector pendingTickets;
+      std::lock_guard<std::mutex> lock(asyncStreamsMutex);
+      for (stream *stream_ : asyncStreams) {
+        const udim_t ticket = stream_->queue->lastTicket();
+        if (!stream_->queue->hasFinished(ticket)) {
+          pendingTickets.push_back(pendingTicket_t(stream_->queue, ticket));
+        }
+      }
+      return pendingTickets;
+    }
+
+    void device::drainAsyncStreams() const {
+      std::lock_guard<std::mutex> lock(asyncStreamsMutex);
+      for (stream *stream_ : asyncStreams) {
+        stream_->drain();
+      }
     }
     //==================================
 
@@ -112,43 +209,113 @@ namespace occa {
                                       const hash_t kernelHash,
                                       const occa::json &kernelProps,
                                       const bool isLauncherKernel) {
-      const std::string hashDir = io::hashDir(filename, kernelHash);
+      kernelCompile_t compile(filename,
+                              kernelName,
+                              kernelHash,
+                              kernelProps,
+                              isLauncherKernel);
+
+      if (!setupKernelCompile(compile)) {
+        return NULL;
+      }
 
-      const std::string &kcBinaryFile = (
-        isLauncherKernel
-        ? kc::launcherBinaryFile
-        : kc::binaryFile
-      );
-      std::string binaryFilename = hashDir + kcBinaryFile;
+      if (!compile.foundBinary) {
+        sys::compilerDriver().run(compile.compileJob,
+                                  sys::compilerDriver_t::getMaxJobs(kernelProps));
+      }
 
-      // Check if binary exists and is finished
-      bool foundBinary = (
-        io::cachedFileIsComplete(hashDir, kcBinaryFile)
-        && io::isFile(binaryFilename)
-      );
+      return finishKernelCompile(compile, kernelName);
+    }
 
-      io::lock_t lock;
-      if (!foundBinary) {
-        lock = io::lock_t(kernelHash, "serial-kernel");
-        foundBinary = !lock.isMine();
+    void device::buildKernels(kernelBuildVector &builds) {
+      // Kernels sharing a hash come from the same source and props,
+      //   so they are served by the same binary
+      std::map<hash_t, kernelCompile_t*> compileMap;
+      std::vector<kernelCompile_t*> compiles;
+
+      for (kernelBuild_t *build : builds) {
+        if (compileMap.find(build->kernelHash) != compileMap.end()) {
+          continue;
+        }
+
+        kernelCompile_t *compile = new kernelCompile_t(build->filename,
+                                                       build->kernelName,
+                                                       build->kernelHash,
+                                                       build->kernelProps,
+                                                       false);
+        compileMap[build->kernelHash] = compile;
+        compiles.push_back(compile);
+
+        try {
+          compile->isValid = setupKernelCompile(*compile);
+        } catch (occa::exception &exc) {
+          compile->isValid = false;
+          compile->error = exc.message;
+        }
       }
 
-      const bool verbose = kernelProps.get("verbose", false);
-      if (foundBinary) {
-        if (verbose) {
-          io::stdout << "Loading cached ["
-                     << kernelName
-                     << "] from ["
-                     << io::shortname(filename)
-                     << "] in [" << io::shortname(binaryFilename) << "]\n";
+      // Run all missing compiles concurrently
+      // [compiler_jobs] is a limit, so the strictest one in the batch is used
+      sys::compileJobVector jobs;
+      int maxJobs = 0;
+      for (kernelCompile_t *compile : compiles) {
+        if (compile->isValid && !compile->foundBinary) {
+          jobs.push_back(&(compile->compileJob));
+
+          const int compileMaxJobs = sys::compilerDriver_t::getMaxJobs(compile->kernelProps);
+          maxJobs = (
+            maxJobs
+            ? std::min(maxJobs, compileMaxJobs)
+            : compileMaxJobs
+          );
         }
-        modeKernel_t *k = buildKernelFromBinary(binaryFilename,
-                                                kernelName,
-                                                kernelProps);
-        if (k) {
-          k->sourceFilename = filename;
+      }
+      if (jobs.size()) {
+        sys::compilerDriver().run(jobs, maxJobs);
+      }
+
+      for (kernelBuild_t *build : builds) {
+        kernelCompile_t &compile = *(compileMap[build->kernelHash]);
+        if (!compile.isValid) {
+          build->error = compile.error;
+          continue;
         }
-        return k;
+        try {
+          build->modeKernel = finishKernelCompile(compile, build->kernelName);
+        } catch (occa::exception &exc) {
+          build->error = exc.message;
+        }
+      }
+
+      for (kernelCompile_t *compile : compiles) {
+        delete compile;
+      }
+    }
+
+    bool device::setupKernelCompile(kernelCompile_t &compile) {
+      const std::string &filename = compile.filename;
+      const std::string &kernelName = compile.kernelName;
+      const hash_t &kernelHash = compile.kernelHash;
+      const occa::json &kernelProps = compile.kernelProps;
+      const bool isLauncherKernel = compile.isLauncherKernel;
+      const std::string &hashDir = compile.hashDir;
+      const std::string &binaryFilename = compile.binaryFilename;
+      lang::sourceMetadata_t &metadata = compile.metadata;
+
+      // Check if binary is already loaded or exists and is finished
+      compile.foundBinary = (
+        isSharedBinaryLoaded(binaryFilename)
+        || (io::cachedFileIsComplete(hashDir, compile.binaryFile)
+            && io::isFile(binaryFilename))
+      );
+
+      if (!compile.foundBinary) {
+        compile.lock = io::lock_t(kernelHash, "serial-kernel");
+        compile.foundBinary = !compile.lock.isMine();
+      }
+
+      if (compile.foundBinary) {
+        return true;
       }
 
       std::string compilerLanguage;
@@ -272,7 +439,6 @@ namespace occa {
       }
 
       std::string sourceFilename;
-      lang::sourceMetadata_t metadata;
 
       if (isLauncherKernel) {
         sourceFilename = filename;
@@ -309,69 +475,131 @@ namespace occa {
         }
       }
 
-      std::stringstream command;
-      if (compilerEnvScript.size()) {
-        command << compilerEnvScript << " && ";
-      }
-
       sys::addCompilerFlags(compilerFlags, compilerSharedFlags);
 
+      if (compilingOkl && kernelProps.get("serial/vectorize", false)) {
+        const std::string simdFlags = sys::compilerOpenMPSimdFlags(compilerVendor);
+        if (simdFlags.size()) {
+          sys::addCompilerFlags(compilerFlags, simdFlags);
+        }
+      }
+
       if (!compilingOkl) {
         sys::addCompilerIncludeFlags(compilerFlags);
         sys::addCompilerLibraryFlags(compilerFlags);
       }
 
+      strVector command = sys::splitCommandLine(compiler);
 #if (OCCA_OS & (OCCA_LINUX_OS | OCCA_MACOS_OS))
-      command << compiler
-              << ' '    << compilerFlags
-              << ' '    << sourceFilename
-              << " -o " << binaryFilename
-              << " -I"  << env::OCCA_DIR << "include"
-              << " -I"  << env::OCCA_INSTALL_DIR << "include"
-              << " -L"  << env::OCCA_INSTALL_DIR << "lib -locca"
-              << ' '    << compilerLinkerFlags
-              << std::endl;
+      for (const std::string &flag : sys::splitCommandLine(compilerFlags)) {
+        command.push_back(flag);
+      }
+      command.push_back(sourceFilename);
+      command.push_back("-o");
+      command.push_back(binaryFilename);
+      command.push_back("-I" + env::OCCA_DIR + "include");
+      command.push_back("-I" + env::OCCA_INSTALL_DIR + "include");
+      command.push_back("-L" + env::OCCA_INSTALL_DIR + "lib");
+      command.push_back("-locca");
+      for (const std::string &flag : sys::splitCommandLine(compilerLinkerFlags)) {
+        command.push_back(flag);
+      }
 #else
-      command << kernelProps["compiler"]
-              << " /D MC_CL_EXE"
-              << " /D OCCA_OS=OCCA_WINDOWS_OS"
-              << " /EHsc"
-              << " /wd4244 /wd4800 /wd4804 /wd4018"
-              << ' '       << compilerFlags
-              << " /I"     << env::OCCA_DIR << "include"
-              << " /I"     << env::OCCA_INSTALL_DIR << "include"
-              << ' '       << sourceFilename
-              << " /link " << env::OCCA_INSTALL_DIR << "lib/libocca.lib",
-              << ' '       << compilerLinkerFlags
-              << " /OUT:"  << binaryFilename
-              << std::endl;
-#endif
-
-      const std::string &sCommand = strip(command.str());
-
-      if (verbose) {
-        io::stdout << "Compiling [" << kernelName << "]\n" << sCommand << "\n";
+      command.push_back("/DMC_CL_EXE");
+      command.push_back("/DOCCA_OS=OCCA_WINDOWS_OS");
+      command.push_back("/EHsc");
+      command.push_back("/wd4244");
+      command.push_back("/wd4800");
+      command.push_back("/wd4804");
+      command.push_back("/wd4018");
+      for (const std::string &flag : sys::splitCommandLine(compilerFlags)) {
+        command.push_back(flag);
+      }
+      command.push_back("/I" + env::OCCA_DIR + "include");
+      command.push_back("/I" + env::OCCA_INSTALL_DIR + "include");
+      command.push_back(sourceFilename);
+      // Everything after /link is passed to the linker
+      command.push_back("/link");
+      command.push_back(env::OCCA_INSTALL_DIR + "lib/libocca.lib");
+      for (const std::string &flag : sys::splitCommandLine(compilerLinkerFlags)) {
+        command.push_back(flag);
       }
+      command.push_back("/OUT:" + binaryFilename);
+#endif
 
+      // The environment script needs a shell to setup the compiler environment
+      if (compilerEnvScript.size()) {
 #if (OCCA_OS & (OCCA_LINUX_OS | OCCA_MACOS_OS))
-      const int compileError = system(sCommand.c_str());
+        const std::string shellCommand = (
+          compilerEnvScript + " && " + sys::joinCommandLine(command)
+        );
+        command.clear();
+        command.push_back("/bin/sh");
+        command.push_back("-c");
+        command.push_back(shellCommand);
 #else
-      const int compileError = system(("\"" +  sCommand + "\"").c_str());
+        command.insert(command.begin(), "&&");
+        command.insert(command.begin(), compilerEnvScript);
 #endif
+      }
+
+      compile.compileJob = sys::compileJob_t(command);
+
+      if (kernelProps.get("verbose", false)) {
+        io::stdout << "Compiling [" << kernelName << "]\n"
+                   << compile.compileJob.commandString() << "\n";
+      }
+
+      return true;
+    }
+
+    modeKernel_t* device::finishKernelCompile(kernelCompile_t &compile,
+                                              const std::string &kernelName) {
+      const std::string &binaryFilename = compile.binaryFilename;
+      const occa::json &kernelProps = compile.kernelProps;
+      const bool verbose = kernelProps.get("verbose", false);
+
+      if (compile.foundBinary) {
+        if (verbose) {
+          io::stdout << "Loading cached ["
+                     << kernelName
+                     << "] from ["
+                     << io::shortname(compile.filename)
+                     << "] in [" << io::shortname(binaryFilename) << "]\n";
+        }
+        modeKernel_t *k = buildKernelFromBinary(binaryFilename,
+                                                kernelName,
+                                                kernelProps);
+        if (k) {
+          k->sourceFilename = compile.filename;
+        }
+        return k;
+      }
 
-      lock.release();
-      if (compileError) {
+      sys::compileJob_t &compileJob = compile.compileJob;
+
+      compile.lock.release();
+      if (!compileJob.succeeded()) {
         OCCA_FORCE_ERROR("Error compiling [" << kernelName << "],"
-                         " Command: [" << sCommand << ']');
+                         " Command: [" << compileJob.commandString() << ']'
+                         << (compileJob.output.size() ? "\n" : "")
+                         << compileJob.output);
+      }
+
+      if (verbose && compileJob.output.size()) {
+        io::stdout << compileJob.output;
+        compileJob.output.clear();
       }
 
       modeKernel_t *k = buildKernelFromBinary(binaryFilename,
                                               kernelName,
                                               kernelProps,
-                                              metadata.kernelsMetadata[kernelName]);
+                                              compile.metadata.kernelsMetadata[kernelName]);
       if (k) {
-        io::markCachedFileComplete(hashDir, kcBinaryFile);
-        k->sourceFilename = filename;
+        // Sibling kernels can skip reading the build file
+        setSharedBinaryMetadata(((kernel*) k)->binary, compile.metadata);
+        io::markCachedFileComplete(compile.hashDir, compile.binaryFile);
+        k->sourceFilename = compile.filename;
       }
       return k;
     }
@@ -382,13 +610,16 @@ namespace occa {
       std::string buildFile = io::dirname(filename);
       buildFile += kc::buildFile;
 
+      sharedBinary_t *binary = loadSharedBinary(filename);
       lang::kernelMetadata_t metadata;
-      if (io::isFile(buildFile)) {
-        lang::sourceMetadata_t sourceMetadata = lang::sourceMetadata_t::fromBuildFile(buildFile);
-        metadata = sourceMetadata.kernelsMetadata[kernelName];
+      try {
+        metadata = getSharedBinaryMetadata(binary, buildFile, kernelName);
+      } catch (...) {
+        releaseSharedBinary(binary);
+        throw;
       }
 
-      return buildKernelFromBinary(filename,
+      return buildKernelFromBinary(binary,
                                    kernelName,
                                    kernelProps,
                                    metadata);
@@ -398,30 +629,68 @@ namespace occa {
                                                 const std::string &kernelName,
                                                 const occa::json &kernelProps,
                                                 lang::kernelMetadata_t &metadata) {
-      kernel &k = *(new kernel(this,
-                               kernelName,
-                               filename,
-                               kernelProps));
+      return buildKernelFromBinary(loadSharedBinary(filename),
+                                   kernelName,
+                                   kernelProps,
+                                   metadata);
+    }
+
+    modeKernel_t* device::buildKernelFromBinary(sharedBinary_t *binary,
+                                                const std::string &kernelName,
+                                                const occa::json &kernelProps,
+                                                lang::kernelMetadata_t &metadata) {
+      kernel &k = *newKernel(kernelName,
+                             binary->filename,
+                             kernelProps);
 
-      k.binaryFilename = filename;
+      k.binaryFilename = binary->filename;
       k.metadata = metadata;
+      k.binary = binary;
 
-      k.dlHandle = sys::dlopen(filename);
-      k.function = sys::dlsym(k.dlHandle, kernelName);
+      try {
+        k.function = sys::dlsym(binary->dlHandle, kernelName);
+      } catch (...) {
+        delete &k;
+        throw;
+      }
 
       return &k;
     }
+
+    kernel* device::newKernel(const std::string &kernelName,
+                              const std::string &sourceFilename,
+                              const occa::json &kernelProps) {
+      return new kernel(this,
+                        kernelName,
+                        sourceFilename,
+                        kernelProps);
+    }
     //==================================
 
     //---[ Memory ]-------------------
     modeMemory_t* device::malloc(const udim_t bytes,
                                  const void *src,
                                  const occa::json &props) {
+      // Validated before allocating anything
+      memoryPlacement_t placement(props);
+
       memory *mem = new memory(this, bytes, props);
 
       if (src && props.get("use_host_pointer", false)) {
         mem->ptr = (char*) const_cast<void*>(src);
         mem->isOrigin = props.get("own_host_pointer", false);
+      } else if (!placement.isDefault()) {
+        // Placed memory skips the pool since cached blocks could live anywhere
+        mem->ptr = placement.allocate(bytes, src);
+        mem->placedBytes = placement.reservedBytes(bytes);
+      } else if (memoryPool) {
+        stream *stream_ = getAsyncStream();
+        mem->ptr = memoryPool->allocate(bytes,
+                                        stream_ ? stream_->queue.get() : NULL);
+        mem->isPooled = true;
+        if (src) {
+          ::memcpy(mem->ptr, src, bytes);
+        }
       } else {
         mem->ptr = (char*) sys::malloc(bytes);
         if (src) {
@@ -446,7 +715,33 @@ namespace occa {
     }
 
     udim_t device::memorySize() const {
-      return sys::SystemInfo::load().memory.total;
+      return sys::topology_t::get()->totalMemory;
+    }
+
+    bool device::usesMemoryPool() const {
+      return memoryPool != NULL;
+    }
+
+    void device::detachPooledMemory(const udim_t bytes) {
+      memoryPool->detach(bytes);
+    }
+
+    void device::releasePooledMemory(char *ptr,
+                                     const udim_t bytes) {
+      memoryPool->release(ptr, bytes, getPendingTickets());
+    }
+
+    void device::trimMemoryPool() {
+      if (memoryPool) {
+        memoryPool->trim();
+      }
+    }
+
+    occa::json device::memoryPoolInfo() const {
+      if (memoryPool) {
+        return memoryPool->info();
+      }
+      return modeDevice_t::memoryPoolInfo();
     }
     //==================================
   }
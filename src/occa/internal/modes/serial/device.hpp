@@ -1,14 +1,57 @@
 #ifndef OCCA_INTERNAL_MODES_SERIAL_DEVICE_HEADER
 #define OCCA_INTERNAL_MODES_SERIAL_DEVICE_HEADER
 
+#include <mutex>
+#include <vector>
+
 #include <occa/defines.hpp>
 #include <occa/internal/core/device.hpp>
+#include <occa/internal/io/lock.hpp>
+#include <occa/internal/modes/serial/memoryPool.hpp>
+#include <occa/internal/modes/serial/sharedBinary.hpp>
+#include <occa/internal/utils/compilerDriver.hpp>
 
 namespace occa {
   namespace serial {
+    class kernel;
+    class stream;
+
+    // State shared by the kernels served by one compiled binary
+    class kernelCompile_t {
+     public:
+      std::string filename;
+      std::string kernelName;
+      hash_t kernelHash;
+      occa::json kernelProps;
+      bool isLauncherKernel;
+
+      std::string hashDir;
+      std::string binaryFile;
+      std::string binaryFilename;
+
+      bool foundBinary;
+      bool isValid;
+      std::string error;
+
+      io::lock_t lock;
+      lang::sourceMetadata_t metadata;
+      sys::compileJob_t compileJob;
+
+      kernelCompile_t(const std::string &filename_,
+                      const std::string &kernelName_,
+                      const hash_t &kernelHash_,
+                      const occa::json &kernelProps_,
+                      const bool isLauncherKernel_);
+    };
+
     class device : public occa::modeDevice_t {
       mutable hash_t hash_;
 
+      mutable std::mutex asyncStreamsMutex;
+      std::vector<stream*> asyncStreams;
+
+      memoryPool_t *memoryPool;
+
     public:
       device(const occa::json &properties_);
       virtual ~device();
@@ -28,6 +71,18 @@ namespace occa {
       virtual void waitFor(streamTag tag);
       virtual double timeBetween(const streamTag &startTag,
                                  const streamTag &endTag);
+
+      // Returns the current stream if kernels and copies should be queued on it
+      stream* getAsyncStream() const;
+
+      void addAsyncStream(stream *stream_);
+      void removeAsyncStream(stream *stream_);
+
+      // Waits on every asynchronous stream, used before freeing kernels or memory
+      void drainAsyncStreams() const;
+
+      // The work queued on each asynchronous stream so far
+      pendingTicketVector getPendingTickets() const;
       //================================
 
       //---[ Kernel ]-------------------
@@ -51,6 +106,13 @@ namespace occa {
                                 const occa::json &kernelProps,
                                 const bool isLauncerKernel);
 
+      virtual void buildKernels(kernelBuildVector &builds);
+
+      bool setupKernelCompile(kernelCompile_t &compile);
+
+      modeKernel_t* finishKernelCompile(kernelCompile_t &compile,
+                                        const std::string &kernelName);
+
       virtual modeKernel_t* buildKernelFromBinary(const std::string &filename,
                                                   const std::string &kernelName,
                                                   const occa::json &kernelProps);
@@ -59,6 +121,16 @@ namespace occa {
                                                   const std::string &kernelName,
                                                   const occa::json &kernelProps,
                                                   lang::kernelMetadata_t &metadata);
+
+      modeKernel_t* buildKernelFromBinary(sharedBinary_t *binary,
+                                          const std::string &kernelName,
+                                          const occa::json &kernelProps,
+                                          lang::kernelMetadata_t &metadata);
+
+      // Lets host modes built on top of [Serial] run kernels their own way
+      virtual kernel* newKernel(const std::string &kernelName,
+                                const std::string &sourceFilename,
+                                const occa::json &kernelProps);
       //================================
 
       //---[ Memory ]-------------------
@@ -71,6 +143,14 @@ namespace occa {
                                const occa::json &props);
 
       virtual udim_t memorySize() const;
+
+      bool usesMemoryPool() const;
+      void detachPooledMemory(const udim_t bytes);
+      void releasePooledMemory(char *ptr,
+                               const udim_t bytes);
+
+      virtual void trimMemoryPool();
+      virtual occa::json memoryPoolInfo() const;
       //================================
     };
   }
@@ -1,7 +1,11 @@
+#include <memory>
+
 #include <occa/core/base.hpp>
 #include <occa/internal/utils/env.hpp>
 #include <occa/internal/io.hpp>
+#include <occa/internal/modes/serial/device.hpp>
 #include <occa/internal/modes/serial/kernel.hpp>
+#include <occa/internal/modes/serial/stream.hpp>
 #include <occa/internal/lang/modes/serial.hpp>
 
 namespace occa {
@@ -11,14 +15,17 @@ namespace occa {
                    const std::string &sourceFilename_,
                    const occa::json &properties_) :
       occa::modeKernel_t(modeDevice_, name_, sourceFilename_, properties_),
-      dlHandle(NULL),
+      binary(NULL),
       function(NULL),
       isLauncherKernel(false) {}
 
     kernel::~kernel() {
-      if (dlHandle) {
-        sys::dlclose(dlHandle);
-        dlHandle = NULL;
+      if (binary) {
+        // Queued launches could still be using the binary
+        ((device*) modeDevice)->drainAsyncStreams();
+
+        releaseSharedBinary(binary);
+        binary = NULL;
       }
     }
 
@@ -39,19 +46,49 @@ namespace occa {
     }
 
     void kernel::run() const {
-      const int args = (int) arguments.size();
-      if (!args) {
-        vArgs.resize(1);
-      } else if ((int) vArgs.size() < args) {
-        vArgs.resize(args);
+      runOrEnqueue(arguments, vArgs);
+    }
+
+    void kernel::runWithArguments(const kernelArgDataVector &args,
+                                  const dim &outerDims_,
+                                  const dim &innerDims_) {
+      static thread_local std::vector<void*> argPtrs;
+      runOrEnqueue(args, argPtrs);
+    }
+
+    void kernel::runOrEnqueue(const kernelArgDataVector &args,
+                              std::vector<void*> &argPtrs) const {
+      stream *stream_ = ((device*) modeDevice)->getAsyncStream();
+      if (!stream_) {
+        launch(args, argPtrs);
+        return;
+      }
+
+      // Arguments can be reset before the queued launch runs
+      std::shared_ptr<kernelArgDataVector> queuedArgs = (
+        std::make_shared<kernelArgDataVector>(args)
+      );
+      stream_->enqueue([this, queuedArgs]() {
+        std::vector<void*> queuedArgPtrs;
+        launch(*queuedArgs, queuedArgPtrs);
+      });
+    }
+
+    void kernel::launch(const kernelArgDataVector &args,
+                        std::vector<void*> &argPtrs) const {
+      const int argc = (int) args.size();
+      if (!argc) {
+        argPtrs.resize(1);
+      } else if ((int) argPtrs.size() < argc) {
+        argPtrs.resize(argc);
       }
 
       // Set arguments
-      for (int i = 0; i < args; ++i) {
-        vArgs[i] = arguments[i].ptr();
+      for (int i = 0; i < argc; ++i) {
+        argPtrs[i] = args[i].ptr();
       }
 
-      sys::runFunction(function, args, &(vArgs[0]));
+      sys::runFunction(function, argc, &(argPtrs[0]));
     }
   }
 }
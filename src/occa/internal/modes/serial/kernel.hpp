@@ -5,6 +5,7 @@
 
 #include <occa/defines.hpp>
 #include <occa/internal/core/kernel.hpp>
+#include <occa/internal/modes/serial/sharedBinary.hpp>
 #include <occa/internal/utils/sys.hpp>
 
 namespace occa {
@@ -13,7 +14,7 @@ namespace occa {
 
     class kernel : public occa::modeKernel_t {
     protected:
-      void *dlHandle;
+      sharedBinary_t *binary;
       functionPtr_t function;
       mutable std::vector<void*> vArgs;
 
@@ -34,6 +35,19 @@ namespace occa {
 
       void run() const;
 
+      // Host kernels ignore the dimensions so launches don't need the kernel state
+      void runWithArguments(const kernelArgDataVector &args,
+                            const dim &outerDims_,
+                            const dim &innerDims_);
+
+      // Runs now or queues the launch on the current async stream
+      void runOrEnqueue(const kernelArgDataVector &args,
+                        std::vector<void*> &argPtrs) const;
+
+      // Calls the kernel function with [args], using [argPtrs] as scratch space
+      virtual void launch(const kernelArgDataVector &args,
+                          std::vector<void*> &argPtrs) const;
+
       friend class device;
     };
   }
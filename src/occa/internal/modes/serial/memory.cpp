@@ -1,18 +1,60 @@
 #include <cstring>
+#include <occa/internal/modes/serial/device.hpp>
 #include <occa/internal/modes/serial/memory.hpp>
+#include <occa/internal/modes/serial/memoryPlacement.hpp>
+#include <occa/internal/modes/serial/stream.hpp>
 #include <occa/internal/utils/sys.hpp>
-#include <occa/internal/core/device.hpp>
 
 namespace occa {
   namespace serial {
     memory::memory(modeDevice_t *modeDevice_,
                    udim_t size_,
                    const occa::json &properties_) :
-      occa::modeMemory_t(modeDevice_, size_, properties_) {}
+      occa::modeMemory_t(modeDevice_, size_, properties_),
+      isPooled(false),
+      placedBytes(0) {}
+
+    // Queues asynchronous copies on the current stream,
+    //   otherwise waits for the stream before copying
+    static void runCopy(modeDevice_t *modeDevice,
+                        const occa::json &props,
+                        void *dest,
+                        const void *src,
+                        const udim_t bytes) {
+      stream *stream_ = ((device*) modeDevice)->getAsyncStream();
+      if (!stream_) {
+        ::memcpy(dest, src, bytes);
+        return;
+      }
+
+      if (props.get("async", false)) {
+        stream_->enqueue([dest, src, bytes]() {
+          ::memcpy(dest, src, bytes);
+        });
+      } else {
+        stream_->finish();
+        ::memcpy(dest, src, bytes);
+      }
+    }
 
     memory::~memory() {
       if (ptr && isOrigin) {
-        sys::free(ptr);
+        if (isPooled && modeDevice) {
+          // The pool holds on to the block until queued work is done with it
+          ((device*) modeDevice)->releasePooledMemory(ptr, size);
+          ptr = NULL;
+          size = 0;
+          return;
+        }
+        // Queued kernels and copies could still be using the memory
+        if (modeDevice) {
+          ((device*) modeDevice)->drainAsyncStreams();
+        }
+        if (placedBytes) {
+          memoryPlacement_t::free(ptr, placedBytes);
+        } else {
+          sys::free(ptr);
+        }
       }
       ptr = NULL;
       size = 0;
@@ -22,6 +64,10 @@ namespace occa {
       return ptr;
     }
 
+    primitive memory::getKernelArgAtOffset(const udim_t offset) const {
+      return (void*) (ptr + offset);
+    }
+
     modeMemory_t* memory::addOffset(const dim_t offset) {
       memory *m = new memory(modeDevice,
                              size - offset,
@@ -36,7 +82,7 @@ namespace occa {
                         const occa::json &props) const {
       const void *srcPtr = ptr + offset;
 
-      ::memcpy(dest, srcPtr, bytes);
+      runCopy(modeDevice, props, dest, srcPtr, bytes);
     }
 
     void memory::copyFrom(const void *src,
@@ -47,7 +93,7 @@ namespace occa {
       void *destPtr      = ptr + offset;
       const void *srcPtr = src;
 
-      ::memcpy(destPtr, srcPtr, bytes);
+      runCopy(modeDevice, props, destPtr, srcPtr, bytes);
     }
 
     void memory::copyFrom(const modeMemory_t *src,
@@ -59,10 +105,22 @@ namespace occa {
       void *destPtr      = ptr + destOffset;
       const void *srcPtr = src->ptr + srcOffset;
 
-      ::memcpy(destPtr, srcPtr, bytes);
+      runCopy(modeDevice, props, destPtr, srcPtr, bytes);
+    }
+
+    void memory::assertDetachable() const {
+      // Placed memory is mapped and can only be released through memoryPlacement_t::free
+      OCCA_ERROR("Memory allocated with a placement (numa_node, interleave, huge_pages or first_touch)"
+                 " can't be detached",
+                 !(isOrigin && placedBytes));
     }
 
     void memory::detach() {
+      // The caller now owns the block, so the pool stops counting it
+      if (ptr && isOrigin && isPooled && modeDevice) {
+        ((device*) modeDevice)->detachPooledMemory(size);
+      }
+      isPooled = false;
       ptr = NULL;
       size = 0;
     }
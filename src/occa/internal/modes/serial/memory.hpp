@@ -8,6 +8,12 @@ namespace occa {
   namespace serial {
     class memory : public occa::modeMemory_t {
     public:
+      // Allocated from the device memory pool
+      bool isPooled;
+
+      // Bytes mapped for memory with a NUMA, huge page or first-touch placement
+      udim_t placedBytes;
+
       memory(modeDevice_t *modeDevice_,
              udim_t size_,
              const occa::json &properties_ = occa::json());
@@ -15,6 +21,8 @@ namespace occa {
 
       void* getKernelArgPtr() const;
 
+      primitive getKernelArgAtOffset(const udim_t offset) const;
+
       modeMemory_t* addOffset(const dim_t offset);
 
       void copyTo(void *dest,
@@ -32,6 +40,7 @@ namespace occa {
                     const udim_t destOffset,
                     const udim_t srcOffset,
                     const occa::json &props);
+      void assertDetachable() const;
       void detach();
     };
   }
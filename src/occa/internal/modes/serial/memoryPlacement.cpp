@@ -0,0 +1,260 @@
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <thread>
+#include <vector>
+
+#include <occa/internal/modes/serial/memoryPlacement.hpp>
+#include <occa/internal/utils/sys.hpp>
+#include <occa/internal/utils/topology.hpp>
+#include <occa/utils/logging.hpp>
+
+#if (OCCA_OS == OCCA_LINUX_OS)
+#  include <pthread.h>
+#  include <sched.h>
+#  include <sys/mman.h>
+#  include <sys/syscall.h>
+#  include <unistd.h>
+#endif
+
+namespace occa {
+  namespace serial {
+    // Matches <numaif.h> without requiring libnuma
+    static const int MPOL_BIND_MODE       = 2;
+    static const int MPOL_INTERLEAVE_MODE = 3;
+    static const int maxNumaNodes         = 1024;
+    static const int bitsPerLong          = 8 * sizeof(unsigned long);
+
+    static const udim_t hugePageBytes = 2 * 1024 * 1024;
+
+    static udim_t roundUp(const udim_t value,
+                          const udim_t alignment) {
+      return alignment * ((value + alignment - 1) / alignment);
+    }
+
+    static udim_t getPageBytes() {
+#if (OCCA_OS == OCCA_LINUX_OS)
+      static const udim_t pageBytes = (udim_t) ::sysconf(_SC_PAGESIZE);
+      return pageBytes;
+#else
+      return 4096;
+#endif
+    }
+
+    static std::vector<int> getOnlineNumaNodes() {
+      std::vector<int> nodes;
+      for (const sys::numaNodeInfo_t &node : sys::topology_t::get()->numaNodes) {
+        nodes.push_back(node.id);
+      }
+      return nodes;
+    }
+
+    static std::vector<int> getAllowedCpus() {
+      std::vector<int> cpus;
+#if (OCCA_OS == OCCA_LINUX_OS)
+      cpu_set_t cpuSet;
+      CPU_ZERO(&cpuSet);
+      if (!::sched_getaffinity(0, sizeof(cpuSet), &cpuSet)) {
+        for (int cpu = 0; cpu < CPU_SETSIZE; ++cpu) {
+          if (CPU_ISSET(cpu, &cpuSet)) {
+            cpus.push_back(cpu);
+          }
+        }
+      }
+#endif
+      if (!cpus.size()) {
+        cpus = sys::topology_t::get()->cpus;
+      }
+      return cpus;
+    }
+
+    static void pinToCpu(const int cpu) {
+#if (OCCA_OS == OCCA_LINUX_OS)
+      cpu_set_t cpuSet;
+      CPU_ZERO(&cpuSet);
+      CPU_SET(cpu, &cpuSet);
+      ::pthread_setaffinity_np(::pthread_self(), sizeof(cpuSet), &cpuSet);
+#endif
+    }
+
+    memoryPlacement_t::memoryPlacement_t(const occa::json &props) :
+      numaNode(props.get("numa_node", -1)),
+      interleave(props.get("interleave", false)),
+      hugePages(props.get("huge_pages", false)),
+      parallelFirstTouch(false),
+      firstTouchThreads(props.get("first_touch_threads", 0)) {
+
+      OCCA_ERROR("[numa_node] can't be negative, found [" << numaNode << "]",
+                 !props.has("numa_node") || (numaNode >= 0));
+
+      OCCA_ERROR("[numa_node] and [interleave] can't be used together",
+                 (numaNode < 0) || !interleave);
+
+      const std::string firstTouch = props.get<std::string>("first_touch", "default");
+      OCCA_ERROR("[first_touch] must be one of [default, parallel], found [" << firstTouch << "]",
+                 (firstTouch == "default") || (firstTouch == "parallel"));
+      parallelFirstTouch = (firstTouch == "parallel");
+
+      OCCA_ERROR("[first_touch_threads] must be positive, found [" << firstTouchThreads << "]",
+                 !props.has("first_touch_threads") || (firstTouchThreads > 0));
+    }
+
+    bool memoryPlacement_t::isDefault() const {
+      return (
+        (numaNode < 0)
+        && !interleave
+        && !hugePages
+        && !parallelFirstTouch
+      );
+    }
+
+    udim_t memoryPlacement_t::reservedBytes(const udim_t bytes) const {
+#if (OCCA_OS == OCCA_LINUX_OS)
+      return roundUp(bytes ? bytes : 1,
+                     hugePages ? hugePageBytes : getPageBytes());
+#else
+      return bytes;
+#endif
+    }
+
+    char* memoryPlacement_t::allocate(const udim_t bytes,
+                                      const void *src) const {
+#if (OCCA_OS == OCCA_LINUX_OS)
+      // Policies are applied per page so the allocation is mapped directly
+      const udim_t reserved = reservedBytes(bytes);
+      const udim_t alignment = hugePages ? hugePageBytes : getPageBytes();
+      const udim_t mappedBytes = reserved + (alignment - getPageBytes());
+
+      void *mappedPtr = ::mmap(NULL, mappedBytes,
+                               PROT_READ | PROT_WRITE,
+                               MAP_PRIVATE | MAP_ANONYMOUS,
+                               -1, 0);
+      OCCA_ERROR("Unable to allocate [" << bytes << "] bytes",
+                 mappedPtr != MAP_FAILED);
+
+      // Trim the mapping to the aligned range
+      char *start = (char*) mappedPtr;
+      char *ptr = (char*) roundUp((udim_t) start, alignment);
+      char *end = start + mappedBytes;
+      if (ptr > start) {
+        ::munmap(start, ptr - start);
+      }
+      if (end > (ptr + reserved)) {
+        ::munmap(ptr + reserved, end - (ptr + reserved));
+      }
+
+      applyPolicies(ptr, reserved);
+#else
+      char *ptr = (char*) sys::malloc(bytes);
+#endif
+
+      touch(ptr, bytes, src);
+      return ptr;
+    }
+
+    void memoryPlacement_t::free(char *ptr,
+                                 const udim_t reservedBytes_) {
+#if (OCCA_OS == OCCA_LINUX_OS)
+      ::munmap(ptr, reservedBytes_);
+#else
+      sys::free(ptr);
+#endif
+    }
+
+    void memoryPlacement_t::applyPolicies(char *ptr,
+                                          const udim_t bytes) const {
+#if (OCCA_OS == OCCA_LINUX_OS)
+      if (hugePages) {
+#  ifdef MADV_HUGEPAGE
+        if (::madvise(ptr, bytes, MADV_HUGEPAGE)) {
+          printWarning("Unable to use huge pages: " + std::string(::strerror(errno)));
+        }
+#  else
+        printWarning("Huge pages are not supported on this system");
+#  endif
+      }
+
+      if ((numaNode < 0) && !interleave) {
+        return;
+      }
+
+      unsigned long nodeMask[maxNumaNodes / bitsPerLong];
+      ::memset(nodeMask, 0, sizeof(nodeMask));
+
+      std::vector<int> nodes;
+      if (interleave) {
+        nodes = getOnlineNumaNodes();
+      } else {
+        nodes.push_back(numaNode);
+      }
+
+      int maskedNodes = 0;
+      for (int node : nodes) {
+        if (node < maxNumaNodes) {
+          nodeMask[node / bitsPerLong] |= (1UL << (node % bitsPerLong));
+          ++maskedNodes;
+        }
+      }
+      if (!maskedNodes) {
+        printWarning("Unable to find the NUMA nodes, skipping NUMA placement");
+        return;
+      }
+
+#  ifdef SYS_mbind
+      const long error = ::syscall(SYS_mbind,
+                                   ptr, bytes,
+                                   interleave ? MPOL_INTERLEAVE_MODE : MPOL_BIND_MODE,
+                                   nodeMask, maxNumaNodes + 1,
+                                   0);
+      if (error) {
+        printWarning("Unable to apply NUMA placement: " + std::string(::strerror(errno)));
+      }
+#  else
+      printWarning("NUMA placement is not supported on this system");
+#  endif
+#endif
+    }
+
+    void memoryPlacement_t::touch(char *ptr,
+                                  const udim_t bytes,
+                                  const void *src) const {
+      const char *srcPtr = (const char*) src;
+
+      if (!parallelFirstTouch) {
+        if (srcPtr) {
+          ::memcpy(ptr, srcPtr, bytes);
+        }
+        return;
+      }
+
+      // Contiguous page-aligned chunks per thread, matching a static schedule over
+      //   threads bound in order to the allowed cpus
+      const std::vector<int> cpus = getAllowedCpus();
+      const int threads = firstTouchThreads ? firstTouchThreads : (int) cpus.size();
+      const udim_t chunkBytes = roundUp((bytes + threads - 1) / threads,
+                                        getPageBytes());
+
+      std::vector<std::thread> workers;
+      for (int t = 0; t < threads; ++t) {
+        const udim_t begin = t * chunkBytes;
+        if (begin >= bytes) {
+          break;
+        }
+        const udim_t chunk = std::min(chunkBytes, bytes - begin);
+        const int cpu = cpus[t % cpus.size()];
+
+        workers.emplace_back([=]() {
+          pinToCpu(cpu);
+          if (srcPtr) {
+            ::memcpy(ptr + begin, srcPtr + begin, chunk);
+          } else {
+            ::memset(ptr + begin, 0, chunk);
+          }
+        });
+      }
+      for (std::thread &worker : workers) {
+        worker.join();
+      }
+    }
+  }
+}
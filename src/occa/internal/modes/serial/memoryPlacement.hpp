@@ -0,0 +1,51 @@
+#ifndef OCCA_INTERNAL_MODES_SERIAL_MEMORYPLACEMENT_HEADER
+#define OCCA_INTERNAL_MODES_SERIAL_MEMORYPLACEMENT_HEADER
+
+#include <occa/defines.hpp>
+#include <occa/types.hpp>
+#include <occa/types/json.hpp>
+
+namespace occa {
+  namespace serial {
+    // Host memory placement read from the memory properties:
+    //   numa_node           : Bind pages to a NUMA node
+    //   interleave          : Interleave pages across the online NUMA nodes
+    //   huge_pages          : Ask for transparent huge pages
+    //   first_touch         : "default" or "parallel"
+    //   first_touch_threads : Threads used for a parallel first touch
+    //
+    // Policies the system doesn't support are skipped, with a warning in verbose mode
+    class memoryPlacement_t {
+     public:
+      int numaNode;
+      bool interleave;
+      bool hugePages;
+      bool parallelFirstTouch;
+      int firstTouchThreads;
+
+      memoryPlacement_t(const occa::json &props);
+
+      bool isDefault() const;
+
+      // Bytes reserved for an allocation of [bytes], needed to free it
+      udim_t reservedBytes(const udim_t bytes) const;
+
+      // Allocates [bytes] with the placement applied and copies [src] if non-NULL
+      char* allocate(const udim_t bytes,
+                     const void *src) const;
+
+      static void free(char *ptr,
+                       const udim_t reservedBytes_);
+
+     private:
+      void applyPolicies(char *ptr,
+                         const udim_t bytes) const;
+
+      void touch(char *ptr,
+                 const udim_t bytes,
+                 const void *src) const;
+    };
+  }
+}
+
+#endif
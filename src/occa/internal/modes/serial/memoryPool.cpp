@@ -0,0 +1,143 @@
+#include <occa/internal/modes/serial/memoryPool.hpp>
+#include <occa/internal/modes/serial/stream.hpp>
+#include <occa/internal/utils/sys.hpp>
+
+namespace occa {
+  namespace serial {
+    pendingTicket_t::pendingTicket_t(std::shared_ptr<streamQueue_t> queue_,
+                                     const udim_t ticket_) :
+      queue(queue_),
+      ticket(ticket_) {}
+
+    bool memoryPool_t::block_t::isReady(const streamQueue_t *queue) const {
+      for (const pendingTicket_t &pending : pendingTickets) {
+        // Work queued later on the same stream runs after the pending work
+        if ((pending.queue.get() != queue)
+            && !pending.queue->hasFinished(pending.ticket)) {
+          return false;
+        }
+      }
+      return true;
+    }
+
+    memoryPool_t::memoryPool_t(const udim_t maxCachedBytes_) :
+      maxCachedBytes(maxCachedBytes_),
+      cachedBytes(0),
+      reservedBytes(0),
+      peakReservedBytes(0),
+      hits(0),
+      misses(0) {}
+
+    memoryPool_t::~memoryPool_t() {
+      trim();
+    }
+
+    udim_t memoryPool_t::sizeClass(const udim_t bytes) {
+      const udim_t minBytes = 256;
+      if (bytes <= minBytes) {
+        return minBytes;
+      }
+
+      // Split each power of two into 4 classes
+      udim_t octave = minBytes;
+      while ((octave << 1) < bytes) {
+        octave <<= 1;
+      }
+      const udim_t step = octave / 4;
+      return ((bytes + step - 1) / step) * step;
+    }
+
+    char* memoryPool_t::allocate(const udim_t bytes,
+                                 const streamQueue_t *queue) {
+      const udim_t blockBytes = sizeClass(bytes);
+      {
+        std::lock_guard<std::mutex> lock(mutex);
+        auto it = freeBlocks.find(blockBytes);
+        if (it != freeBlocks.end()) {
+          blockVector &blocks = it->second;
+          // Prefer the most recently released block, its pages are likely still warm
+          for (int i = (int) blocks.size() - 1; i >= 0; --i) {
+            if (!blocks[i].isReady(queue)) {
+              continue;
+            }
+            char *ptr = blocks[i].ptr;
+            blocks.erase(blocks.begin() + i);
+            cachedBytes -= blockBytes;
+            ++hits;
+            return ptr;
+          }
+        }
+        ++misses;
+        reservedBytes += blockBytes;
+        if (peakReservedBytes < reservedBytes) {
+          peakReservedBytes = reservedBytes;
+        }
+      }
+      return (char*) sys::malloc(blockBytes);
+    }
+
+    void memoryPool_t::release(char *ptr,
+                               const udim_t bytes,
+                               const pendingTicketVector &pendingTickets) {
+      const udim_t blockBytes = sizeClass(bytes);
+
+      block_t block;
+      block.ptr = ptr;
+      block.pendingTickets = pendingTickets;
+
+      {
+        std::lock_guard<std::mutex> lock(mutex);
+        if (!maxCachedBytes
+            || ((cachedBytes + blockBytes) <= maxCachedBytes)) {
+          freeBlocks[blockBytes].push_back(block);
+          cachedBytes += blockBytes;
+          return;
+        }
+        reservedBytes -= blockBytes;
+      }
+      freeBlock(block);
+    }
+
+    void memoryPool_t::detach(const udim_t bytes) {
+      std::lock_guard<std::mutex> lock(mutex);
+      reservedBytes -= sizeClass(bytes);
+    }
+
+    void memoryPool_t::trim() {
+      std::map<udim_t, blockVector> blocksToFree;
+      {
+        std::lock_guard<std::mutex> lock(mutex);
+        blocksToFree.swap(freeBlocks);
+        reservedBytes -= cachedBytes;
+        cachedBytes = 0;
+      }
+
+      for (auto &it : blocksToFree) {
+        for (block_t &block : it.second) {
+          freeBlock(block);
+        }
+      }
+    }
+
+    occa::json memoryPool_t::info() {
+      std::lock_guard<std::mutex> lock(mutex);
+      occa::json info;
+      info["enabled"] = true;
+      info["cached_bytes"] = cachedBytes;
+      info["reserved_bytes"] = reservedBytes;
+      info["peak_reserved_bytes"] = peakReservedBytes;
+      info["max_cached_bytes"] = maxCachedBytes;
+      info["hits"] = hits;
+      info["misses"] = misses;
+      return info;
+    }
+
+    void memoryPool_t::freeBlock(block_t &block) {
+      // Queued work could still be using the block
+      for (pendingTicket_t &pending : block.pendingTickets) {
+        pending.queue->waitForTicket(pending.ticket);
+      }
+      sys::free(block.ptr);
+    }
+  }
+}
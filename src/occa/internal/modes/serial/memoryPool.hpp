@@ -0,0 +1,84 @@
+#ifndef OCCA_INTERNAL_MODES_SERIAL_MEMORYPOOL_HEADER
+#define OCCA_INTERNAL_MODES_SERIAL_MEMORYPOOL_HEADER
+
+#include <map>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+#include <occa/defines.hpp>
+#include <occa/types.hpp>
+#include <occa/types/json.hpp>
+
+namespace occa {
+  namespace serial {
+    class streamQueue_t;
+
+    // Work queued on an asynchronous stream when a block was released
+    class pendingTicket_t {
+     public:
+      std::shared_ptr<streamQueue_t> queue;
+      udim_t ticket;
+
+      pendingTicket_t(std::shared_ptr<streamQueue_t> queue_,
+                      const udim_t ticket_);
+    };
+
+    typedef std::vector<pendingTicket_t> pendingTicketVector;
+
+    // Caches released host allocations by size class.
+    // A cached block is reused once the stream work queued before its release
+    //   has finished, or right away by work queued on that same stream.
+    class memoryPool_t {
+     private:
+      class block_t {
+       public:
+        char *ptr;
+        pendingTicketVector pendingTickets;
+
+        bool isReady(const streamQueue_t *queue) const;
+      };
+
+      typedef std::vector<block_t> blockVector;
+
+      std::mutex mutex;
+      std::map<udim_t, blockVector> freeBlocks;
+
+      udim_t maxCachedBytes;
+      udim_t cachedBytes;
+      udim_t reservedBytes;
+      udim_t peakReservedBytes;
+      udim_t hits;
+      udim_t misses;
+
+     public:
+      // A [maxCachedBytes_] of 0 doesn't limit the cached bytes
+      memoryPool_t(const udim_t maxCachedBytes_);
+      ~memoryPool_t();
+
+      // Rounds [bytes] up to its size class, wasting at most 25%
+      static udim_t sizeClass(const udim_t bytes);
+
+      // Allocates a block of sizeClass(bytes) bytes
+      char* allocate(const udim_t bytes,
+                     const streamQueue_t *queue);
+
+      void release(char *ptr,
+                   const udim_t bytes,
+                   const pendingTicketVector &pendingTickets);
+
+      // Stops counting an allocated block which is now owned by someone else
+      void detach(const udim_t bytes);
+
+      // Frees every cached block
+      void trim();
+
+      occa::json info();
+
+     private:
+      void freeBlock(block_t &block);
+    };
+  }
+}
+
+#endif
@@ -1,14 +1,39 @@
 #include <occa/defines.hpp>
 
 #include <occa/internal/modes/serial/streamTag.hpp>
+#include <occa/internal/utils/sys.hpp>
 
 namespace occa {
   namespace serial {
     streamTag::streamTag(modeDevice_t *modeDevice_,
                          double time_) :
       modeStreamTag_t(modeDevice_),
-      time(time_) {}
+      time(std::make_shared<double>(time_)),
+      ticket(0) {}
+
+    streamTag::streamTag(modeDevice_t *modeDevice_,
+                         std::shared_ptr<streamQueue_t> queue_) :
+      modeStreamTag_t(modeDevice_),
+      time(std::make_shared<double>(0)),
+      queue(queue_) {
+      // Stamp the time when the executor reaches the tag
+      std::shared_ptr<double> time_ = time;
+      ticket = queue->enqueue([time_]() {
+        *time_ = sys::currentTime();
+      });
+    }
 
     streamTag::~streamTag() {}
+
+    void streamTag::wait() {
+      if (queue) {
+        queue->waitFor(ticket);
+      }
+    }
+
+    double streamTag::getTime() {
+      wait();
+      return *time;
+    }
   }
 }
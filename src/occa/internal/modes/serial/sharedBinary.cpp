@@ -0,0 +1,96 @@
+#include <map>
+#include <mutex>
+
+#include <occa/internal/io.hpp>
+#include <occa/internal/modes/serial/sharedBinary.hpp>
+
+namespace occa {
+  namespace serial {
+    typedef std::map<std::string, sharedBinary_t*> sharedBinaryMap;
+
+    static std::mutex sharedBinaryMutex;
+
+    // Never freed so kernels released during static destruction are safe
+    static sharedBinaryMap& sharedBinaries() {
+      static sharedBinaryMap *binaries = new sharedBinaryMap();
+      return *binaries;
+    }
+
+    sharedBinary_t::sharedBinary_t(const std::string &filename_) :
+      filename(filename_),
+      dlHandle(NULL),
+      refs(0),
+      hasMetadata(false) {}
+
+    bool isSharedBinaryLoaded(const std::string &filename) {
+      std::lock_guard<std::mutex> lock(sharedBinaryMutex);
+      sharedBinaryMap &binaries = sharedBinaries();
+      return binaries.find(filename) != binaries.end();
+    }
+
+    sharedBinary_t* loadSharedBinary(const std::string &filename) {
+      std::lock_guard<std::mutex> lock(sharedBinaryMutex);
+      sharedBinaryMap &binaries = sharedBinaries();
+
+      sharedBinaryMap::iterator it = binaries.find(filename);
+      if (it != binaries.end()) {
+        ++(it->second->refs);
+        return it->second;
+      }
+
+      // dlopen throws on failure, nothing is registered in that case
+      void *dlHandle = sys::dlopen(filename);
+
+      sharedBinary_t *binary = new sharedBinary_t(filename);
+      binary->dlHandle = dlHandle;
+      binary->refs = 1;
+      binaries[filename] = binary;
+
+      return binary;
+    }
+
+    void releaseSharedBinary(sharedBinary_t *binary) {
+      if (!binary) {
+        return;
+      }
+
+      std::lock_guard<std::mutex> lock(sharedBinaryMutex);
+      if (--(binary->refs) > 0) {
+        return;
+      }
+
+      sharedBinaries().erase(binary->filename);
+      sys::dlclose(binary->dlHandle);
+      delete binary;
+    }
+
+    void setSharedBinaryMetadata(sharedBinary_t *binary,
+                                 const lang::sourceMetadata_t &metadata) {
+      std::lock_guard<std::mutex> lock(sharedBinaryMutex);
+      if (!binary->hasMetadata) {
+        binary->metadata = metadata;
+        binary->hasMetadata = true;
+      }
+    }
+
+    lang::kernelMetadata_t getSharedBinaryMetadata(sharedBinary_t *binary,
+                                                   const std::string &buildFile,
+                                                   const std::string &kernelName) {
+      std::lock_guard<std::mutex> lock(sharedBinaryMutex);
+      if (!binary->hasMetadata) {
+        if (!io::isFile(buildFile)) {
+          return lang::kernelMetadata_t();
+        }
+        binary->metadata = lang::sourceMetadata_t::fromBuildFile(buildFile);
+        binary->hasMetadata = true;
+      }
+
+      lang::kernelMetadataMap &kernelsMetadata = binary->metadata.kernelsMetadata;
+      lang::kernelMetadataMap::iterator it = kernelsMetadata.find(kernelName);
+      if (it == kernelsMetadata.end()) {
+        return lang::kernelMetadata_t();
+      }
+      return it->second;
+    }
+  }
+}
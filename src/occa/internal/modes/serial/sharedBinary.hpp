@@ -0,0 +1,45 @@
+#ifndef OCCA_INTERNAL_MODES_SERIAL_SHAREDBINARY_HEADER
+#define OCCA_INTERNAL_MODES_SERIAL_SHAREDBINARY_HEADER
+
+#include <occa/defines.hpp>
+#include <occa/internal/lang/kernelMetadata.hpp>
+#include <occa/internal/utils/sys.hpp>
+
+namespace occa {
+  namespace serial {
+    // A compiled binary holds every @kernel of its source file.
+    // Binaries are loaded once per process and shared by all kernels
+    //   built from them, siblings only need a dlsym on the open handle.
+    class sharedBinary_t {
+     public:
+      std::string filename;
+      void *dlHandle;
+      int refs;
+
+      bool hasMetadata;
+      lang::sourceMetadata_t metadata;
+
+      sharedBinary_t(const std::string &filename_);
+    };
+
+    // Returns true if [filename] is currently loaded
+    bool isSharedBinaryLoaded(const std::string &filename);
+
+    // Loads [filename] the first time and adds a reference to it
+    sharedBinary_t* loadSharedBinary(const std::string &filename);
+
+    // Removes a reference and closes the binary once unused
+    void releaseSharedBinary(sharedBinary_t *binary);
+
+    // Stores the metadata of every kernel in the binary
+    void setSharedBinaryMetadata(sharedBinary_t *binary,
+                                 const lang::sourceMetadata_t &metadata);
+
+    // Loads the metadata of [kernelName], reading the build file only once
+    lang::kernelMetadata_t getSharedBinaryMetadata(sharedBinary_t *binary,
+                                                   const std::string &buildFile,
+                                                   const std::string &kernelName);
+  }
+}
+
+#endif
@@ -1,11 +1,161 @@
+#include <occa/internal/modes/serial/device.hpp>
 #include <occa/internal/modes/serial/stream.hpp>
 
 namespace occa {
   namespace serial {
+    //---[ Stream Queue ]---------------
+    streamQueue_t::streamQueue_t() :
+      queuedTasks(0),
+      finishedTasks(0),
+      stopping(false) {
+      thread = std::thread(&streamQueue_t::executorLoop, this);
+    }
+
+    streamQueue_t::~streamQueue_t() {
+      stop();
+    }
+
+    udim_t streamQueue_t::enqueue(const streamTask_t &task) {
+      udim_t ticket;
+      {
+        std::lock_guard<std::mutex> lock(mutex);
+        tasks.push_back(task);
+        ticket = ++queuedTasks;
+      }
+      taskCondition.notify_one();
+      return ticket;
+    }
+
+    void streamQueue_t::waitFor(const udim_t ticket) {
+      std::unique_lock<std::mutex> lock(mutex);
+      waitForTicket(lock, ticket);
+
+      if (error) {
+        std::exception_ptr error_ = error;
+        error = NULL;
+        std::rethrow_exception(error_);
+      }
+    }
+
+    void streamQueue_t::finish() {
+      waitFor(lastTicket());
+    }
+
+    void streamQueue_t::drain() {
+      waitForTicket(lastTicket());
+    }
+
+    udim_t streamQueue_t::lastTicket() {
+      std::lock_guard<std::mutex> lock(mutex);
+      return queuedTasks;
+    }
+
+    bool streamQueue_t::hasFinished(const udim_t ticket) {
+      std::lock_guard<std::mutex> lock(mutex);
+      return finishedTasks >= ticket;
+    }
+
+    void streamQueue_t::waitForTicket(const udim_t ticket) {
+      std::unique_lock<std::mutex> lock(mutex);
+      waitForTicket(lock, ticket);
+    }
+
+    void streamQueue_t::waitForTicket(std::unique_lock<std::mutex> &lock,
+                                      const udim_t ticket) {
+      doneCondition.wait(lock, [&] {
+        return finishedTasks >= ticket;
+      });
+    }
+
+    void streamQueue_t::stop() {
+      {
+        std::lock_guard<std::mutex> lock(mutex);
+        if (stopping) {
+          return;
+        }
+        stopping = true;
+      }
+      taskCondition.notify_one();
+      thread.join();
+    }
+
+    void streamQueue_t::executorLoop() {
+      while (true) {
+        streamTask_t task;
+        {
+          std::unique_lock<std::mutex> lock(mutex);
+          taskCondition.wait(lock, [&] {
+            return stopping || tasks.size();
+          });
+          if (!tasks.size()) {
+            return;
+          }
+          task = tasks.front();
+          tasks.pop_front();
+        }
+
+        std::exception_ptr taskError;
+        try {
+          task();
+        } catch (...) {
+          taskError = std::current_exception();
+        }
+
+        {
+          std::lock_guard<std::mutex> lock(mutex);
+          if (taskError && !error) {
+            error = taskError;
+          }
+          ++finishedTasks;
+        }
+        doneCondition.notify_all();
+      }
+    }
+    //==================================
+
+    //---[ Stream ]---------------------
     stream::stream(modeDevice_t *modeDevice_,
                    const occa::json &properties_) :
-      modeStream_t(modeDevice_, properties_) {}
+      modeStream_t(modeDevice_, properties_) {
+      if (properties.get("async", false)) {
+        queue = std::make_shared<streamQueue_t>();
+        ((device*) modeDevice)->addAsyncStream(this);
+      }
+    }
+
+    stream::~stream() {
+      if (queue) {
+        // Tags can outlive the stream, only stop the executor
+        queue->stop();
+        if (modeDevice) {
+          ((device*) modeDevice)->removeAsyncStream(this);
+        }
+      }
+    }
+
+    bool stream::isAsync() const {
+      return (bool) queue;
+    }
+
+    void stream::enqueue(const streamTask_t &task) {
+      if (queue) {
+        queue->enqueue(task);
+      } else {
+        task();
+      }
+    }
+
+    void stream::finish() {
+      if (queue) {
+        queue->finish();
+      }
+    }
 
-    stream::~stream() {}
+    void stream::drain() {
+      if (queue) {
+        queue->drain();
+      }
+    }
+    //==================================
   }
 }
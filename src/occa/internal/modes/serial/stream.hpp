@@ -1,17 +1,82 @@
 #ifndef OCCA_INTERNAL_MODES_SERIAL_STREAM_HEADER
 #define OCCA_INTERNAL_MODES_SERIAL_STREAM_HEADER
 
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+
 #include <occa/defines.hpp>
 #include <occa/internal/core/stream.hpp>
 
 namespace occa {
   namespace serial {
+    typedef std::function<void ()> streamTask_t;
+
+    // Runs tasks in submission order on its own executor thread
+    class streamQueue_t {
+     private:
+      std::thread thread;
+      std::mutex mutex;
+      std::condition_variable taskCondition;
+      std::condition_variable doneCondition;
+
+      std::deque<streamTask_t> tasks;
+      udim_t queuedTasks;
+      udim_t finishedTasks;
+      bool stopping;
+
+      // First error thrown by a task, rethrown when the queue is waited on
+      std::exception_ptr error;
+
+     public:
+      streamQueue_t();
+      ~streamQueue_t();
+
+      // Returns a ticket that can be waited on
+      udim_t enqueue(const streamTask_t &task);
+
+      void waitFor(const udim_t ticket);
+      void finish();
+
+      // Waits for the queued tasks, keeping errors for the next wait
+      void drain();
+
+      udim_t lastTicket();
+      bool hasFinished(const udim_t ticket);
+
+      // Same as waitFor() but keeps errors for the next wait
+      void waitForTicket(const udim_t ticket);
+
+      // Runs the remaining tasks and joins the executor thread
+      void stop();
+
+     private:
+      void waitForTicket(std::unique_lock<std::mutex> &lock,
+                         const udim_t ticket);
+
+      void executorLoop();
+    };
+
     class stream : public occa::modeStream_t {
-    public:
+     public:
+      std::shared_ptr<streamQueue_t> queue;
+
       stream(modeDevice_t *modeDevice_,
              const occa::json &properties_);
 
       virtual ~stream();
+
+      bool isAsync() const;
+
+      // Runs [task] right away unless the stream is asynchronous
+      void enqueue(const streamTask_t &task);
+
+      void finish();
+      void drain();
     };
   }
 }
@@ -3,18 +3,31 @@
 #ifndef OCCA_INTERNAL_MODES_SERIAL_STREAMTAG_HEADER
 #define OCCA_INTERNAL_MODES_SERIAL_STREAMTAG_HEADER
 
+#include <memory>
+
 #include <occa/internal/core/streamTag.hpp>
+#include <occa/internal/modes/serial/stream.hpp>
 
 namespace occa {
   namespace serial {
     class streamTag : public occa::modeStreamTag_t {
     public:
-      double time;
+      // Set once the tasks queued before the tag have finished
+      std::shared_ptr<double> time;
+
+      std::shared_ptr<streamQueue_t> queue;
+      udim_t ticket;
 
       streamTag(modeDevice_t *modeDevice_,
                 double time_);
 
+      streamTag(modeDevice_t *modeDevice_,
+                std::shared_ptr<streamQueue_t> queue_);
+
       virtual ~streamTag();
+
+      void wait();
+      double getTime();
     };
   }
 }
@@ -0,0 +1,88 @@
+#include <occa/internal/io.hpp>
+#include <occa/internal/lang/modes/threads.hpp>
+#include <occa/internal/modes/threads/device.hpp>
+#include <occa/internal/modes/threads/kernel.hpp>
+
+namespace occa {
+  namespace threads {
+    device::device(const occa::json &properties_) :
+      serial::device(properties_),
+      threadPool(NULL) {
+
+      threadCount = properties.get("threads", 0);
+      if (threadCount <= 0) {
+        threadCount = (int) std::thread::hardware_concurrency();
+      }
+      if (threadCount <= 0) {
+        threadCount = 1;
+      }
+
+      chunkSize = properties.get("chunk", 0);
+      OCCA_ERROR("[chunk] can't be negative, found [" << chunkSize << "]",
+                 chunkSize >= 0);
+    }
+
+    device::~device() {
+      delete threadPool;
+    }
+
+    hash_t device::hash() const {
+      return (
+        serial::device::hash()
+        ^ occa::hash("threads")
+      );
+    }
+
+    int device::getThreadCount() const {
+      return threadCount;
+    }
+
+    int device::getChunkSize() const {
+      return chunkSize;
+    }
+
+    threadPool_t& device::getThreadPool() {
+      std::lock_guard<std::mutex> lock(threadPoolMutex);
+      if (!threadPool) {
+        threadPool = new threadPool_t(threadCount);
+      }
+      return *threadPool;
+    }
+
+    bool device::parseFile(const std::string &filename,
+                           const std::string &outputFile,
+                           const occa::json &kernelProps,
+                           lang::sourceMetadata_t &metadata) {
+      lang::okl::threadsParser parser(kernelProps);
+      parser.parseFile(filename);
+
+      // Verify if parsing succeeded
+      if (!parser.succeeded()) {
+        OCCA_ERROR("Unable to transform OKL kernel [" << filename << "]",
+                   kernelProps.get("silent", false));
+        return false;
+      }
+
+      if (!io::isFile(outputFile)) {
+        hash_t hash = occa::hash(outputFile);
+        io::lock_t lock(hash, "threads-parser");
+        if (lock.isMine()) {
+          parser.writeToFile(outputFile);
+        }
+      }
+
+      parser.setSourceMetadata(metadata);
+
+      return true;
+    }
+
+    serial::kernel* device::newKernel(const std::string &kernelName,
+                                      const std::string &sourceFilename,
+                                      const occa::json &kernelProps) {
+      return new kernel(this,
+                        kernelName,
+                        sourceFilename,
+                        kernelProps);
+    }
+  }
+}
@@ -0,0 +1,40 @@
+#ifndef OCCA_INTERNAL_MODES_THREADS_DEVICE_HEADER
+#define OCCA_INTERNAL_MODES_THREADS_DEVICE_HEADER
+
+#include <occa/internal/modes/serial/device.hpp>
+#include <occa/internal/modes/threads/threadPool.hpp>
+
+namespace occa {
+  namespace threads {
+    class device : public serial::device {
+    private:
+      int threadCount;
+      int chunkSize;
+      threadPool_t *threadPool;
+      std::mutex threadPoolMutex;
+
+    public:
+      device(const occa::json &properties_);
+      virtual ~device();
+
+      virtual hash_t hash() const;
+
+      int getThreadCount() const;
+      int getChunkSize() const;
+
+      // Worker threads are started on the first kernel launch
+      threadPool_t& getThreadPool();
+
+      virtual bool parseFile(const std::string &filename,
+                             const std::string &outputFile,
+                             const occa::json &kernelProps,
+                             lang::sourceMetadata_t &metadata);
+
+      virtual serial::kernel* newKernel(const std::string &kernelName,
+                                        const std::string &sourceFilename,
+                                        const occa::json &kernelProps);
+    };
+  }
+}
+
+#endif
@@ -0,0 +1,49 @@
+#include <occa/internal/modes/threads/device.hpp>
+#include <occa/internal/modes/threads/kernel.hpp>
+#include <occa/internal/modes/threads/threadPool.hpp>
+
+namespace occa {
+  namespace threads {
+    kernel::kernel(modeDevice_t *modeDevice_,
+                   const std::string &name_,
+                   const std::string &sourceFilename_,
+                   const occa::json &properties_) :
+      serial::kernel(modeDevice_, name_, sourceFilename_, properties_) {}
+
+    void kernel::launch(const kernelArgDataVector &args,
+                        std::vector<void*> &argPtrs) const {
+      // Non-OKL kernels don't take a worker task
+      if (!properties.get("okl/enabled", true)) {
+        serial::kernel::launch(args, argPtrs);
+        return;
+      }
+
+      device &dev = *((device*) modeDevice);
+      threadPool_t &threadPool = dev.getThreadPool();
+      const int workers = threadPool.size();
+
+      // Set arguments, the worker task is passed last
+      const int argc = (int) args.size();
+      argPtrs.resize(workers * (argc + 1));
+      for (int i = 0; i < argc; ++i) {
+        argPtrs[i] = args[i].ptr();
+      }
+      for (int worker = 1; worker < workers; ++worker) {
+        for (int i = 0; i < argc; ++i) {
+          argPtrs[worker * (argc + 1) + i] = argPtrs[i];
+        }
+      }
+
+      launchTask_t launch(workers, dev.getChunkSize());
+      for (int worker = 0; worker < workers; ++worker) {
+        argPtrs[worker * (argc + 1) + argc] = &(launch.tasks[worker]);
+      }
+
+      threadPool.run([&](const int worker) {
+        sys::runFunction(function,
+                         argc + 1,
+                         &(argPtrs[worker * (argc + 1)]));
+      });
+    }
+  }
+}
@@ -0,0 +1,21 @@
+#ifndef OCCA_INTERNAL_MODES_THREADS_KERNEL_HEADER
+#define OCCA_INTERNAL_MODES_THREADS_KERNEL_HEADER
+
+#include <occa/internal/modes/serial/kernel.hpp>
+
+namespace occa {
+  namespace threads {
+    class kernel : public serial::kernel {
+    public:
+      kernel(modeDevice_t *modeDevice_,
+             const std::string &name_,
+             const std::string &sourceFilename_,
+             const occa::json &properties_);
+
+      void launch(const kernelArgDataVector &args,
+                  std::vector<void*> &argPtrs) const;
+    };
+  }
+}
+
+#endif
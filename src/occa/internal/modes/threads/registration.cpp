@@ -0,0 +1,22 @@
+#include <occa/internal/modes/threads/registration.hpp>
+
+namespace occa {
+  namespace threads {
+    threadsMode::threadsMode() :
+        mode_t("Threads") {}
+
+    bool threadsMode::init() {
+      return true;
+    }
+
+    modeDevice_t* threadsMode::newDevice(const occa::json &props) {
+      return new device(setModeProp(props));
+    }
+
+    int threadsMode::getDeviceCount(const occa::json &props) {
+      return 1;
+    }
+
+    threadsMode mode;
+  }
+}
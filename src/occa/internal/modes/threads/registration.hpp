@@ -0,0 +1,25 @@
+#ifndef OCCA_INTERNAL_MODES_THREADS_REGISTRATION_HEADER
+#define OCCA_INTERNAL_MODES_THREADS_REGISTRATION_HEADER
+
+#include <occa/internal/modes.hpp>
+#include <occa/internal/modes/threads/device.hpp>
+#include <occa/core/base.hpp>
+
+namespace occa {
+  namespace threads {
+    class threadsMode : public mode_t {
+    public:
+      threadsMode();
+
+      bool init();
+
+      modeDevice_t* newDevice(const occa::json &props);
+
+      int getDeviceCount(const occa::json &props);
+    };
+
+    extern threadsMode mode;
+  }
+}
+
+#endif
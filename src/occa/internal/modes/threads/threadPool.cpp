@@ -0,0 +1,196 @@
+#include <occa/internal/modes/threads/threadPool.hpp>
+
+namespace occa {
+  namespace threads {
+    //---[ Thread Pool ]----------------
+    threadPool_t::threadPool_t(const int workers) :
+      job(NULL),
+      jobGeneration(0),
+      busyWorkers(0),
+      stopping(false) {
+      for (int worker = 1; worker < workers; ++worker) {
+        threads.push_back(
+          std::thread(&threadPool_t::workerLoop, this, worker)
+        );
+      }
+    }
+
+    threadPool_t::~threadPool_t() {
+      {
+        std::lock_guard<std::mutex> lock(mutex);
+        stopping = true;
+      }
+      jobCondition.notify_all();
+
+      for (std::thread &thread : threads) {
+        thread.join();
+      }
+    }
+
+    int threadPool_t::size() const {
+      return (int) threads.size() + 1;
+    }
+
+    void threadPool_t::run(const workerJob_t &job_) {
+      std::lock_guard<std::mutex> runLock(runMutex);
+
+      {
+        std::lock_guard<std::mutex> lock(mutex);
+        job = &job_;
+        busyWorkers = (int) threads.size();
+        ++jobGeneration;
+      }
+      jobCondition.notify_all();
+
+      job_(0);
+
+      std::unique_lock<std::mutex> lock(mutex);
+      doneCondition.wait(lock, [&] {
+        return busyWorkers == 0;
+      });
+      job = NULL;
+    }
+
+    void threadPool_t::workerLoop(const int worker) {
+      udim_t lastGeneration = 0;
+      while (true) {
+        const workerJob_t *workerJob;
+        {
+          std::unique_lock<std::mutex> lock(mutex);
+          jobCondition.wait(lock, [&] {
+            return stopping || (jobGeneration != lastGeneration);
+          });
+          if (stopping) {
+            return;
+          }
+          lastGeneration = jobGeneration;
+          workerJob = job;
+        }
+
+        (*workerJob)(worker);
+
+        bool isLastWorker;
+        {
+          std::lock_guard<std::mutex> lock(mutex);
+          isLastWorker = (--busyWorkers == 0);
+        }
+        if (isLastWorker) {
+          doneCondition.notify_one();
+        }
+      }
+    }
+    //==================================
+
+    //---[ Outer Loop Scheduler ]-------
+    workerTask_t::workerTask_t() :
+      claim(NULL),
+      launch(NULL),
+      worker(0),
+      inLoop(false) {}
+
+    chunkQueue_t::chunkQueue_t() :
+      next(0),
+      end(0) {}
+
+    launchTask_t::launchTask_t(const int workers_,
+                               const int chunkSize_) :
+      workers(workers_),
+      chunkSize(chunkSize_),
+      arrivedWorkers(0),
+      loopGeneration(0),
+      loopCount(0),
+      loopChunkSize(1),
+      queues(workers_),
+      tasks(workers_) {
+      for (int worker = 0; worker < workers; ++worker) {
+        workerTask_t &task = tasks[worker];
+        task.claim = launchTask_t::claim;
+        task.launch = this;
+        task.worker = worker;
+      }
+    }
+
+    void launchTask_t::startLoop(const int loopCount_) {
+      std::unique_lock<std::mutex> lock(mutex);
+
+      const udim_t generation = loopGeneration;
+      if (++arrivedWorkers < workers) {
+        loopCondition.wait(lock, [&] {
+          return loopGeneration != generation;
+        });
+        return;
+      }
+
+      // Last worker to arrive splits the loop
+      loopCount = (loopCount_ > 0) ? loopCount_ : 0;
+      loopChunkSize = chunkSize;
+      if (loopChunkSize <= 0) {
+        // Enough chunks per worker to balance irregular iterations
+        loopChunkSize = loopCount / (8 * workers);
+        if (loopChunkSize < 1) {
+          loopChunkSize = 1;
+        }
+      }
+
+      const int chunks = (loopCount + loopChunkSize - 1) / loopChunkSize;
+      for (int worker = 0; worker < workers; ++worker) {
+        chunkQueue_t &queue = queues[worker];
+        std::lock_guard<std::mutex> queueLock(queue.mutex);
+        queue.next = (int) (((udim_t) chunks * worker) / workers);
+        queue.end  = (int) (((udim_t) chunks * (worker + 1)) / workers);
+      }
+
+      arrivedWorkers = 0;
+      ++loopGeneration;
+      loopCondition.notify_all();
+    }
+
+    bool launchTask_t::popChunk(chunkQueue_t &queue,
+                                const bool fromBack,
+                                int &chunk) {
+      std::lock_guard<std::mutex> lock(queue.mutex);
+      if (queue.next >= queue.end) {
+        return false;
+      }
+      chunk = fromBack ? --queue.end : queue.next++;
+      return true;
+    }
+
+    bool launchTask_t::claimChunk(const int worker,
+                                  int &begin,
+                                  int &end) {
+      int chunk;
+      bool found = popChunk(queues[worker], false, chunk);
+      for (int i = 1; !found && (i < workers); ++i) {
+        found = popChunk(queues[(worker + i) % workers], true, chunk);
+      }
+      if (!found) {
+        return false;
+      }
+
+      begin = chunk * loopChunkSize;
+      end = begin + loopChunkSize;
+      if (end > loopCount) {
+        end = loopCount;
+      }
+      return true;
+    }
+
+    int launchTask_t::claim(workerTask_t *task,
+                            int loopCount,
+                            int *begin,
+                            int *end) {
+      launchTask_t &launch = *(task->launch);
+      if (!task->inLoop) {
+        launch.startLoop(loopCount);
+        task->inLoop = true;
+      }
+      if (launch.claimChunk(task->worker, *begin, *end)) {
+        return 1;
+      }
+      task->inLoop = false;
+      return 0;
+    }
+    //==================================
+  }
+}
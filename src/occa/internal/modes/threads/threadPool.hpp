@@ -0,0 +1,122 @@
+#ifndef OCCA_INTERNAL_MODES_THREADS_THREADPOOL_HEADER
+#define OCCA_INTERNAL_MODES_THREADS_THREADPOOL_HEADER
+
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include <occa/defines.hpp>
+#include <occa/types.hpp>
+
+namespace occa {
+  namespace threads {
+    typedef std::function<void (const int worker)> workerJob_t;
+
+    // Worker threads live as long as the pool.
+    // The calling thread takes part in every job as worker 0.
+    class threadPool_t {
+     private:
+      std::vector<std::thread> threads;
+
+      std::mutex mutex;
+      std::condition_variable jobCondition;
+      std::condition_variable doneCondition;
+
+      const workerJob_t *job;
+      udim_t jobGeneration;
+      int busyWorkers;
+      bool stopping;
+
+      // Only one job runs at a time
+      std::mutex runMutex;
+
+     public:
+      threadPool_t(const int workers);
+      ~threadPool_t();
+
+      int size() const;
+
+      // Runs [job] on every worker and waits for all of them to finish
+      void run(const workerJob_t &job_);
+
+     private:
+      void workerLoop(const int worker);
+    };
+
+    //---[ Outer Loop Scheduler ]-------
+    class launchTask_t;
+
+    // Passed to the kernel as its [_occa_task] argument,
+    //   [claim] has to be the first member
+    class workerTask_t {
+     public:
+      typedef int (*claimFunction_t)(workerTask_t *task,
+                                     int loopCount,
+                                     int *begin,
+                                     int *end);
+
+      claimFunction_t claim;
+      launchTask_t *launch;
+      int worker;
+      bool inLoop;
+
+      workerTask_t();
+    };
+
+    // Chunks of the current @outer loop owned by a worker
+    class chunkQueue_t {
+     public:
+      std::mutex mutex;
+      int next;
+      int end;
+
+      chunkQueue_t();
+    };
+
+    // Shares the iterations of each outer-most @outer loop between workers.
+    // Each worker starts with a contiguous range of chunks and steals
+    //   from the back of other workers' ranges once it runs out.
+    class launchTask_t {
+     private:
+      int workers;
+      int chunkSize;
+
+      std::mutex mutex;
+      std::condition_variable loopCondition;
+      int arrivedWorkers;
+      udim_t loopGeneration;
+
+      int loopCount;
+      int loopChunkSize;
+      std::vector<chunkQueue_t> queues;
+
+     public:
+      std::vector<workerTask_t> tasks;
+
+      launchTask_t(const int workers_,
+                   const int chunkSize_);
+
+      // Waits for every worker to reach the loop before splitting it into chunks
+      void startLoop(const int loopCount_);
+
+      bool claimChunk(const int worker,
+                      int &begin,
+                      int &end);
+
+      static int claim(workerTask_t *task,
+                       int loopCount,
+                       int *begin,
+                       int *end);
+
+     private:
+      bool popChunk(chunkQueue_t &queue,
+                    const bool fromBack,
+                    int &chunk);
+    };
+    //==================================
+  }
+}
+
+#endif
@@ -0,0 +1,368 @@
+#include <occa/defines.hpp>
+
+#include <cctype>
+#include <condition_variable>
+#include <cstring>
+#include <mutex>
+#include <thread>
+
+#if (OCCA_OS & (OCCA_LINUX_OS | OCCA_MACOS_OS))
+#  include <errno.h>
+#  include <fcntl.h>
+#  include <poll.h>
+#  include <spawn.h>
+#  include <sys/types.h>
+#  include <sys/wait.h>
+#  include <unistd.h>
+
+extern char **environ;
+#endif
+
+#include <occa/types/json.hpp>
+#include <occa/internal/utils/compilerDriver.hpp>
+#include <occa/internal/utils/env.hpp>
+#include <occa/internal/utils/string.hpp>
+#include <occa/internal/utils/sys.hpp>
+
+namespace occa {
+  namespace sys {
+    static std::mutex compileJobMutex;
+    static std::condition_variable compileJobCondition;
+    static int runningCompileJobs = 0;
+
+    //---[ Command Line ]---------------
+    strVector splitCommandLine(const std::string &cmdline) {
+      strVector args;
+      std::string arg;
+      bool hasArg = false;
+      char quote = '\0';
+
+      const char *c = cmdline.c_str();
+      for (; *c != '\0'; ++c) {
+        if (quote) {
+          if (*c == quote) {
+            quote = '\0';
+          } else if ((quote == '"') && (*c == '\\') && c[1]) {
+            arg += *(++c);
+          } else {
+            arg += *c;
+          }
+          continue;
+        }
+
+        if ((*c == '"') || (*c == '\'')) {
+          quote = *c;
+          hasArg = true;
+        } else if ((*c == '\\') && c[1]) {
+          arg += *(++c);
+          hasArg = true;
+        } else if (isspace(*c)) {
+          if (hasArg) {
+            args.push_back(arg);
+            arg.clear();
+            hasArg = false;
+          }
+        } else {
+          arg += *c;
+          hasArg = true;
+        }
+      }
+
+      if (hasArg) {
+        args.push_back(arg);
+      }
+      return args;
+    }
+
+    std::string joinCommandLine(const strVector &args) {
+#if (OCCA_OS == OCCA_WINDOWS_OS)
+      return join(args, " ");
+#else
+      std::string cmdline;
+      for (const std::string &arg : args) {
+        if (cmdline.size()) {
+          cmdline += ' ';
+        }
+
+        const bool needsQuotes = (
+          !arg.size()
+          || (arg.find_first_of(" \t\n'\"\\$") != std::string::npos)
+        );
+        if (!needsQuotes) {
+          cmdline += arg;
+          continue;
+        }
+
+        cmdline += '\'';
+        for (const char c : arg) {
+          if (c == '\'') {
+            cmdline += "'\\''";
+          } else {
+            cmdline += c;
+          }
+        }
+        cmdline += '\'';
+      }
+      return cmdline;
+#endif
+    }
+    //==================================
+
+    //---[ Compile Job ]----------------
+    compileJob_t::compileJob_t() :
+      exitStatus(-1) {}
+
+    compileJob_t::compileJob_t(const strVector &command_) :
+      command(command_),
+      exitStatus(-1) {}
+
+    bool compileJob_t::succeeded() const {
+      return exitStatus == 0;
+    }
+
+    std::string compileJob_t::commandString() const {
+      return joinCommandLine(command);
+    }
+    //==================================
+
+    //---[ Process Helpers ]------------
+#if (OCCA_OS & (OCCA_LINUX_OS | OCCA_MACOS_OS))
+    static bool createOutputPipe(int fds[2]) {
+#if (OCCA_OS == OCCA_LINUX_OS)
+      return ::pipe2(fds, O_CLOEXEC) == 0;
+#else
+      if (::pipe(fds) != 0) {
+        return false;
+      }
+      ::fcntl(fds[0], F_SETFD, FD_CLOEXEC);
+      ::fcntl(fds[1], F_SETFD, FD_CLOEXEC);
+      return true;
+#endif
+    }
+
+    // Returns the read end of the child's stdout/stderr pipe or -1 on failure
+    static int spawnCompileJob(compileJob_t &job, pid_t &pid) {
+      job.output.clear();
+      job.exitStatus = -1;
+
+      if (!job.command.size()) {
+        job.output = "Empty compiler command";
+        return -1;
+      }
+
+      int fds[2];
+      if (!createOutputPipe(fds)) {
+        job.output = "Unable to create compiler output pipe: ";
+        job.output += strerror(errno);
+        return -1;
+      }
+
+      posix_spawn_file_actions_t actions;
+      posix_spawn_file_actions_init(&actions);
+      posix_spawn_file_actions_adddup2(&actions, fds[1], STDOUT_FILENO);
+      posix_spawn_file_actions_adddup2(&actions, fds[1], STDERR_FILENO);
+
+      std::vector<char*> argv;
+      argv.reserve(job.command.size() + 1);
+      for (const std::string &arg : job.command) {
+        argv.push_back(const_cast<char*>(arg.c_str()));
+      }
+      argv.push_back(NULL);
+
+      const int error = ::posix_spawnp(&pid,
+                                       argv[0],
+                                       &actions,
+                                       NULL,
+                                       &(argv[0]),
+                                       environ);
+
+      posix_spawn_file_actions_destroy(&actions);
+      ::close(fds[1]);
+
+      if (error) {
+        ::close(fds[0]);
+        job.output = "Unable to execute [" + job.command[0] + "]: ";
+        job.output += strerror(error);
+        job.exitStatus = 127;
+        return -1;
+      }
+
+      return fds[0];
+    }
+
+    // Returns false once the pipe is closed
+    static bool readCompileOutput(const int fd, std::string &output) {
+      char buffer[4096];
+      while (true) {
+        const ssize_t bytes = ::read(fd, buffer, sizeof(buffer));
+        if (bytes > 0) {
+          output.append(buffer, bytes);
+          return true;
+        }
+        if (bytes < 0 && errno == EINTR) {
+          continue;
+        }
+        return false;
+      }
+    }
+
+    static void waitForCompileJob(compileJob_t &job, const pid_t pid) {
+      int status = 0;
+      while (::waitpid(pid, &status, 0) < 0) {
+        if (errno != EINTR) {
+          job.exitStatus = -1;
+          return;
+        }
+      }
+
+      if (WIFEXITED(status)) {
+        job.exitStatus = WEXITSTATUS(status);
+      } else if (WIFSIGNALED(status)) {
+        job.exitStatus = 128 + WTERMSIG(status);
+      } else {
+        job.exitStatus = -1;
+      }
+    }
+#endif
+    //==================================
+
+    //---[ Compiler Driver ]------------
+    compilerDriver_t::compilerDriver_t() {}
+
+    int compilerDriver_t::defaultMaxJobs() {
+      const int envJobs = env::get<int>("OCCA_COMPILER_JOBS", 0);
+      if (envJobs > 0) {
+        return envJobs;
+      }
+      const int cores = (int) std::thread::hardware_concurrency();
+      return (cores > 0) ? cores : 1;
+    }
+
+    int compilerDriver_t::getMaxJobs(const occa::json &props) {
+      const int propJobs = props.get<int>("compiler_jobs", 0);
+      if (propJobs > 0) {
+        return propJobs;
+      }
+      return defaultMaxJobs();
+    }
+
+    void compilerDriver_t::acquireJob(const int maxJobs) {
+      std::unique_lock<std::mutex> lock(compileJobMutex);
+      compileJobCondition.wait(lock, [&] {
+        return runningCompileJobs < maxJobs;
+      });
+      ++runningCompileJobs;
+    }
+
+    void compilerDriver_t::releaseJob() {
+      {
+        std::lock_guard<std::mutex> lock(compileJobMutex);
+        --runningCompileJobs;
+      }
+      compileJobCondition.notify_all();
+    }
+
+    int compilerDriver_t::activeJobs() const {
+      std::lock_guard<std::mutex> lock(compileJobMutex);
+      return runningCompileJobs;
+    }
+
+    void compilerDriver_t::run(compileJob_t &job,
+                               const int maxJobs) {
+      compileJobVector jobs(1, &job);
+      run(jobs, maxJobs);
+    }
+
+    void compilerDriver_t::run(compileJobVector &jobs,
+                               const int maxJobs) {
+      const int jobCount = (int) jobs.size();
+      if (!jobCount) {
+        return;
+      }
+
+#if (OCCA_OS & (OCCA_LINUX_OS | OCCA_MACOS_OS))
+      std::vector<pollfd> pollFds;
+      std::vector<int> pollJobs;
+      std::vector<pid_t> pids(jobCount, -1);
+
+      int nextJob = 0;
+      while ((nextJob < jobCount) || pollFds.size()) {
+        // Start as many jobs as the process-wide limit allows
+        while (nextJob < jobCount) {
+          if (pollFds.size()) {
+            std::lock_guard<std::mutex> lock(compileJobMutex);
+            if (runningCompileJobs >= maxJobs) {
+              break;
+            }
+            ++runningCompileJobs;
+          } else {
+            // Nothing to poll on so block until a slot frees up
+            acquireJob(maxJobs);
+          }
+
+          compileJob_t &job = *(jobs[nextJob]);
+          const int fd = spawnCompileJob(job, pids[nextJob]);
+          if (fd < 0) {
+            releaseJob();
+          } else {
+            pollfd pfd;
+            pfd.fd = fd;
+            pfd.events = POLLIN;
+            pfd.revents = 0;
+            pollFds.push_back(pfd);
+            pollJobs.push_back(nextJob);
+          }
+          ++nextJob;
+        }
+
+        if (!pollFds.size()) {
+          continue;
+        }
+
+        if (::poll(&(pollFds[0]), pollFds.size(), -1) < 0) {
+          if (errno == EINTR) {
+            continue;
+          }
+          OCCA_FORCE_ERROR("Error waiting on compiler output: " << strerror(errno));
+        }
+
+        for (int i = (int) pollFds.size() - 1; i >= 0; --i) {
+          if (!pollFds[i].revents) {
+            continue;
+          }
+
+          const int jobIndex = pollJobs[i];
+          compileJob_t &job = *(jobs[jobIndex]);
+          if (readCompileOutput(pollFds[i].fd, job.output)) {
+            pollFds[i].revents = 0;
+            continue;
+          }
+
+          // Pipe closed, the compiler is done writing
+          ::close(pollFds[i].fd);
+          waitForCompileJob(job, pids[jobIndex]);
+          releaseJob();
+
+          pollFds.erase(pollFds.begin() + i);
+          pollJobs.erase(pollJobs.begin() + i);
+        }
+      }
+#else
+      for (int i = 0; i < jobCount; ++i) {
+        compileJob_t &job = *(jobs[i]);
+
+        acquireJob(maxJobs);
+        job.exitStatus = sys::call("\"" + job.commandString() + " 2>&1\"",
+                                   job.output);
+        releaseJob();
+      }
+#endif
+    }
+
+    compilerDriver_t& compilerDriver() {
+      static compilerDriver_t driver;
+      return driver;
+    }
+    //==================================
+  }
+}
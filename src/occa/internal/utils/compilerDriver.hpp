@@ -0,0 +1,64 @@
+#ifndef OCCA_INTERNAL_UTILS_COMPILERDRIVER_HEADER
+#define OCCA_INTERNAL_UTILS_COMPILERDRIVER_HEADER
+
+#include <vector>
+
+#include <occa/defines.hpp>
+#include <occa/types.hpp>
+#include <occa/types/json.hpp>
+
+namespace occa {
+  namespace sys {
+    // Splits a shell-style command line into arguments, honoring
+    //   single quotes, double quotes and backslash escapes
+    strVector splitCommandLine(const std::string &cmdline);
+
+    std::string joinCommandLine(const strVector &args);
+
+    class compileJob_t {
+     public:
+      strVector command;
+      std::string output;
+      int exitStatus;
+
+      compileJob_t();
+      compileJob_t(const strVector &command_);
+
+      bool succeeded() const;
+
+      std::string commandString() const;
+    };
+
+    typedef std::vector<compileJob_t*> compileJobVector;
+
+    // Runs compiler processes directly through posix_spawn rather than
+    //   forking a shell through system(). The stdout/stderr output of each
+    //   compile is captured into the job rather than printed to the terminal.
+    //
+    // The job limit is process-wide, so concurrent callers never run more
+    //   than [maxJobs] compiler processes at the same time.
+    class compilerDriver_t {
+     public:
+      compilerDriver_t();
+
+      static int defaultMaxJobs();
+      static int getMaxJobs(const occa::json &props);
+
+      void run(compileJob_t &job,
+               const int maxJobs = defaultMaxJobs());
+
+      void run(compileJobVector &jobs,
+               const int maxJobs = defaultMaxJobs());
+
+      int activeJobs() const;
+
+     private:
+      void acquireJob(const int maxJobs);
+      void releaseJob();
+    };
+
+    compilerDriver_t& compilerDriver();
+  }
+}
+
+#endif
@@ -32,6 +32,7 @@
 #  include <windows.h>
 #endif
 
+#include <algorithm>
 #include <iomanip>
 #include <sstream>
 
@@ -49,6 +50,7 @@
 #include <occa/internal/utils/misc.hpp>
 #include <occa/internal/utils/string.hpp>
 #include <occa/internal/utils/sys.hpp>
+#include <occa/internal/utils/topology.hpp>
 #include <occa/internal/utils/vector.hpp>
 
 namespace occa {
@@ -408,8 +410,8 @@ namespace occa {
     }
 
     void pinToCore(const int core) {
-      sys::SystemInfo info = sys::SystemInfo::load();
-      const int coreCount = info.processor.coreCount;
+      // Cores are pinned by their logical CPU index
+      const int coreCount = topology_t::get()->cpuCount();
 
 #if OCCA_UNSAFE
       ignoreResult(coreCount);
@@ -494,12 +496,37 @@ namespace occa {
     }
 
     SystemInfo SystemInfo::load() {
+#if (OCCA_OS & OCCA_LINUX_OS)
+      // Avoid running lscpu, the topology is read from /sys and cached
+      SystemInfo info = fromTopology(*topology_t::get());
+      // Available memory changes over time, so it isn't taken from the cache
+      info.memory.available = availableMemory();
+      return info;
+#else
       json systemInfo = getSystemInfo();
       SystemInfo info;
 
       info.setProcessorInfo(systemInfo);
       info.setMemoryInfo(systemInfo);
 
+      return info;
+#endif
+    }
+
+    SystemInfo SystemInfo::fromTopology(const topology_t &topology) {
+      SystemInfo info;
+
+      info.processor.name = topology.processorName;
+      info.processor.frequency = topology.frequency;
+      info.processor.coreCount = topology.coreCount;
+      info.processor.cache.l1d = topology.cacheSize(CacheLevel::L1D);
+      info.processor.cache.l1i = topology.cacheSize(CacheLevel::L1I);
+      info.processor.cache.l2  = topology.cacheSize(CacheLevel::L2);
+      info.processor.cache.l3  = topology.cacheSize(CacheLevel::L3);
+
+      info.memory.total = topology.totalMemory;
+      info.memory.available = topology.availableMemory;
+
       return info;
     }
 
@@ -530,7 +557,13 @@ namespace occa {
 
     int SystemInfo::getCoreCount(const json &systemInfo) {
 #if   (OCCA_OS & OCCA_LINUX_OS)
-      return getSystemInfoField(systemInfo, "Model name");
+      const int coresPerSocket = parseInt(
+        (std::string) getSystemInfoField(systemInfo, "Core(s) per socket")
+      );
+      const int sockets = parseInt(
+        (std::string) getSystemInfoField(systemInfo, "Socket(s)")
+      );
+      return coresPerSocket * std::max(sockets, 1);
 #elif (OCCA_OS == OCCA_MACOS_OS)
       return getSystemInfoField(systemInfo, "hw.physicalcpu");
 #elif (OCCA_OS == OCCA_WINDOWS_OS)
@@ -545,7 +578,7 @@ namespace occa {
       const float frequency = parseFloat(
         getSystemInfoField(systemInfo, "CPU max MHz")
       );
-      return (udim_t) (frequency * 1e3);
+      return (udim_t) (frequency * 1e6);
 
 #elif (OCCA_OS == OCCA_MACOS_OS)
       const float frequency = parseFloat(
@@ -673,6 +706,12 @@ namespace occa {
 
     udim_t SystemInfo::availableMemory() {
 #if   (OCCA_OS & OCCA_LINUX_OS)
+      // Includes reclaimable page cache, unlike sysinfo's freeram
+      const udim_t bytes = topology_t::readAvailableMemory();
+      if (bytes) {
+        return bytes;
+      }
+
       struct sysinfo info;
 
       const int error = sysinfo(&info);
@@ -681,7 +720,7 @@ namespace occa {
         return 0;
       }
 
-      return info.freeram;
+      return ((udim_t) info.freeram) * info.mem_unit;
 #elif (OCCA_OS == OCCA_MACOS_OS)
       mach_msg_type_number_t infoCount = HOST_VM_INFO_COUNT;
       mach_port_t hostPort = mach_host_self();
@@ -851,6 +890,21 @@ namespace occa {
       return "";
     }
 
+    std::string compilerOpenMPSimdFlags(const std::string &compiler) {
+      return compilerOpenMPSimdFlags( sys::compilerVendor(compiler) );
+    }
+
+    std::string compilerOpenMPSimdFlags(const int vendor_) {
+      if (vendor_ & (sys::vendor::GNU  |
+                     sys::vendor::LLVM |
+                     sys::vendor::PPC)) {
+        return "-fopenmp-simd";
+      } else if (vendor_ & sys::vendor::Intel) {
+        return "-qopenmp-simd";
+      }
+      return "";
+    }
+
     void addCompilerIncludeFlags(std::string &compilerFlags) {
       strVector includeDirs = env::OCCA_INCLUDE_PATH;
 
@@ -99,6 +99,8 @@ namespace occa {
       MemoryInfo();
     };
 
+    class topology_t;
+
     class SystemInfo {
      public:
       ProcessorInfo processor;
@@ -110,6 +112,8 @@ namespace occa {
       static SystemInfo load();
 
      private:
+      static SystemInfo fromTopology(const topology_t &topology);
+
       static json parseSystemInfoContent(const std::string &content);
       static json getSystemInfoField(const json &systemInfo,
                                      const std::string &field);
@@ -143,6 +147,11 @@ namespace occa {
     std::string compilerSharedBinaryFlags(const std::string &compiler);
     std::string compilerSharedBinaryFlags(const int vendor_);
 
+    // Enables [#pragma omp simd] without linking the OpenMP runtime
+    // Returns an empty string if the compiler has no such flag
+    std::string compilerOpenMPSimdFlags(const std::string &compiler);
+    std::string compilerOpenMPSimdFlags(const int vendor_);
+
     void addCompilerIncludeFlags(std::string &compilerFlags);
     void addCompilerLibraryFlags(std::string &compilerFlags);
 
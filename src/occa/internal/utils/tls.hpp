@@ -18,6 +18,10 @@ namespace occa {
   private:
 #if (OCCA_OS & (OCCA_LINUX_OS | OCCA_MACOS_OS))
     pthread_key_t pkey;
+    // Threads get a copy of the initial value on their first access
+    TM initialValue;
+
+    static void deleteValue(void *ptr);
 #else
     thread_local TM value_;
 #endif
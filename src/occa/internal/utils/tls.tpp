@@ -1,8 +1,19 @@
 namespace occa {
+#if (OCCA_OS & (OCCA_LINUX_OS | OCCA_MACOS_OS))
+  template <class TM>
+  void tls<TM>::deleteValue(void *ptr) {
+    delete (TM*) ptr;
+  }
+#endif
+
   template <class TM>
-  tls<TM>::tls(const TM &val) {
+  tls<TM>::tls(const TM &val)
 #if (OCCA_OS & (OCCA_LINUX_OS | OCCA_MACOS_OS))
-    pthread_key_create(&pkey, NULL);
+    : initialValue(val)
+#endif
+  {
+#if (OCCA_OS & (OCCA_LINUX_OS | OCCA_MACOS_OS))
+    pthread_key_create(&pkey, deleteValue);
     pthread_setspecific(pkey, new TM(val));
 #else
     value_ = val;
@@ -11,9 +22,13 @@ namespace occa {
 
   template <class TM>
   template <class TM2>
-  tls<TM>::tls(const tls<TM2> &t) {
+  tls<TM>::tls(const tls<TM2> &t)
+#if (OCCA_OS & (OCCA_LINUX_OS | OCCA_MACOS_OS))
+    : initialValue(t.value())
+#endif
+  {
 #if (OCCA_OS & (OCCA_LINUX_OS | OCCA_MACOS_OS))
-    pthread_key_create(&pkey, NULL);
+    pthread_key_create(&pkey, deleteValue);
     pthread_setspecific(pkey, new TM(t.value()));
 #else
     value_ = t.value_;
@@ -56,7 +71,12 @@ namespace occa {
   template <class TM>
   TM& tls<TM>::value() {
 #if (OCCA_OS & (OCCA_LINUX_OS | OCCA_MACOS_OS))
-    return *((TM*) pthread_getspecific(pkey));
+    TM *ptr = (TM*) pthread_getspecific(pkey);
+    if (!ptr) {
+      ptr = new TM(initialValue);
+      pthread_setspecific(pkey, ptr);
+    }
+    return *ptr;
 #else
     return value_;
 #endif
@@ -65,7 +85,12 @@ namespace occa {
   template <class TM>
   const TM& tls<TM>::value() const {
 #if (OCCA_OS & (OCCA_LINUX_OS | OCCA_MACOS_OS))
-    return *((TM*) pthread_getspecific(pkey));
+    TM *ptr = (TM*) pthread_getspecific(pkey);
+    if (!ptr) {
+      ptr = new TM(initialValue);
+      pthread_setspecific(pkey, ptr);
+    }
+    return *ptr;
 #else
     return value_;
 #endif
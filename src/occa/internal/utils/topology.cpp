@@ -0,0 +1,361 @@
+#include <cstdlib>
+#include <fstream>
+#include <mutex>
+#include <set>
+#include <sstream>
+#include <thread>
+
+#include <occa/internal/utils/string.hpp>
+#include <occa/internal/utils/sys.hpp>
+#include <occa/internal/utils/topology.hpp>
+
+#if (OCCA_OS & OCCA_LINUX_OS)
+#  include <sys/sysinfo.h>
+#endif
+
+namespace occa {
+  namespace sys {
+    static std::mutex topologyMutex;
+    static std::shared_ptr<const topology_t> cachedTopology;
+
+    static bool readFile(const std::string &filename,
+                         std::string &content) {
+      std::ifstream file(filename);
+      if (!file) {
+        return false;
+      }
+      std::stringstream ss;
+      ss << file.rdbuf();
+      content = ss.str();
+      return true;
+    }
+
+    static int readInt(const std::string &filename,
+                       const int defaultValue) {
+      std::string content;
+      if (!readFile(filename, content) || !strip(content).size()) {
+        return defaultValue;
+      }
+      return (int) parseInt(strip(content));
+    }
+
+    static std::string readLine(const std::string &filename) {
+      std::string content;
+      readFile(filename, content);
+      return strip(content);
+    }
+
+    // Sizes such as "48K" from /sys cache entries
+    static udim_t parseCacheBytes(const std::string &size) {
+      const udim_t value = (udim_t) ::strtoull(size.c_str(), NULL, 10);
+      if (contains(size, "K")) {
+        return value << 10;
+      }
+      if (contains(size, "M")) {
+        return value << 20;
+      }
+      if (contains(size, "G")) {
+        return value << 30;
+      }
+      return value;
+    }
+
+    // Looks up "key: value" lines from /proc files, returning the first match
+    static std::string findField(const std::string &content,
+                                 const std::string &key) {
+      for (const std::string &line : split(content, '\n')) {
+        const size_t colon = line.find(':');
+        if ((colon != std::string::npos)
+            && (strip(line.substr(0, colon)) == key)) {
+          return strip(line.substr(colon + 1));
+        }
+      }
+      return "";
+    }
+
+    // /proc/meminfo values are in kB
+    static udim_t parseMemInfoBytes(const std::string &value) {
+      return ((udim_t) ::strtoull(value.c_str(), NULL, 10)) << 10;
+    }
+
+    std::vector<int> parseIdList(const std::string &list) {
+      std::vector<int> ids;
+      for (std::string &range : split(strip(list), ',')) {
+        range = strip(range);
+        if (!range.size()) {
+          continue;
+        }
+        const size_t dash = range.find('-');
+        const int first = (int) parseInt(range.substr(0, dash));
+        const int last = ((dash == std::string::npos)
+                          ? first
+                          : (int) parseInt(range.substr(dash + 1)));
+        for (int id = first; id <= last; ++id) {
+          ids.push_back(id);
+        }
+      }
+      return ids;
+    }
+
+    cacheInfo_t::cacheInfo_t() :
+      level(0),
+      bytes(0),
+      sharedCpuCount(0) {}
+
+    numaNodeInfo_t::numaNodeInfo_t() :
+      id(0),
+      totalMemory(0),
+      availableMemory(0) {}
+
+    topology_t::topology_t() :
+      frequency(0),
+      coreCount(0),
+      packageCount(0),
+      threadsPerCore(0),
+      totalMemory(0),
+      availableMemory(0) {}
+
+    std::shared_ptr<const topology_t> topology_t::get() {
+      std::lock_guard<std::mutex> lock(topologyMutex);
+      if (!cachedTopology) {
+        cachedTopology = std::make_shared<const topology_t>(load());
+      }
+      return cachedTopology;
+    }
+
+    std::shared_ptr<const topology_t> topology_t::refresh() {
+      // Readers holding the previous topology keep it alive
+      std::shared_ptr<const topology_t> topology = std::make_shared<const topology_t>(load());
+
+      std::lock_guard<std::mutex> lock(topologyMutex);
+      cachedTopology = topology;
+      return cachedTopology;
+    }
+
+    topology_t topology_t::load(const std::string &sysRoot,
+                                const std::string &procRoot) {
+      topology_t topology;
+
+#if (OCCA_OS & OCCA_LINUX_OS)
+      topology.loadProcessor(sysRoot, procRoot);
+      topology.loadCaches(sysRoot);
+      topology.loadNumaNodes(sysRoot);
+      topology.loadMemory(procRoot);
+#else
+      const SystemInfo info = SystemInfo::load();
+
+      topology.processorName = info.processor.name;
+      topology.frequency = info.processor.frequency;
+      topology.coreCount = info.processor.coreCount;
+
+      const CacheLevel levels[4] = {
+        CacheLevel::L1D, CacheLevel::L1I, CacheLevel::L2, CacheLevel::L3
+      };
+      const udim_t sizes[4] = {
+        info.processor.cache.l1d, info.processor.cache.l1i,
+        info.processor.cache.l2, info.processor.cache.l3
+      };
+      for (int i = 0; i < 4; ++i) {
+        if (!sizes[i]) {
+          continue;
+        }
+        cacheInfo_t cache;
+        cache.level = (i < 2) ? 1 : i;
+        cache.type = ((levels[i] == CacheLevel::L1D)
+                      ? "Data"
+                      : ((levels[i] == CacheLevel::L1I) ? "Instruction" : "Unified"));
+        cache.bytes = sizes[i];
+        topology.caches.push_back(cache);
+      }
+
+      topology.totalMemory = info.memory.total;
+      topology.availableMemory = info.memory.available;
+#endif
+
+      topology.loadFallbacks();
+      return topology;
+    }
+
+    void topology_t::loadProcessor(const std::string &sysRoot,
+                                   const std::string &procRoot) {
+      cpus = parseIdList(readLine(sysRoot + "cpu/online"));
+
+      std::set<std::pair<int, int>> cores;
+      std::set<int> packages;
+      for (const int cpu : cpus) {
+        const std::string topologyDir = sysRoot + "cpu/cpu" + toString(cpu) + "/topology/";
+        const int package = readInt(topologyDir + "physical_package_id", 0);
+        const int core = readInt(topologyDir + "core_id", cpu);
+        cores.insert(std::make_pair(package, core));
+        packages.insert(package);
+      }
+      coreCount = (int) cores.size();
+      packageCount = (int) packages.size();
+
+      std::string cpuInfo;
+      readFile(procRoot + "cpuinfo", cpuInfo);
+      processorName = findField(cpuInfo, "model name");
+
+      if (!cpus.size()) {
+        return;
+      }
+
+      const std::string cpuDir = sysRoot + "cpu/cpu" + toString(cpus[0]) + "/";
+      threadsPerCore = (int) parseIdList(
+        readLine(cpuDir + "topology/thread_siblings_list")
+      ).size();
+
+      // cpufreq reports kHz and /proc/cpuinfo reports MHz
+      const int maxFrequency = readInt(cpuDir + "cpufreq/cpuinfo_max_freq", 0);
+      if (maxFrequency > 0) {
+        frequency = ((udim_t) maxFrequency) * 1000;
+      } else {
+        frequency = (udim_t) (1e6 * ::atof(findField(cpuInfo, "cpu MHz").c_str()));
+      }
+    }
+
+    void topology_t::loadCaches(const std::string &sysRoot) {
+      if (!cpus.size()) {
+        return;
+      }
+
+      const std::string cacheDir = sysRoot + "cpu/cpu" + toString(cpus[0]) + "/cache/";
+      for (int index = 0; ; ++index) {
+        const std::string indexDir = cacheDir + "index" + toString(index) + "/";
+
+        cacheInfo_t cache;
+        cache.level = readInt(indexDir + "level", 0);
+        if (!cache.level) {
+          break;
+        }
+        cache.type = readLine(indexDir + "type");
+        cache.bytes = parseCacheBytes(readLine(indexDir + "size"));
+        cache.sharedCpuCount = (int) parseIdList(
+          readLine(indexDir + "shared_cpu_list")
+        ).size();
+
+        // Keep caches ordered by level
+        std::vector<cacheInfo_t>::iterator it = caches.begin();
+        while ((it != caches.end()) && (it->level <= cache.level)) {
+          ++it;
+        }
+        caches.insert(it, cache);
+      }
+    }
+
+    void topology_t::loadNumaNodes(const std::string &sysRoot) {
+      for (const int id : parseIdList(readLine(sysRoot + "node/online"))) {
+        const std::string nodeDir = sysRoot + "node/node" + toString(id) + "/";
+
+        numaNodeInfo_t node;
+        node.id = id;
+        node.cpus = parseIdList(readLine(nodeDir + "cpulist"));
+
+        // Lines look like "Node 0 MemTotal:  4947704 kB"
+        std::string memInfo;
+        readFile(nodeDir + "meminfo", memInfo);
+        const std::string prefix = "Node " + toString(id) + " ";
+        node.totalMemory = parseMemInfoBytes(findField(memInfo, prefix + "MemTotal"));
+        node.availableMemory = parseMemInfoBytes(findField(memInfo, prefix + "MemFree"));
+
+        numaNodes.push_back(node);
+      }
+    }
+
+    void topology_t::loadMemory(const std::string &procRoot) {
+      std::string memInfo;
+      if (!readFile(procRoot + "meminfo", memInfo)) {
+        return;
+      }
+
+      totalMemory = parseMemInfoBytes(findField(memInfo, "MemTotal"));
+      availableMemory = readAvailableMemory(procRoot);
+    }
+
+    udim_t topology_t::readAvailableMemory(const std::string &procRoot) {
+      std::string memInfo;
+      if (!readFile(procRoot + "meminfo", memInfo)) {
+        return 0;
+      }
+
+      // MemAvailable is missing before Linux 3.14
+      std::string available = findField(memInfo, "MemAvailable");
+      if (!available.size()) {
+        available = findField(memInfo, "MemFree");
+      }
+      return parseMemInfoBytes(available);
+    }
+
+    void topology_t::loadFallbacks() {
+      if (!cpus.size()) {
+        const int cpuCount_ = std::max(1, (int) std::thread::hardware_concurrency());
+        for (int cpu = 0; cpu < cpuCount_; ++cpu) {
+          cpus.push_back(cpu);
+        }
+      }
+      if (coreCount <= 0) {
+        coreCount = (int) cpus.size();
+      }
+      if (packageCount <= 0) {
+        packageCount = 1;
+      }
+      if (threadsPerCore <= 0) {
+        threadsPerCore = std::max(1, (int) cpus.size() / coreCount);
+      }
+
+#if (OCCA_OS & OCCA_LINUX_OS)
+      if (!totalMemory) {
+        struct sysinfo info;
+        if (!::sysinfo(&info)) {
+          totalMemory = ((udim_t) info.totalram) * info.mem_unit;
+          availableMemory = ((udim_t) info.freeram) * info.mem_unit;
+        }
+      }
+#endif
+
+      if (!numaNodes.size()) {
+        numaNodeInfo_t node;
+        node.cpus = cpus;
+        node.totalMemory = totalMemory;
+        node.availableMemory = availableMemory;
+        numaNodes.push_back(node);
+      }
+    }
+
+    int topology_t::cpuCount() const {
+      return (int) cpus.size();
+    }
+
+    int topology_t::numaNodeCount() const {
+      return (int) numaNodes.size();
+    }
+
+    udim_t topology_t::cacheSize(const CacheLevel level) const {
+      for (const cacheInfo_t &cache : caches) {
+        switch (level) {
+          case CacheLevel::L1D:
+            if ((cache.level == 1) && (cache.type != "Instruction")) {
+              return cache.bytes;
+            }
+            break;
+          case CacheLevel::L1I:
+            if ((cache.level == 1) && (cache.type != "Data")) {
+              return cache.bytes;
+            }
+            break;
+          case CacheLevel::L2:
+            if (cache.level == 2) {
+              return cache.bytes;
+            }
+            break;
+          case CacheLevel::L3:
+            if (cache.level == 3) {
+              return cache.bytes;
+            }
+            break;
+        }
+      }
+      return 0;
+    }
+  }
+}
@@ -0,0 +1,92 @@
+#ifndef OCCA_INTERNAL_UTILS_TOPOLOGY_HEADER
+#define OCCA_INTERNAL_UTILS_TOPOLOGY_HEADER
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <occa/defines.hpp>
+#include <occa/types.hpp>
+#include <occa/internal/utils/enums.hpp>
+
+namespace occa {
+  namespace sys {
+    class cacheInfo_t {
+     public:
+      int level;
+      // "Data", "Instruction" or "Unified"
+      std::string type;
+      udim_t bytes;
+      // Logical CPUs sharing the cache
+      int sharedCpuCount;
+
+      cacheInfo_t();
+    };
+
+    class numaNodeInfo_t {
+     public:
+      int id;
+      std::vector<int> cpus;
+      udim_t totalMemory;
+      udim_t availableMemory;
+
+      numaNodeInfo_t();
+    };
+
+    // Host topology read from /proc and /sys on Linux, and from SystemInfo elsewhere.
+    // Loading is lazy and the result is cached until refresh() is called.
+    class topology_t {
+     public:
+      std::string processorName;
+      // In Hz
+      udim_t frequency;
+
+      // Online logical CPUs
+      std::vector<int> cpus;
+      int coreCount;
+      int packageCount;
+      // SMT siblings per core
+      int threadsPerCore;
+
+      // Caches seen by the first online CPU, ordered by level
+      std::vector<cacheInfo_t> caches;
+
+      std::vector<numaNodeInfo_t> numaNodes;
+
+      udim_t totalMemory;
+      udim_t availableMemory;
+
+      topology_t();
+
+      static std::shared_ptr<const topology_t> get();
+      static std::shared_ptr<const topology_t> refresh();
+
+      // Reads the topology rooted at [sysRoot] and [procRoot], used for testing
+      static topology_t load(const std::string &sysRoot = "/sys/devices/system/",
+                             const std::string &procRoot = "/proc/");
+
+      // Reads the current available memory without touching the cached topology
+      // Returns 0 if [procRoot]/meminfo can't be read
+      static udim_t readAvailableMemory(const std::string &procRoot = "/proc/");
+
+      int cpuCount() const;
+      int numaNodeCount() const;
+
+      // Returns 0 if the cache is not found
+      udim_t cacheSize(const CacheLevel level) const;
+
+     private:
+      void loadProcessor(const std::string &sysRoot,
+                         const std::string &procRoot);
+      void loadCaches(const std::string &sysRoot);
+      void loadNumaNodes(const std::string &sysRoot);
+      void loadMemory(const std::string &procRoot);
+      void loadFallbacks();
+    };
+
+    // Parses CPU and node lists such as "0-3,8,10-11"
+    std::vector<int> parseIdList(const std::string &list);
+  }
+}
+
+#endif
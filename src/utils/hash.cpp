@@ -1,5 +1,18 @@
-#include <sstream>
+#include <cstring>
+#include <ctime>
+#include <map>
+#include <mutex>
 #include <stdint.h>
+#include <sys/stat.h>
+#include <sys/types.h>
+
+#include <occa/defines.hpp>
+
+#if (OCCA_OS & (OCCA_LINUX_OS | OCCA_MACOS_OS))
+#  include <fcntl.h>
+#  include <sys/mman.h>
+#  include <unistd.h>
+#endif
 
 #include <occa/types.hpp>
 #include <occa/utils/hash.hpp>
@@ -130,27 +143,157 @@ namespace occa {
     return out;
   }
 
-  hash_t hash(const void *ptr, udim_t bytes) {
-    std::stringstream ss;
-    const char *c = (char*) ptr;
+  //---[ hasher_t ]---------------------
+  static const uint64_t hashPrime1 = 0x9E3779B185EBCA87ULL;
+  static const uint64_t hashPrime2 = 0xC2B2AE3D27D4EB4FULL;
+  static const uint64_t hashPrime3 = 0x165667B19E3779F9ULL;
+  static const uint64_t hashPrime4 = 0x85EBCA77C2B2AE63ULL;
+  static const uint64_t hashPrime5 = 0x27D4EB2F165667C5ULL;
 
-    hash_t hash;
-    int *h = hash.h;
+  static inline uint64_t hashRotl(const uint64_t value, const int bits) {
+    return (value << bits) | (value >> (64 - bits));
+  }
+
+  static inline uint64_t hashRead64(const unsigned char *c) {
+    uint64_t value;
+    ::memcpy(&value, c, sizeof(uint64_t));
+    return value;
+  }
+
+  static inline uint32_t hashRead32(const unsigned char *c) {
+    uint32_t value;
+    ::memcpy(&value, c, sizeof(uint32_t));
+    return value;
+  }
+
+  static inline uint64_t hashRound(uint64_t lane, const uint64_t input) {
+    lane += input * hashPrime2;
+    lane = hashRotl(lane, 31);
+    return lane * hashPrime1;
+  }
+
+  static inline uint64_t hashMerge(uint64_t h, const uint64_t lane) {
+    h ^= hashRound(0, lane);
+    return h * hashPrime1 + hashPrime4;
+  }
+
+  static inline uint64_t hashAvalanche(uint64_t h) {
+    h ^= h >> 33;
+    h *= hashPrime2;
+    h ^= h >> 29;
+    h *= hashPrime3;
+    h ^= h >> 32;
+    return h;
+  }
+
+  // Each lane only reads its own 8 bytes of a stripe, the 4 rounds are independent
+  static inline void hashStripe(uint64_t *lanes, const unsigned char *c) {
+    lanes[0] = hashRound(lanes[0], hashRead64(c));
+    lanes[1] = hashRound(lanes[1], hashRead64(c + 8));
+    lanes[2] = hashRound(lanes[2], hashRead64(c + 16));
+    lanes[3] = hashRound(lanes[3], hashRead64(c + 24));
+  }
+
+  hasher_t::hasher_t() :
+    stripeBytes(0),
+    totalBytes(0) {
+    const uint64_t seed = hashAvalanche(OCCA_CACHE_VERSION * hashPrime5);
+    lanes[0] = seed + hashPrime1 + hashPrime2;
+    lanes[1] = seed + hashPrime2;
+    lanes[2] = seed;
+    lanes[3] = seed - hashPrime1;
+  }
 
-    const int p[8] = {
-      102679, 102701, 102761, 102763,
-      102769, 102793, 102797, 102811
-    };
+  void hasher_t::update(const void *ptr, udim_t bytes) {
+    const unsigned char *c = (const unsigned char*) ptr;
+    totalBytes += bytes;
 
-    for (udim_t i = 0; i < bytes; ++i) {
-      for (int j = 0; j < 8; ++j) {
-        h[j] = (h[j] * p[j]) ^ c[i];
+    // Fill up a partial stripe first
+    if (stripeBytes) {
+      const udim_t missingBytes = 32 - stripeBytes;
+      if (bytes < missingBytes) {
+        ::memcpy(stripe + stripeBytes, c, bytes);
+        stripeBytes += (int) bytes;
+        return;
       }
+      ::memcpy(stripe + stripeBytes, c, missingBytes);
+      hashStripe(lanes, stripe);
+      c += missingBytes;
+      bytes -= missingBytes;
+      stripeBytes = 0;
+    }
+
+    const unsigned char *end = c + bytes;
+    if (bytes >= 32) {
+      uint64_t l[4] = {lanes[0], lanes[1], lanes[2], lanes[3]};
+      const unsigned char *lastStripe = end - 32;
+      do {
+        hashStripe(l, c);
+        c += 32;
+      } while (c <= lastStripe);
+      lanes[0] = l[0]; lanes[1] = l[1];
+      lanes[2] = l[2]; lanes[3] = l[3];
+    }
+
+    if (c < end) {
+      stripeBytes = (int) (end - c);
+      ::memcpy(stripe, c, stripeBytes);
+    }
+  }
+
+  void hasher_t::update(const std::string &str) {
+    update(str.c_str(), str.size());
+  }
+
+  hash_t hasher_t::digest() const {
+    uint64_t h = (
+      hashRotl(lanes[0], 1)
+      + hashRotl(lanes[1], 7)
+      + hashRotl(lanes[2], 12)
+      + hashRotl(lanes[3], 18)
+    );
+    for (int i = 0; i < 4; ++i) {
+      h = hashMerge(h, lanes[i]);
+    }
+    h += totalBytes;
+
+    // Consume the partial stripe
+    const unsigned char *c = stripe;
+    const unsigned char *end = stripe + stripeBytes;
+    for (; (c + 8) <= end; c += 8) {
+      h ^= hashRound(0, hashRead64(c));
+      h = hashRotl(h, 27) * hashPrime1 + hashPrime4;
+    }
+    if ((c + 4) <= end) {
+      h ^= hashRead32(c) * hashPrime1;
+      h = hashRotl(h, 23) * hashPrime2 + hashPrime3;
+      c += 4;
+    }
+    for (; c < end; ++c) {
+      h ^= (*c) * hashPrime5;
+      h = hashRotl(h, 11) * hashPrime1;
+    }
+
+    // Expand to 256 bits, mixing in each lane for the longer outputs
+    hash_t hash;
+    for (int i = 0; i < 4; ++i) {
+      const uint64_t value = hashAvalanche(
+        h ^ hashRound(hashPrime5 * (i + 1), lanes[i])
+      );
+      hash.h[2*i + 0] = (int) (uint32_t) value;
+      hash.h[2*i + 1] = (int) (uint32_t) (value >> 32);
     }
     hash.initialized = true;
 
     return hash;
   }
+  //====================================
+
+  hash_t hash(const void *ptr, udim_t bytes) {
+    hasher_t hasher;
+    hasher.update(ptr, bytes);
+    return hasher.digest();
+  }
 
   hash_t hash(const char *c) {
     return hash(c, strlen(c));
@@ -160,10 +303,134 @@ namespace occa {
     return hash(str.c_str(), str.size());
   }
 
-  hash_t hashFile(const std::string &filename) {
-    const char *c = io::c_read(io::expandFilename(filename));
-    hash_t ret = hash(c);
+  //---[ File Hashes ]------------------
+  // Identifies a file's contents without reading it
+  class fileHashKey_t {
+  public:
+    uint64_t device;
+    uint64_t inode;
+    int64_t mtime;
+    int64_t mtimeNanoseconds;
+    int64_t bytes;
+
+    bool operator == (const fileHashKey_t &other) const {
+      return (
+        (device == other.device)
+        && (inode == other.inode)
+        && (mtime == other.mtime)
+        && (mtimeNanoseconds == other.mtimeNanoseconds)
+        && (bytes == other.bytes)
+      );
+    }
+  };
+
+  class fileHashEntry_t {
+  public:
+    fileHashKey_t key;
+    hash_t hash;
+  };
+
+  typedef std::map<std::string, fileHashEntry_t> fileHashMap;
+
+  static std::mutex fileHashMutex;
+
+  // Never freed so hashing during static destruction is safe
+  static fileHashMap& fileHashes() {
+    static fileHashMap *hashes = new fileHashMap();
+    return *hashes;
+  }
+
+  static void setFileHashKey(const struct stat &statbuf,
+                             fileHashKey_t &key) {
+    key.device = (uint64_t) statbuf.st_dev;
+    key.inode = (uint64_t) statbuf.st_ino;
+    key.mtime = (int64_t) statbuf.st_mtime;
+#if (OCCA_OS == OCCA_LINUX_OS)
+    key.mtimeNanoseconds = (int64_t) statbuf.st_mtim.tv_nsec;
+#elif (OCCA_OS == OCCA_MACOS_OS)
+    key.mtimeNanoseconds = (int64_t) statbuf.st_mtimespec.tv_nsec;
+#else
+    key.mtimeNanoseconds = 0;
+#endif
+    key.bytes = (int64_t) statbuf.st_size;
+  }
+
+  // Hashes the file and updates [key] to match the hashed contents
+  static hash_t hashFileContents(const std::string &filename,
+                                 fileHashKey_t &key) {
+#if (OCCA_OS & (OCCA_LINUX_OS | OCCA_MACOS_OS))
+    const int fd = ::open(filename.c_str(), O_RDONLY);
+    OCCA_ERROR("Failed to open [" << io::shortname(filename) << "]",
+               fd >= 0);
+
+    struct stat statbuf;
+    if (::fstat(fd, &statbuf) == 0) {
+      setFileHashKey(statbuf, key);
+    }
+
+    const udim_t bytes = (udim_t) key.bytes;
+    if (!bytes) {
+      ::close(fd);
+      return hash("", 0);
+    }
+
+    void *ptr = ::mmap(NULL, bytes, PROT_READ, MAP_PRIVATE, fd, 0);
+    ::close(fd);
+
+    if (ptr != MAP_FAILED) {
+#  ifdef MADV_SEQUENTIAL
+      ::madvise(ptr, bytes, MADV_SEQUENTIAL);
+#  endif
+      hash_t ret = hash(ptr, bytes);
+      ::munmap(ptr, bytes);
+      return ret;
+    }
+#endif
+
+    size_t chars = 0;
+    const char *c = io::c_read(filename, &chars);
+    hash_t ret = hash(c, chars);
     delete [] c;
     return ret;
   }
+
+  hash_t hashFile(const std::string &filename) {
+    const std::string expFilename = io::expandFilename(filename);
+
+    struct stat statbuf;
+    if (::stat(expFilename.c_str(), &statbuf) != 0) {
+      // Let the reader report the missing file
+      size_t chars = 0;
+      const char *c = io::c_read(expFilename, &chars);
+      hash_t ret = hash(c, chars);
+      delete [] c;
+      return ret;
+    }
+
+    fileHashKey_t key;
+    setFileHashKey(statbuf, key);
+    {
+      std::lock_guard<std::mutex> lock(fileHashMutex);
+      fileHashMap::iterator it = fileHashes().find(expFilename);
+      if (it != fileHashes().end() && it->second.key == key) {
+        return it->second.hash;
+      }
+    }
+
+    fileHashEntry_t entry;
+    entry.hash = hashFileContents(expFilename, key);
+    entry.key = key;
+
+    // Timestamps are coarser than writes, a file modified within the last
+    //   second could change again without changing its key
+    if ((int64_t) ::time(NULL) - key.mtime <= 1) {
+      return entry.hash;
+    }
+
+    std::lock_guard<std::mutex> lock(fileHashMutex);
+    fileHashes()[expFilename] = entry;
+
+    return entry.hash;
+  }
+  //====================================
 }
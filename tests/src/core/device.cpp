@@ -1,12 +1,36 @@
+#include <chrono>
+#include <thread>
+#include <vector>
+
 #include <occa.hpp>
+#include <occa/internal/core/kernel.hpp>
+#include <occa/internal/core/kernelBundle.hpp>
+#include <occa/internal/io.hpp>
+#include <occa/internal/utils/sys.hpp>
 #include <occa/internal/utils/testing.hpp>
 
 void testProperties();
 void testWrapMemory();
+void testKernelCache();
+void testConcurrentKernelCache();
+void testTuneKernel();
+void testKernelBundle();
+void testOpenMPProperties();
+void testAsyncStreams();
+void testMemoryPool();
+void testMemoryPlacement();
 
 int main(const int argc, const char **argv) {
   testProperties();
   testWrapMemory();
+  testKernelCache();
+  testConcurrentKernelCache();
+  testTuneKernel();
+  testKernelBundle();
+  testOpenMPProperties();
+  testAsyncStreams();
+  testMemoryPool();
+  testMemoryPlacement();
 
   return 0;
 }
@@ -122,3 +146,638 @@ void testWrapMemory() {
   ASSERT_EQ(mem.ptr<int>(), hostPtr);
   ASSERT_EQ((int) mem.length<int>(), 1);
 }
+
+void testKernelCache() {
+  occa::device device({
+    {"mode", "Serial"}
+  });
+
+  const std::string addVectorsFile = (
+    occa::env::OCCA_DIR + "tests/files/addVectors.okl"
+  );
+
+  ASSERT_EQ(0, (int) device.kernelCacheHits());
+  ASSERT_EQ(0, (int) device.kernelCacheMisses());
+
+  occa::kernel addVectors = device.buildKernel(addVectorsFile, "addVectors");
+  ASSERT_EQ(0, (int) device.kernelCacheHits());
+  ASSERT_EQ(1, (int) device.kernelCacheMisses());
+
+  occa::kernel addVectors2 = device.buildKernel(addVectorsFile, "addVectors");
+  ASSERT_EQ(1, (int) device.kernelCacheHits());
+  ASSERT_EQ(1, (int) device.kernelCacheMisses());
+  ASSERT_EQ(addVectors.getModeKernel(), addVectors2.getModeKernel());
+
+  const int entries = 4;
+  float a[entries] = {1, 2, 3, 4};
+  float ab[entries];
+  occa::memory o_a = device.malloc<float>(entries, a);
+  occa::memory o_ab = device.malloc<float>(entries);
+
+  // Handles to a cached kernel keep their own arguments
+  addVectors.clearArgs();
+  addVectors.pushArg(entries);
+  addVectors.pushArg(o_a);
+  addVectors.pushArg(o_a);
+  addVectors.pushArg(o_ab);
+  addVectors2.clearArgs();
+  addVectors.run();
+  o_ab.copyTo(ab);
+  ASSERT_EQ(8, (int) ab[entries - 1]);
+
+  // Run dimensions are also kept per handle
+  addVectors2.setRunDims(occa::dim(0), occa::dim(0));
+  o_ab.copyFrom(a);
+  addVectors2(entries, o_a, o_a, o_ab);
+  o_ab.copyTo(ab);
+  ASSERT_EQ(4, (int) ab[entries - 1]);
+
+  addVectors(entries, o_a, o_a, o_ab);
+  o_ab.copyTo(ab);
+  ASSERT_EQ(8, (int) ab[entries - 1]);
+
+  // Freeing one handle keeps the kernel for the others
+  addVectors2.free();
+  ASSERT_FALSE(addVectors2.isInitialized());
+  ASSERT_TRUE(addVectors.isInitialized());
+
+  addVectors(entries, o_a, o_a, o_ab);
+  o_ab.copyTo(ab);
+  ASSERT_EQ(8, (int) ab[entries - 1]);
+
+  addVectors2 = device.buildKernel(addVectorsFile, "addVectors");
+  ASSERT_EQ(2, (int) device.kernelCacheHits());
+  ASSERT_EQ(addVectors.getModeKernel(), addVectors2.getModeKernel());
+
+  // Different props give a different kernel
+  occa::kernel addVectors3 = device.buildKernel(addVectorsFile,
+                                                "addVectors",
+                                                {{"defines/FOO", 1}});
+  ASSERT_EQ(2, (int) device.kernelCacheMisses());
+  ASSERT_NEQ(addVectors.getModeKernel(), addVectors3.getModeKernel());
+
+  // Code generation props are part of the kernel hash
+  occa::kernel vectorizedAddVectors = device.buildKernel(addVectorsFile,
+                                                         "addVectors",
+                                                         {{"serial/vectorize", true}});
+  ASSERT_EQ(3, (int) device.kernelCacheMisses());
+  ASSERT_NEQ(addVectors.hash(), vectorizedAddVectors.hash());
+  vectorizedAddVectors.free();
+
+  // Cached kernels outlive their user handles
+  addVectors = occa::kernel();
+  addVectors2 = occa::kernel();
+  addVectors = device.buildKernel(addVectorsFile, "addVectors");
+  ASSERT_EQ(3, (int) device.kernelCacheHits());
+  ASSERT_TRUE(addVectors.isInitialized());
+
+  // Freed kernels are dropped from the cache once no other handle uses them
+  addVectors.free();
+  addVectors = device.buildKernel(addVectorsFile, "addVectors");
+  ASSERT_EQ(3, (int) device.kernelCacheHits());
+  ASSERT_EQ(4, (int) device.kernelCacheMisses());
+  ASSERT_TRUE(addVectors.isInitialized());
+
+  // Edited headers give a new kernel
+  const std::string headerFile = occa::env::OCCA_CACHE_DIR + "tests/cachedKernelValue.hpp";
+  const std::string sourceFile = occa::env::OCCA_CACHE_DIR + "tests/cachedKernel.okl";
+  occa::io::write(headerFile, "#define CACHED_VALUE 1\n");
+  occa::io::write(
+    sourceFile,
+    "#include \"" + headerFile + "\"\n"
+    "@kernel void setValue(float *values) {\n"
+    "  for (int i = 0; i < 1; ++i; @outer) {\n"
+    "    for (int j = 0; j < 1; ++j; @inner) {\n"
+    "      values[0] = CACHED_VALUE;\n"
+    "    }\n"
+    "  }\n"
+    "}\n"
+  );
+
+  occa::kernel setValue = device.buildKernel(sourceFile, "setValue");
+  setValue(o_ab);
+  o_ab.copyTo(ab);
+  ASSERT_EQ(1, (int) ab[0]);
+
+  occa::io::write(headerFile, "#define CACHED_VALUE 2\n");
+  occa::kernel setValue2 = device.buildKernel(sourceFile, "setValue");
+  ASSERT_NEQ(setValue.getModeKernel(), setValue2.getModeKernel());
+  setValue2(o_ab);
+  o_ab.copyTo(ab);
+  ASSERT_EQ(2, (int) ab[0]);
+
+  occa::sys::rmrf(headerFile);
+  occa::sys::rmrf(sourceFile);
+
+  device.free();
+  ASSERT_FALSE(addVectors.isInitialized());
+  ASSERT_EQ(0, (int) device.kernelCacheHits());
+}
+
+void testConcurrentKernelCache() {
+  occa::device device({
+    {"mode", "Serial"}
+  });
+
+  const std::string addVectorsFile = (
+    occa::env::OCCA_DIR + "tests/files/addVectors.okl"
+  );
+  // Build once so threads only hit the cache
+  device.buildKernel(addVectorsFile, "addVectors");
+
+  const int threadCount = 4;
+  const int iterations = 50;
+  const int entries = 1 << 12;
+
+  std::vector<float> a(entries);
+  for (int i = 0; i < entries; ++i) {
+    a[i] = i;
+  }
+
+  // Memory is allocated up front, each thread writes to its own output
+  occa::memory o_a = device.malloc<float>(entries, a.data());
+  occa::memory o_ab[threadCount];
+  for (int t = 0; t < threadCount; ++t) {
+    o_ab[t] = device.malloc<float>(entries);
+  }
+
+  std::vector<std::thread> threads;
+  for (int t = 0; t < threadCount; ++t) {
+    threads.emplace_back([&, t]() {
+      for (int i = 0; i < iterations; ++i) {
+        occa::kernel addVectors = device.buildKernel(addVectorsFile, "addVectors");
+        addVectors.clearArgs();
+        addVectors.pushArg(entries);
+        addVectors.pushArg(o_a);
+        addVectors.pushArg(o_a);
+        addVectors.pushArg(o_ab[t]);
+        addVectors.run();
+      }
+    });
+  }
+  for (std::thread &thread : threads) {
+    thread.join();
+  }
+
+  ASSERT_EQ(threadCount * iterations, (int) device.kernelCacheHits());
+
+  std::vector<float> ab(entries);
+  for (int t = 0; t < threadCount; ++t) {
+    o_ab[t].copyTo(ab.data());
+    // addVectors also accumulates into the first 3 entries
+    for (int i = 3; i < entries; ++i) {
+      ASSERT_EQ(2 * i, (int) ab[i]);
+    }
+  }
+}
+
+void testTuneKernel() {
+  occa::device device({
+    {"mode", "Serial"}
+  });
+
+  const std::string tunedKernelFile = (
+    occa::env::OCCA_DIR + "tests/files/tunedKernel.okl"
+  );
+  occa::sys::rmrf(occa::io::cachePath() + "tuning");
+
+  ASSERT_EQ(0, (int) device.tunedKernelProperties(tunedKernelFile, "setValue").object().size());
+
+  const int entries = 20;
+  int value[entries];
+  occa::memory o_value = device.malloc<int>(entries);
+
+  // Only VALUE=2 with BLOCK=16 runs fast
+  int launches = 0;
+  occa::kernelLauncher_t launcher = [&](occa::kernel &kernel) {
+    const occa::json &props = kernel.properties();
+    if (((int) props["defines/VALUE"] != 2) ||
+        ((int) props["defines/BLOCK"] != 16)) {
+      std::this_thread::sleep_for(std::chrono::milliseconds(5));
+    }
+    kernel(entries, o_value);
+    ++launches;
+  };
+
+  occa::kernel setValue = device.tuneKernel(
+    tunedKernelFile, "setValue",
+    occa::json::parse("{ defines: { VALUE: [1, 2, 3], BLOCK: [4, 16] } }"),
+    launcher,
+    {{"tuning/iterations", 2}}
+  );
+  // 6 variants with 1 warmup and 2 timed launches each
+  ASSERT_EQ(18, launches);
+
+  setValue(entries, o_value);
+  o_value.copyTo(value);
+  ASSERT_EQ(216, value[entries - 1]);
+
+  occa::json tunedProps = device.tunedKernelProperties(tunedKernelFile, "setValue");
+  ASSERT_EQ(2, (int) tunedProps["defines/VALUE"]);
+  ASSERT_EQ(16, (int) tunedProps["defines/BLOCK"]);
+
+  // Tuned properties are picked up automatically
+  setValue = device.buildKernel(tunedKernelFile, "setValue");
+  setValue(entries, o_value);
+  o_value.copyTo(value);
+  ASSERT_EQ(216, value[entries - 1]);
+
+  // Passed properties take precedence
+  setValue = device.buildKernel(tunedKernelFile, "setValue",
+                                {{"defines/VALUE", 3}});
+  setValue(entries, o_value);
+  o_value.copyTo(value);
+  ASSERT_EQ(316, value[entries - 1]);
+
+  // Results are only read from disk once per device
+  occa::sys::rmrf(occa::io::cachePath() + "tuning");
+  tunedProps = device.tunedKernelProperties(tunedKernelFile, "setValue");
+  ASSERT_EQ(2, (int) tunedProps["defines/VALUE"]);
+
+  // Results are stored per device
+  occa::device otherDevice({
+    {"mode", "Threads"}
+  });
+  ASSERT_EQ(0, (int) otherDevice.tunedKernelProperties(tunedKernelFile, "setValue").object().size());
+
+  ASSERT_THROW(
+    device.tuneKernel(tunedKernelFile, "setValue",
+                      occa::json::parse("{ defines: { VALUE: [] } }"),
+                      launcher);
+  );
+
+  // Variants which fail to build are skipped
+  setValue = device.tuneKernel(
+    tunedKernelFile, "setValue",
+    occa::json::parse("{ defines: { VALUE: [2, '+'], BLOCK: [16] } }"),
+    launcher
+  );
+  setValue(entries, o_value);
+  o_value.copyTo(value);
+  ASSERT_EQ(216, value[entries - 1]);
+
+  // Tuning again replaces the loaded results
+  device.tuneKernel(
+    tunedKernelFile, "setValue",
+    occa::json::parse("{ defines: { VALUE: [3], BLOCK: [16] } }"),
+    launcher
+  );
+  tunedProps = device.tunedKernelProperties(tunedKernelFile, "setValue");
+  ASSERT_EQ(3, (int) tunedProps["defines/VALUE"]);
+
+  setValue = device.buildKernel(tunedKernelFile, "setValue");
+  setValue(entries, o_value);
+  o_value.copyTo(value);
+  ASSERT_EQ(316, value[entries - 1]);
+
+  occa::sys::rmrf(occa::io::cachePath() + "tuning");
+}
+
+void testKernelBundle() {
+  const std::string tunedKernelFile = (
+    occa::env::OCCA_DIR + "tests/files/tunedKernel.okl"
+  );
+  const std::string bundleFile = (
+    occa::env::OCCA_CACHE_DIR + "tests/kernels.bundle"
+  );
+  const occa::json props({
+    {"defines/VALUE", 7},
+    {"defines/BLOCK", 4}
+  });
+
+  std::string hashDir;
+  {
+    occa::device device({
+      {"mode", "Serial"}
+    });
+    occa::kernelBundle_t::write(bundleFile, device, {
+      occa::kernelSpec(tunedKernelFile, "setValue", props)
+    });
+
+    occa::kernel setValue = device.buildKernel(tunedKernelFile, "setValue", props);
+    hashDir = occa::io::dirname(setValue.binaryFilename());
+  }
+  occa::sys::rmrf(hashDir);
+  ASSERT_FALSE(occa::io::isDir(hashDir));
+
+  // Bundled kernels are restored instead of compiled
+  ::setenv("OCCA_CXX", "false", 1);
+
+  occa::device device({
+    {"mode", "Serial"}
+  });
+  device.loadBundle(bundleFile);
+
+  occa::kernel setValue = device.buildKernel(tunedKernelFile, "setValue", props);
+  ASSERT_TRUE(setValue.isInitialized());
+  ASSERT_TRUE(occa::io::isFile(setValue.binaryFilename()));
+
+  const int entries = 10;
+  int value[entries];
+  occa::memory o_value = device.malloc<int>(entries);
+  setValue(entries, o_value);
+  o_value.copyTo(value);
+  ASSERT_EQ(704, value[entries - 1]);
+
+  ::unsetenv("OCCA_CXX");
+
+  ASSERT_THROW(
+    device.loadBundle(tunedKernelFile);
+  );
+
+  // Bundles are validated before anything is read out of them
+  const std::string bundle = occa::io::read(bundleFile, occa::enums::FILE_TYPE_BINARY);
+  const std::string corruptBundleFile = bundleFile + ".corrupt";
+
+  occa::io::write(corruptBundleFile, bundle.substr(0, bundle.size() - 1));
+  ASSERT_THROW(
+    device.loadBundle(corruptBundleFile);
+  );
+
+  const std::string header = occa::kernelBundle_t::header;
+  occa::io::write(corruptBundleFile,
+                  header + "{\"version\": 1, \"hashes\": []}" + '\0');
+  ASSERT_THROW(
+    device.loadBundle(corruptBundleFile);
+  );
+
+  occa::io::write(corruptBundleFile,
+                  header + "{\"version\": 1, \"hashes\": {\"h\": [[\"../file\", 0, 1]]}}" + '\0' + "x");
+  ASSERT_THROW(
+    device.loadBundle(corruptBundleFile);
+  );
+
+  occa::sys::rmrf(corruptBundleFile);
+  occa::sys::rmrf(bundleFile);
+}
+
+void testOpenMPProperties() {
+  if (!occa::modeIsEnabled("OpenMP")) {
+    return;
+  }
+
+  occa::device device({
+    {"mode", "OpenMP"},
+    {"openmp", {
+      {"threads", 2},
+      {"schedule", "dynamic"},
+      {"proc_bind", "close"}
+    }}
+  });
+
+  // Device settings are the kernel defaults
+  ASSERT_EQ(2, (int) device.kernelProperties()["openmp/threads"]);
+
+  const std::string fillSource = (
+    "@kernel void fill(const int n, int *out) {\n"
+    "  for (int i = 0; i < n; ++i; @outer) {\n"
+    "    for (int j = 0; j < n; ++j; @outer) {\n"
+    "      for (int k = 0; k < 1; ++k; @inner) {\n"
+    "        out[i * n + j] = i * n + j;\n"
+    "      }\n"
+    "    }\n"
+    "  }\n"
+    "}\n"
+  );
+
+  occa::kernel fill = device.buildKernelFromString(fillSource, "fill");
+  occa::kernel collapsedFill = device.buildKernelFromString(fillSource,
+                                                            "fill",
+                                                            {{"openmp/collapse", 2}});
+  ASSERT_TRUE(fill.isInitialized());
+  ASSERT_TRUE(collapsedFill.isInitialized());
+  ASSERT_NEQ(fill.hash(), collapsedFill.hash());
+
+  const int n = 8;
+  int values[n * n];
+  occa::memory o_values = device.malloc<int>(n * n);
+
+  collapsedFill(n, o_values);
+  o_values.copyTo(values);
+  for (int i = 0; i < (n * n); ++i) {
+    ASSERT_EQ(i, values[i]);
+  }
+
+  ASSERT_THROW(
+    device.buildKernelFromString(fillSource,
+                                 "fill",
+                                 {{"openmp/schedule", "fastest"}});
+  );
+  ASSERT_THROW(
+    device.buildKernelFromString(fillSource,
+                                 "fill",
+                                 {{"openmp/threads", 0}});
+  );
+}
+
+void testAsyncStreams() {
+  const std::string addOneSource = (
+    "@kernel void addOne(const int n, int *values) {\n"
+    "  for (int i = 0; i < n; ++i; @tile(16, @outer, @inner)) {\n"
+    "    values[i] += 1;\n"
+    "  }\n"
+    "}\n"
+  );
+
+  occa::json deviceProps[2] = {
+    {{"mode", "Serial"}},
+    {{"mode", "Threads"}, {"threads", 3}}
+  };
+
+  for (const occa::json &props : deviceProps) {
+    occa::device device(props);
+    occa::kernel addOne = device.buildKernelFromString(addOneSource, "addOne");
+
+    occa::stream syncStream = device.getStream();
+    occa::stream asyncStream = device.createStream({{"async", true}});
+    device.setStream(asyncStream);
+
+    const int n = 1000;
+    int *values = new int[n];
+    for (int i = 0; i < n; ++i) {
+      values[i] = i;
+    }
+
+    occa::memory o_values = device.malloc<int>(n);
+
+    // Launches and async copies are queued in order
+    occa::streamTag startTag = device.tagStream();
+    o_values.copyFrom(values, "async: true");
+    for (int i = 0; i < 10; ++i) {
+      addOne(n, o_values);
+    }
+    o_values.copyTo(values, "async: true");
+    occa::streamTag endTag = device.tagStream();
+
+    device.waitFor(endTag);
+    for (int i = 0; i < n; ++i) {
+      ASSERT_EQ(i + 10, values[i]);
+    }
+    ASSERT_TRUE(device.timeBetween(startTag, endTag) >= 0);
+
+    // Blocking copies wait for the queued launches
+    addOne(n, o_values);
+    o_values.copyTo(values);
+    for (int i = 0; i < n; ++i) {
+      ASSERT_EQ(i + 11, values[i]);
+    }
+
+    // Arguments are captured when the launch is queued
+    addOne.clearArgs();
+    addOne.pushArg(n);
+    addOne.pushArg(o_values);
+    addOne.run();
+    addOne.clearArgs();
+    addOne.pushArg(0);
+    addOne.pushArg(o_values);
+    device.finish();
+    o_values.copyTo(values);
+    ASSERT_EQ(12, values[0]);
+    ASSERT_EQ(n + 11, values[n - 1]);
+
+    // The default stream still runs right away
+    device.setStream(syncStream);
+    addOne(n, o_values);
+    ASSERT_EQ(13, ((int*) o_values.ptr())[0]);
+
+    delete [] values;
+  }
+}
+
+void testMemoryPool() {
+  occa::device device({
+    {"mode", "Serial"}
+  });
+  ASSERT_FALSE((bool) device.memoryPoolInfo()["enabled"]);
+
+  device.setup({
+    {"mode", "Serial"},
+    {"memory_pool", {
+      {"enabled", true},
+      {"max_cached_bytes", 4096}
+    }}
+  });
+  ASSERT_TRUE((bool) device.memoryPoolInfo()["enabled"]);
+
+  occa::memory mem = device.malloc<char>(1000);
+  void *ptr = mem.ptr();
+  ASSERT_EQ((occa::udim_t) 1000, device.memoryAllocated());
+  mem.free();
+  ASSERT_EQ((occa::udim_t) 0, device.memoryAllocated());
+  ASSERT_EQ((occa::udim_t) 1000, device.peakMemoryAllocated());
+
+  // Sizes in the same class reuse the block
+  mem = device.malloc<char>(900);
+  ASSERT_EQ(ptr, mem.ptr());
+
+  occa::json info = device.memoryPoolInfo();
+  ASSERT_EQ(1, (int) info["hits"]);
+  ASSERT_EQ(1, (int) info["misses"]);
+  ASSERT_EQ(0, (int) info["cached_bytes"]);
+  ASSERT_EQ(1024, (int) info["reserved_bytes"]);
+
+  // Blocks past [max_cached_bytes] go back to the system
+  occa::memory big = device.malloc<char>(8000);
+  big.free();
+  mem.free();
+  info = device.memoryPoolInfo();
+  ASSERT_EQ(1024, (int) info["cached_bytes"]);
+  ASSERT_EQ(1024, (int) info["reserved_bytes"]);
+  ASSERT_EQ(1024 + 8192, (int) info["peak_reserved_bytes"]);
+
+  device.trimMemoryPool();
+  info = device.memoryPoolInfo();
+  ASSERT_EQ(0, (int) info["cached_bytes"]);
+  ASSERT_EQ(0, (int) info["reserved_bytes"]);
+
+  // Detached blocks belong to the caller and are no longer reserved by the pool
+  mem = device.malloc<char>(1000);
+  ptr = mem.ptr();
+  mem.detach();
+  info = device.memoryPoolInfo();
+  ASSERT_EQ(0, (int) info["cached_bytes"]);
+  ASSERT_EQ(0, (int) info["reserved_bytes"]);
+  occa::sys::free(ptr);
+
+  // Work queued on the same stream runs after the previous user is done
+  std::vector<int> ones(256, 1);
+  device.setStream(device.createStream({{"async", true}}));
+  mem = device.malloc<int>(256);
+  ptr = mem.ptr();
+  mem.copyFrom(ones.data(), "async: true");
+  mem.free();
+  mem = device.malloc<int>(256);
+  ASSERT_EQ(ptr, mem.ptr());
+  device.finish();
+
+  ASSERT_THROW(
+    occa::device({
+      {"mode", "Serial"},
+      {"memory_pool", {
+        {"enabled", true},
+        {"max_cached_bytes", -1}
+      }}
+    });
+  );
+}
+
+void testMemoryPlacement() {
+  occa::device device({
+    {"mode", "Serial"},
+    {"memory_pool", {
+      {"enabled", true}
+    }}
+  });
+
+  const int entries = 1 << 20;
+  std::vector<int> values(entries);
+  for (int i = 0; i < entries; ++i) {
+    values[i] = i;
+  }
+
+  // Unsupported placement is skipped so these work on any system
+  const occa::json placements[] = {
+    {{"first_touch", "parallel"}},
+    {{"first_touch", "parallel"}, {"first_touch_threads", 3}},
+    {{"huge_pages", true}},
+    {{"numa_node", 0}},
+    {{"interleave", true}, {"first_touch", "parallel"}}
+  };
+
+  for (const occa::json &props : placements) {
+    occa::memory mem = device.malloc<int>(entries, values.data(), props);
+    ASSERT_EQ((occa::udim_t) (entries * sizeof(int)), device.memoryAllocated());
+
+    // Placed allocations don't go through the pool
+    ASSERT_EQ(0, (int) device.memoryPoolInfo()["reserved_bytes"]);
+
+    const int *ptr = mem.ptr<int>();
+    ASSERT_EQ(0, ptr[0]);
+    ASSERT_EQ(entries / 2, ptr[entries / 2]);
+    ASSERT_EQ(entries - 1, ptr[entries - 1]);
+  }
+
+  // Zero-filled when parallel touched without a source
+  occa::memory zeros = device.malloc<int>(1000, occa::json({{"first_touch", "parallel"}}));
+  ASSERT_EQ(0, zeros.ptr<int>()[999]);
+
+  // Device-wide placement through the memory properties
+  occa::device placedDevice({
+    {"mode", "Serial"},
+    {"memory", {
+      {"first_touch", "parallel"}
+    }}
+  });
+  occa::memory placed = placedDevice.malloc<int>(entries, values.data());
+  ASSERT_EQ(entries - 1, placed.ptr<int>()[entries - 1]);
+
+  // Placed memory is mapped, so the caller couldn't free a detached block
+  ASSERT_THROW(placed.detach());
+  ASSERT_TRUE(placed.isInitialized());
+  ASSERT_EQ(entries - 1, placed.ptr<int>()[entries - 1]);
+
+  ASSERT_THROW(device.malloc<int>(10, occa::json({{"numa_node", -1}})));
+  ASSERT_THROW(device.malloc<int>(10, occa::json({{"numa_node", 0}, {"interleave", true}})));
+  ASSERT_THROW(device.malloc<int>(10, occa::json({{"first_touch", "serial"}})));
+  ASSERT_THROW(device.malloc<int>(10, occa::json({{"first_touch_threads", 0}})));
+}
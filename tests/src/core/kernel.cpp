@@ -2,6 +2,7 @@
 
 #include <occa/internal/io.hpp>
 #include <occa/internal/core/device.hpp>
+#include <occa/internal/modes/serial/sharedBinary.hpp>
 #include <occa/internal/utils/testing.hpp>
 
 occa::kernel addVectors;
@@ -15,6 +16,10 @@ void testParsingFailure();
 void testCompilingFailure();
 void testArgumentFailure();
 void testRun();
+void testBuildKernels();
+void testSharedBinary();
+void testThreadsMode();
+void testBind();
 
 int main(const int argc, const char **argv) {
   addVectors = occa::buildKernel(addVectorsFile,
@@ -26,6 +31,10 @@ int main(const int argc, const char **argv) {
   testCompilingFailure();
   testArgumentFailure();
   testRun();
+  testBuildKernels();
+  testSharedBinary();
+  testThreadsMode();
+  testBind();
 
   return 0;
 }
@@ -188,3 +197,230 @@ void testRun() {
 
   occa::freeUvaPtr(uvaPtr);
 }
+
+void testBuildKernels() {
+  const std::string argKernelFile = (
+    occa::env::OCCA_DIR + "tests/files/argKernel.okl"
+  );
+
+  occa::device device({
+    {"mode", "Serial"}
+  });
+
+  std::vector<occa::kernelSpec> specs;
+  specs.push_back(occa::kernelSpec(addVectorsFile, "addVectors"));
+  specs.push_back(occa::kernelSpec(argKernelFile, "argKernel",
+                                   {{"type_validation", false}}));
+  specs.push_back(occa::kernelSpec(addVectorsFile, "addVectors"));
+  specs.push_back(occa::kernelSpec(addVectorsFile, "addVectors",
+                                   {{"compiler_flags", "--occa-bad-flag"}}));
+
+  occa::strVector errors;
+  std::vector<occa::kernel> kernels = device.buildKernels(specs, errors);
+
+  ASSERT_EQ(4, (int) kernels.size());
+  ASSERT_EQ(4, (int) errors.size());
+
+  ASSERT_TRUE(kernels[0].isInitialized());
+  ASSERT_TRUE(kernels[1].isInitialized());
+  ASSERT_TRUE(kernels[2].isInitialized());
+  ASSERT_FALSE(kernels[3].isInitialized());
+
+  ASSERT_EQ("", errors[0]);
+  ASSERT_EQ("", errors[1]);
+  ASSERT_EQ("", errors[2]);
+  ASSERT_NEQ("", errors[3]);
+
+  ASSERT_EQ("addVectors", kernels[0].name());
+  ASSERT_EQ("argKernel", kernels[1].name());
+  ASSERT_EQ(kernels[0].hash(), kernels[2].hash());
+  ASSERT_EQ(kernels[0].hash(),
+            device.buildKernel(addVectorsFile, "addVectors").hash());
+
+  ASSERT_THROW(
+    device.buildKernels(specs);
+  );
+}
+
+void testSharedBinary() {
+  occa::device device({
+    {"mode", "Serial"}
+  });
+
+  const std::string source = (
+    "@kernel void first(int *a) {"
+    "  for (int i = 0; i < 1; ++i; @outer) {"
+    "    for (int j = 0; j < 1; ++j; @inner) { a[0] = 1; }"
+    "  }"
+    "}"
+    "@kernel void second(int *a) {"
+    "  for (int i = 0; i < 1; ++i; @outer) {"
+    "    for (int j = 0; j < 1; ++j; @inner) { a[0] = 2; }"
+    "  }"
+    "}"
+  );
+
+  occa::kernel first = device.buildKernelFromString(source, "first");
+  occa::kernel second = device.buildKernelFromString(source, "second");
+
+  const std::string binaryFilename = first.binaryFilename();
+  ASSERT_EQ(binaryFilename, second.binaryFilename());
+  ASSERT_TRUE(occa::serial::isSharedBinaryLoaded(binaryFilename));
+
+  int value = 0;
+  occa::memory mem = device.malloc<int>(1, &value);
+  second(mem);
+  mem.copyTo(&value);
+  ASSERT_EQ(2, value);
+
+  first(mem);
+  mem.copyTo(&value);
+  ASSERT_EQ(1, value);
+
+  // Missing kernels don't leak references to the binary
+  ASSERT_THROW(
+    device.buildKernelFromBinary(binaryFilename, "third");
+  );
+
+  first.free();
+  ASSERT_TRUE(occa::serial::isSharedBinaryLoaded(binaryFilename));
+
+  second.free();
+  ASSERT_FALSE(occa::serial::isSharedBinaryLoaded(binaryFilename));
+}
+
+void testThreadsMode() {
+  occa::device device({
+    {"mode", "Threads"},
+    {"threads", 4},
+    {"chunk", 3}
+  });
+
+  // Irregular outer iterations, a second pass reading the first one,
+  //   and atomic updates shared by every worker
+  const std::string source = (
+    "@kernel void irregular(const int n, int *values, int *prefix, int *total, float *halves) {\n"
+    "  for (int i = 0; i < n; ++i; @outer) {\n"
+    "    for (int j = 0; j < 1; ++j; @inner) {\n"
+    "      int value = 0;\n"
+    "      for (int k = 0; k < (i * i); ++k) {\n"
+    "        value += (k % 3);\n"
+    "      }\n"
+    "      values[i] = value;\n"
+    "      @atomic *total += 1;\n"
+    "      @atomic *halves -= 0.5f;\n"
+    "    }\n"
+    "  }\n"
+    "  for (int i = n - 1; i >= 0; i -= 2; @outer) {\n"
+    "    for (int j = 0; j < 1; ++j; @inner) {\n"
+    "      prefix[i] = values[i] + ((i > 0) ? values[i - 1] : 0);\n"
+    "    }\n"
+    "  }\n"
+    "}\n"
+  );
+
+  occa::kernel irregular = device.buildKernelFromString(source, "irregular");
+  ASSERT_EQ("Threads", irregular.mode());
+
+  const int n = 101;
+  std::vector<int> values(n), prefix(n, -1);
+  int total = 0;
+  float halves = 0;
+
+  occa::memory o_values = device.malloc<int>(n);
+  occa::memory o_prefix = device.malloc<int>(n, prefix.data());
+  occa::memory o_total  = device.malloc<int>(1, &total);
+  occa::memory o_halves = device.malloc<float>(1, &halves);
+
+  for (int run = 0; run < 3; ++run) {
+    irregular(n, o_values, o_prefix, o_total, o_halves);
+  }
+
+  o_values.copyTo(values.data());
+  o_prefix.copyTo(prefix.data());
+  o_total.copyTo(&total);
+  o_halves.copyTo(&halves);
+
+  ASSERT_EQ(3 * n, total);
+  ASSERT_EQ(-1.5f * n, halves);
+  for (int i = 0; i < n; ++i) {
+    int value = 0;
+    for (int k = 0; k < (i * i); ++k) {
+      value += (k % 3);
+    }
+    ASSERT_EQ(value, values[i]);
+
+    if (((n - 1 - i) % 2) == 0) {
+      ASSERT_EQ(value + ((i > 0) ? values[i - 1] : 0), prefix[i]);
+    } else {
+      ASSERT_EQ(-1, prefix[i]);
+    }
+  }
+}
+
+void testBind() {
+  occa::kernel axpy = occa::buildKernelFromString(
+    "@kernel void axpy(const int n, const float alpha, const float *x, float *y) {\n"
+    "  for (int i = 0; i < n; ++i; @tile(16, @outer, @inner)) {\n"
+    "    y[i] += alpha * x[i];\n"
+    "  }\n"
+    "}\n",
+    "axpy"
+  );
+
+  const int n = 100;
+  float *x = new float[n];
+  float *y = new float[n];
+  for (int i = 0; i < n; ++i) {
+    x[i] = i;
+    y[i] = 0;
+  }
+
+  occa::memory o_x = occa::malloc<float>(n, x);
+  occa::memory o_y = occa::malloc<float>(n, y);
+  occa::memory o_z = occa::malloc<float>(n, y);
+  occa::memory o_ints = occa::malloc<int>(n);
+
+  occa::kernelLaunch launch = axpy.bind(n, 1.0f, o_x, o_y);
+  ASSERT_TRUE(launch.isInitialized());
+  ASSERT_EQ(4, launch.argumentCount());
+
+  launch();
+  launch.setArg(1, 2.0f);
+  launch.run();
+
+  o_y.copyTo(y);
+  for (int i = 0; i < n; ++i) {
+    ASSERT_EQ((float) (3 * i), y[i]);
+  }
+
+  // Only update part of the output
+  launch.setArg(0, 10);
+  launch.setArg(3, o_z);
+  launch();
+
+  o_z.copyTo(y);
+  ASSERT_EQ((float) 18, y[9]);
+  ASSERT_EQ((float) 0, y[10]);
+
+  // Arguments are validated when bound or replaced
+  ASSERT_THROW(
+    axpy.bind(n, 1.0f, o_x);
+  );
+  ASSERT_THROW(
+    axpy.bind(n, 1.0f, o_x, 2);
+  );
+  ASSERT_THROW(
+    launch.setArg(1, 2.0);
+  );
+  ASSERT_THROW(
+    launch.setArg(2, o_ints);
+  );
+  ASSERT_THROW(
+    launch.setArg(4, 1);
+  );
+  ASSERT_FALSE(occa::kernelLaunch().isInitialized());
+
+  delete [] x;
+  delete [] y;
+}
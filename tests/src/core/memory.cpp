@@ -1,12 +1,15 @@
 #include <occa.hpp>
+#include <occa/internal/core/device.hpp>
 #include <occa/internal/utils/testing.hpp>
 
 void testMalloc();
 void testSlice();
+void testView();
 
 int main(const int argc, const char **argv) {
   testMalloc();
   testSlice();
+  testView();
 
   return 0;
 }
@@ -102,3 +105,70 @@ void testSlice() {
   }
   ASSERT_SAME_SIZE(device.memoryAllocated(), 0);
 }
+
+void testView() {
+  int data[10];
+  for (int i = 0; i < 10; ++i) {
+    data[i] = i;
+  }
+
+  occa::device device({
+    {"mode", "Serial"}
+  });
+  occa::memory mem = device.malloc<int>(10, data);
+
+  const int ringLength = device.getModeDevice()->memoryRing.length();
+
+  occa::memoryView half1 = mem.view(0, 5);
+  occa::memoryView half2 = mem.view(5);
+  occa::memoryView middle = half2.view(1, 2);
+
+  // Views don't create backend memory
+  ASSERT_EQ(device.getModeDevice()->memoryRing.length(), ringLength);
+
+  ASSERT_EQ((int) half2.offset(), (int) (5 * sizeof(int)));
+  ASSERT_EQ((int) half2.length(), 5);
+  ASSERT_EQ((int) middle.offset(), (int) (6 * sizeof(int)));
+  ASSERT_EQ((int) middle.size(), (int) (2 * sizeof(int)));
+  ASSERT_EQ(middle.dtype(), occa::dtype::int_);
+  ASSERT_EQ(middle.ptr<int>(), mem.ptr<int>() + 6);
+  ASSERT_TRUE(middle.getMemory() == mem);
+
+  ASSERT_THROW(mem.view(8, 3));
+  ASSERT_THROW(half1.view(-1));
+  ASSERT_THROW(middle.copyFrom(data, 3 * sizeof(int)));
+
+  int out[5];
+  half2.copyTo(out);
+  for (int i = 0; i < 5; ++i) {
+    ASSERT_EQ(out[i], 5 + i);
+  }
+
+  // View to view copies
+  half1.copyFrom(half2);
+  mem.copyTo(data);
+  for (int i = 0; i < 10; ++i) {
+    ASSERT_EQ(data[i], (i < 5) ? (5 + i) : i);
+  }
+
+  occa::kernel addOne = device.buildKernelFromString(
+    "@kernel void addOne(const int entries, int *values) {"
+    "  for (int i = 0; i < entries; ++i; @tile(16, @outer, @inner)) {"
+    "    values[i] += 1;"
+    "  }"
+    "}",
+    "addOne"
+  );
+
+  addOne((int) middle.length(), middle);
+  mem.copyTo(data);
+  for (int i = 0; i < 10; ++i) {
+    const int expected = (i < 5) ? (5 + i) : i;
+    ASSERT_EQ(data[i], expected + ((i == 6 || i == 7) ? 1 : 0));
+  }
+
+  // Empty views are passed as null pointers
+  occa::memoryView empty = mem.view(10);
+  ASSERT_EQ((int) empty.size(), 0);
+  addOne(0, empty);
+}
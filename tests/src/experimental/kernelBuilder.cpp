@@ -0,0 +1,109 @@
+#include <thread>
+#include <vector>
+
+#include <occa.hpp>
+#include <occa/experimental/kernelBuilder.hpp>
+#include <occa/internal/utils/testing.hpp>
+
+void testRun();
+void testThreads();
+
+int main(const int argc, const char **argv) {
+  testRun();
+  testThreads();
+
+  return 0;
+}
+
+void addToValues(occa::memory o_values, const occa::primitive &increment) {
+  occa::scope scope({
+    {"entries", (int) o_values.length()},
+    {"values", o_values},
+    {"increment", increment}
+  });
+
+  OCCA_JIT(scope, (
+    for (int i = 0; i < entries; ++i; @tile(16, @outer, @inner)) {
+      values[i] += increment;
+    }
+  ));
+}
+
+void testRun() {
+  occa::device device({
+    {"mode", "Serial"}
+  });
+
+  const int entries = 40;
+  std::vector<int> values(entries);
+  std::vector<float> floatValues(entries);
+
+  occa::memory o_values = device.malloc<int>(entries);
+  occa::memory o_floatValues = device.malloc<float>(entries);
+  o_values.copyFrom(values.data());
+  o_floatValues.copyFrom(floatValues.data());
+
+  addToValues(o_values, 1);
+  const int kernelCacheMisses = (int) device.kernelCacheMisses();
+
+  // Repeated launches reuse the built kernel
+  for (int i = 0; i < 4; ++i) {
+    addToValues(o_values, 2);
+  }
+  ASSERT_EQ(kernelCacheMisses, (int) device.kernelCacheMisses());
+
+  o_values.copyTo(values.data());
+  for (int i = 0; i < entries; ++i) {
+    ASSERT_EQ(9, values[i]);
+  }
+
+  // A different scope signature builds a new kernel
+  addToValues(o_floatValues, 0.5f);
+  addToValues(o_floatValues, 0.25f);
+  ASSERT_EQ(kernelCacheMisses + 1, (int) device.kernelCacheMisses());
+
+  o_floatValues.copyTo(floatValues.data());
+  for (int i = 0; i < entries; ++i) {
+    ASSERT_EQ(0.75f, floatValues[i]);
+  }
+
+  // Switching back finds the first kernel again
+  addToValues(o_values, 1);
+  ASSERT_EQ(kernelCacheMisses + 1, (int) device.kernelCacheMisses());
+
+  o_values.copyTo(values.data());
+  ASSERT_EQ(10, values[entries - 1]);
+}
+
+void testThreads() {
+  const int threadCount = 4;
+  const int launches = 50;
+  const int entries = 32;
+
+  // Threads share the OCCA_JIT builder, each launching on its own device
+  std::vector<std::vector<int>> values(threadCount);
+  std::vector<std::thread> threads;
+  for (int t = 0; t < threadCount; ++t) {
+    threads.push_back(std::thread([&, t]() {
+      occa::device device({
+        {"mode", "Serial"}
+      });
+
+      values[t].assign(entries, 0);
+      occa::memory o_values = device.malloc<int>(entries, values[t].data());
+      for (int i = 0; i < launches; ++i) {
+        addToValues(o_values, t + 1);
+      }
+      o_values.copyTo(values[t].data());
+    }));
+  }
+  for (std::thread &thread : threads) {
+    thread.join();
+  }
+
+  for (int t = 0; t < threadCount; ++t) {
+    for (int i = 0; i < entries; ++i) {
+      ASSERT_EQ(launches * (t + 1), values[t][i]);
+    }
+  }
+}
@@ -1,3 +1,6 @@
+#include <algorithm>
+#include <vector>
+
 #include <occa.hpp>
 #include <occa/functional.hpp>
 #include <occa/internal/functional/functionStore.hpp>
@@ -36,6 +39,7 @@ class context {
 };
 
 void testFunctionStore();
+void testAsyncStream();
 void testBaseMethods(occa::device device);
 void testEvery(occa::device device);
 void testSome(occa::device device);
@@ -45,7 +49,9 @@ void testForEach(occa::device device);
 void testMap(occa::device device);
 void testMapTo(occa::device device);
 void testReduce(occa::device device);
+void testMultiReduce(occa::device device);
 void testSlice(occa::device device);
+void testHostView(occa::device device);
 void testConcat(occa::device device);
 void testFill(occa::device device);
 void testIncludes(occa::device device);
@@ -59,6 +65,9 @@ void testMax(occa::device device);
 void testMin(occa::device device);
 void testDotProduct(occa::device device);
 void testClamp(occa::device device);
+void testScan(occa::device device);
+void testSort(occa::device device);
+void testHistogram(occa::device device);
 
 int main(const int argc, const char **argv) {
   std::vector<occa::device> devices = {
@@ -68,6 +77,10 @@ int main(const int argc, const char **argv) {
     occa::device({
       {"mode", "OpenMP"}
     }),
+    occa::device({
+      {"mode", "Threads"},
+      {"threads", 4}
+    }),
     occa::device({
       {"mode", "CUDA"},
       {"device_id", 0}
@@ -79,6 +92,7 @@ int main(const int argc, const char **argv) {
   };
 
   testFunctionStore();
+  testAsyncStream();
 
   for (auto &device : devices) {
     std::cout << "Testing mode: " << device.mode() << '\n';
@@ -91,7 +105,9 @@ int main(const int argc, const char **argv) {
     testMap(device);
     testMapTo(device);
     testReduce(device);
+    testMultiReduce(device);
     testSlice(device);
+    testHostView(device);
     testConcat(device);
     testFill(device);
     testIncludes(device);
@@ -105,6 +121,9 @@ int main(const int argc, const char **argv) {
     testMin(device);
     testDotProduct(device);
     testClamp(device);
+    testScan(device);
+    testSort(device);
+    testHistogram(device);
   }
 
   return 0;
@@ -159,6 +178,32 @@ void testFunctionStore() {
   ASSERT_EQ(7, func1(3));
 }
 
+void testAsyncStream() {
+  occa::device device({
+    {"mode", "Serial"}
+  });
+  device.setStream(
+    device.createStream({{"async", true}})
+  );
+
+  const int length = 1 << 20;
+  occa::array<int> array(device, length);
+  for (int i = 0; i < 10; ++i) {
+    array.fill(i);
+  }
+
+  // Host pointers are only handed out after the queued kernels finish
+  ASSERT_EQ(9, array[length - 1]);
+
+  array.fill(10);
+  {
+    occa::arrayHostView<int> view = array.hostView();
+    ASSERT_TRUE(view.isZeroCopy());
+    ASSERT_EQ(10, view[0]);
+    ASSERT_EQ(10, view[length - 1]);
+  }
+}
+
 void testBaseMethods(occa::device device) {
   context ctx(device);
 
@@ -290,7 +335,6 @@ void testSome(occa::device device) {
 }
 
 void testFilter(occa::device device) {
-#if 0
   context ctx(device);
 
   occa::array<int> filteredArray;
@@ -339,7 +383,39 @@ void testFilter(occa::device device) {
   ASSERT_EQ(5, (int) filteredArray.length());
   ASSERT_EQ(5, filteredArray.min());
   ASSERT_EQ(ctx.maxValue, filteredArray.max());
-#endif
+
+  // Order is kept across blocks
+  const int length = 100000;
+  std::vector<int> values(length);
+  for (int i = 0; i < length; ++i) {
+    values[i] = (i * 7919) % 1000;
+  }
+  occa::array<int> array(device.malloc<int>(length, values.data()));
+
+  filteredArray = array.filter(
+    OCCA_FUNCTION([](const int &value) -> bool {
+      return value < 100;
+    })
+  );
+
+  std::vector<int> expectedValues;
+  for (const int value : values) {
+    if (value < 100) {
+      expectedValues.push_back(value);
+    }
+  }
+
+  std::vector<int> filteredValues(expectedValues.size());
+  ASSERT_EQ(expectedValues.size(), (size_t) filteredArray.length());
+  filteredArray.copyTo(filteredValues.data());
+  ASSERT_TRUE(expectedValues == filteredValues);
+
+  filteredArray = array.filter(
+    OCCA_FUNCTION([](const int &value) -> bool {
+      return value < 0;
+    })
+  );
+  ASSERT_EQ(0, (int) filteredArray.length());
 }
 
 void testFindIndex(occa::device device) {
@@ -597,6 +673,75 @@ void testReduce(occa::device device) {
       })
     )
   );
+
+  // Large arrays are split into many partials
+  const int length = 100003;
+  std::vector<int> values(length);
+  int largeSum = 0;
+  for (int i = 0; i < length; ++i) {
+    values[i] = (i * 7919) % 1000;
+    largeSum += values[i];
+  }
+  occa::array<int> largeArray(device.malloc<int>(length, values.data()));
+
+  occa::function<int(const int&, const int&)> sum = OCCA_FUNCTION(
+    [](const int &acc, const int &value) -> int {
+      return acc + value;
+    }
+  );
+
+  ASSERT_EQ(largeSum, largeArray.reduce<int>(occa::reductionType::sum, sum));
+  ASSERT_EQ(0, largeArray.min());
+  ASSERT_EQ(999, largeArray.max());
+  ASSERT_EQ((occa::dim_t) 3, largeArray.indexOf(3 * 7919 % 1000));
+
+  // Partials are kept on the device rather than allocated for every reduction
+  const occa::udim_t bytesAllocated = device.memoryAllocated();
+  ctx.array.reduce<int>(occa::reductionType::sum, sum);
+  largeArray.reduce<int>(occa::reductionType::sum, sum);
+  largeArray.clone().max();
+  ASSERT_EQ(bytesAllocated, device.memoryAllocated());
+}
+
+void testMultiReduce(occa::device device) {
+  context ctx(device);
+
+  std::vector<int> reductions = ctx.array.multiReduce({
+    occa::reductionType::min,
+    occa::reductionType::max,
+    occa::reductionType::sum
+  });
+  ASSERT_EQ(3, (int) reductions.size());
+  ASSERT_EQ(ctx.minValue, reductions[0]);
+  ASSERT_EQ(ctx.maxValue, reductions[1]);
+  ASSERT_EQ(45, reductions[2]);
+
+  const int length = 100003;
+  std::vector<double> values(length);
+  for (int i = 0; i < length; ++i) {
+    values[i] = ((i * 7919) % 1000) - 500.5;
+  }
+  occa::array<double> array(device.malloc<double>(length, values.data()));
+
+  std::vector<double> doubleReductions = array.multiReduce({
+    occa::reductionType::max,
+    occa::reductionType::min
+  });
+  ASSERT_EQ(498.5, doubleReductions[0]);
+  ASSERT_EQ(-500.5, doubleReductions[1]);
+
+  // Empty arrays return the identity values
+  occa::array<int> emptyArray = ctx.array.filter(
+    OCCA_FUNCTION([](const int &value) -> bool {
+      return value < 0;
+    })
+  );
+  reductions = emptyArray.multiReduce({
+    occa::reductionType::sum,
+    occa::reductionType::multiply
+  });
+  ASSERT_EQ(0, reductions[0]);
+  ASSERT_EQ(1, reductions[1]);
 }
 
 void testSlice(occa::device device) {
@@ -632,6 +777,53 @@ void testSlice(occa::device device) {
   ASSERT_EQ(8, slice.max());
 }
 
+void testHostView(occa::device device) {
+  context ctx(device);
+
+  {
+    occa::arrayHostView<int> view = ctx.array.hostView();
+    ASSERT_EQ(ctx.length, (int) view.size());
+    ASSERT_EQ(!device.hasSeparateMemorySpace(), view.isZeroCopy());
+
+    for (int i = 0; i < ctx.length; ++i) {
+      ASSERT_EQ(i, view[i]);
+      view[i] = 2 * i;
+    }
+  }
+  // Values are visible to kernels once the view is out of scope
+  ASSERT_EQ(2 * ctx.maxValue, ctx.array.max());
+  ASSERT_EQ(6, ctx.array[3]);
+
+  {
+    occa::arrayHostView<int> view = ctx.array.mappedRange(2, 3);
+    ASSERT_EQ(3, (int) view.size());
+    int sum = 0;
+    for (int value : view) {
+      sum += value;
+    }
+    ASSERT_EQ(4 + 6 + 8, sum);
+    view[0] = -1;
+  }
+  ASSERT_EQ(-1, ctx.array.min());
+  ASSERT_EQ(-1, ctx.array[2]);
+
+  const occa::array<int> constArray = ctx.array.slice(8);
+  {
+    occa::arrayHostView<const int> view = constArray.mappedRange(1);
+    ASSERT_EQ(1, (int) view.size());
+    ASSERT_EQ(18, view[0]);
+  }
+
+  ASSERT_EQ(0, (int) ctx.array.mappedRange(ctx.length).size());
+
+  ASSERT_THROW(
+    ctx.array.mappedRange(ctx.length + 1);
+  );
+  ASSERT_THROW(
+    ctx.array.mappedRange(5, 6);
+  );
+}
+
 void testConcat(occa::device device) {
   context ctx(device);
 
@@ -906,3 +1098,103 @@ void testClamp(occa::device device) {
   ASSERT_EQ(0, clampedArray.min());
   ASSERT_EQ(7, clampedArray.max());
 }
+
+void testScan(occa::device device) {
+  context ctx(device);
+
+  int values[10];
+  ctx.array.inclusiveScan().copyTo(values);
+  for (int i = 0; i < ctx.length; ++i) {
+    ASSERT_EQ(i * (i + 1) / 2, values[i]);
+  }
+
+  ctx.array.exclusiveScan().copyTo(values);
+  for (int i = 0; i < ctx.length; ++i) {
+    ASSERT_EQ(i * (i - 1) / 2, values[i]);
+  }
+
+  // Spans several blocks
+  const int length = 100000;
+  std::vector<float> floatValues(length);
+  std::vector<float> expectedMax(length);
+  for (int i = 0; i < length; ++i) {
+    floatValues[i] = (float) ((i * 7919) % 10007);
+    expectedMax[i] = std::max(floatValues[i], i ? expectedMax[i - 1] : floatValues[i]);
+  }
+  occa::array<float> floatArray(device.malloc<float>(length, floatValues.data()));
+
+  std::vector<float> scanValues(length);
+  floatArray.inclusiveScan(occa::reductionType::max).copyTo(scanValues.data());
+  ASSERT_TRUE(expectedMax == scanValues);
+
+  occa::array<int> ones = occa::array<int>(device, length).fill(1);
+  std::vector<int> intValues(length);
+  ones.exclusiveScan().copyTo(intValues.data());
+  for (int i = 0; i < length; ++i) {
+    ASSERT_EQ(i, intValues[i]);
+  }
+}
+
+void testSort(occa::device device) {
+  const int length = 100000;
+
+  std::vector<int> values(length);
+  for (int i = 0; i < length; ++i) {
+    values[i] = ((i * 7919) % 20011) - 10000;
+  }
+  occa::array<int> array(device.malloc<int>(length, values.data()));
+
+  std::vector<int> sortedValues(length);
+  array.sort().copyTo(sortedValues.data());
+
+  std::vector<int> expectedValues = values;
+  std::sort(expectedValues.begin(), expectedValues.end());
+  ASSERT_TRUE(expectedValues == sortedValues);
+
+  // Equal values keep their order
+  std::vector<int> indices(length);
+  array.sortedIndices().copyTo(indices.data());
+  for (int i = 0; i < length; ++i) {
+    ASSERT_EQ(expectedValues[i], values[indices[i]]);
+    if (i && (values[indices[i - 1]] == values[indices[i]])) {
+      ASSERT_LT(indices[i - 1], indices[i]);
+    }
+  }
+
+  std::vector<double> doubleValues = {2.5, -1.0, 0.0, -3.25, 1e10, -0.5, 7.0};
+  occa::array<double> doubleArray(device.malloc<double>(doubleValues.size(), doubleValues.data()));
+
+  std::vector<double> sortedDoubleValues(doubleValues.size());
+  doubleArray.sort().copyTo(sortedDoubleValues.data());
+  std::sort(doubleValues.begin(), doubleValues.end());
+  ASSERT_TRUE(doubleValues == sortedDoubleValues);
+}
+
+void testHistogram(occa::device device) {
+  context ctx(device);
+
+  int counts[3];
+  ctx.array.histogram(3, 0, 9).copyTo(counts);
+  ASSERT_EQ(3, counts[0]);
+  ASSERT_EQ(3, counts[1]);
+  ASSERT_EQ(3, counts[2]);
+
+  const int length = 100000;
+  std::vector<float> values(length);
+  std::vector<int> expectedCounts(10, 0);
+  for (int i = 0; i < length; ++i) {
+    values[i] = ((i * 7919) % 1200) / 100.0f;
+    if (values[i] < 10) {
+      ++expectedCounts[(int) values[i]];
+    }
+  }
+  occa::array<float> array(device.malloc<float>(length, values.data()));
+
+  std::vector<int> histogram(10);
+  array.histogram(10, 0, 10).copyTo(histogram.data());
+  ASSERT_TRUE(expectedCounts == histogram);
+
+  ASSERT_THROW(
+    array.histogram(0, 0, 10);
+  );
+}
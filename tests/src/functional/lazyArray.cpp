@@ -0,0 +1,280 @@
+#include <occa.hpp>
+#include <occa/functional.hpp>
+#include <occa/internal/utils/testing.hpp>
+
+void testMap(occa::device device);
+void testFilter(occa::device device);
+void testReduce(occa::device device);
+void testForEach(occa::device device);
+void testCaptures(occa::device device);
+void testFusion(occa::device device);
+
+int main(const int argc, const char **argv) {
+  std::vector<occa::device> devices = {
+    occa::device({
+      {"mode", "Serial"}
+    }),
+    occa::device({
+      {"mode", "OpenMP"}
+    }),
+    occa::device({
+      {"mode", "Threads"},
+      {"threads", 4}
+    })
+  };
+
+  for (auto &device : devices) {
+    std::cout << "Testing mode: " << device.mode() << '\n';
+    testMap(device);
+    testFilter(device);
+    testReduce(device);
+    testForEach(device);
+    testCaptures(device);
+    testFusion(device);
+  }
+
+  return 0;
+}
+
+occa::array<int> getArray(occa::device device, const int length = 10) {
+  std::vector<int> values(length);
+  for (int i = 0; i < length; ++i) {
+    values[i] = i;
+  }
+  return occa::array<int>(device.malloc<int>(length, values.data()));
+}
+
+void testMap(occa::device device) {
+  occa::array<int> array = getArray(device);
+
+  occa::array<float> floatArray = (
+    array
+    .lazy()
+    .map<float>(OCCA_FUNCTION([](const int &value) -> float {
+      return value / 2.0;
+    }))
+    .map<float>(OCCA_FUNCTION([](const float &value, const int index) -> float {
+      return value + index;
+    }))
+    .toArray()
+  );
+
+  ASSERT_EQ(10, (int) floatArray.length());
+  for (int i = 0; i < 10; ++i) {
+    ASSERT_EQ((float) (1.5 * i), floatArray[i]);
+  }
+
+  // The source array is untouched
+  ASSERT_EQ(0, array.min());
+  ASSERT_EQ(9, array.max());
+
+  occa::array<int> output;
+  array
+    .lazy()
+    .map<int>(OCCA_FUNCTION([](const int &value) -> int {
+      return 2 * value;
+    }))
+    .mapTo(output);
+
+  ASSERT_EQ(10, (int) output.length());
+  ASSERT_EQ(0, output.min());
+  ASSERT_EQ(18, output.max());
+}
+
+void testFilter(occa::device device) {
+  occa::array<int> array = getArray(device);
+
+  occa::lazyArray<int> evens = (
+    array
+    .lazy()
+    .filter(OCCA_FUNCTION([](const int &value) -> bool {
+      return !(value % 2);
+    }))
+  );
+
+  ASSERT_EQ(5, evens.count());
+  ASSERT_EQ(20, evens.sum());
+  ASSERT_EQ(0, evens.min());
+  ASSERT_EQ(8, evens.max());
+
+  // Filters see the original index
+  occa::lazyArray<int> tail = (
+    evens
+    .map<int>(OCCA_FUNCTION([](const int &value) -> int {
+      return value + 100;
+    }))
+    .filter(OCCA_FUNCTION([](const int &value, const int index) -> bool {
+      return index >= 5;
+    }))
+  );
+
+  ASSERT_EQ(2, tail.count());
+  ASSERT_EQ(106, tail.min());
+  ASSERT_EQ(108, tail.max());
+
+  // Everything filtered out leaves the identity
+  occa::lazyArray<int> none = (
+    array
+    .lazy()
+    .filter(OCCA_FUNCTION([](const int &value) -> bool {
+      return value < 0;
+    }))
+  );
+
+  ASSERT_EQ(0, none.count());
+  ASSERT_EQ(0, none.sum());
+
+  occa::array<int> evenArray = evens.toArray();
+  ASSERT_EQ(5, (int) evenArray.length());
+  for (int i = 0; i < 5; ++i) {
+    ASSERT_EQ(2 * i, evenArray[i]);
+  }
+
+  occa::array<int> tailArray;
+  tail.mapTo(tailArray);
+  ASSERT_EQ(2, (int) tailArray.length());
+  ASSERT_EQ(106, tailArray[0]);
+  ASSERT_EQ(108, tailArray[1]);
+
+  ASSERT_EQ(0, (int) none.toArray().length());
+}
+
+void testReduce(occa::device device) {
+  occa::array<int> array = getArray(device);
+
+  const double sumOfSquares = (
+    array
+    .lazy()
+    .map<double>(OCCA_FUNCTION([](const int &value) -> double {
+      return (double) value * value;
+    }))
+    .reduce<double>(
+      occa::reductionType::sum,
+      OCCA_FUNCTION([](const double &acc, const double &value) -> double {
+        return acc + value;
+      })
+    )
+  );
+  ASSERT_EQ(285.0, sumOfSquares);
+
+  const int lastEven = (
+    array
+    .lazy()
+    .filter(OCCA_FUNCTION([](const int &value) -> bool {
+      return !(value % 2);
+    }))
+    .reduce<int>(
+      occa::reductionType::max,
+      -1,
+      OCCA_FUNCTION([](const int &acc, const int &value, const int index) -> int {
+        return acc > index ? acc : index;
+      })
+    )
+  );
+  ASSERT_EQ(8, lastEven);
+
+  const float minHalf = (
+    array
+    .lazy()
+    .map<float>(OCCA_FUNCTION([](const int &value) -> float {
+      return 0.5 - value;
+    }))
+    .min()
+  );
+  ASSERT_EQ((float) -8.5, minHalf);
+}
+
+void testForEach(occa::device device) {
+  occa::array<int> array = getArray(device);
+  occa::array<int> output(device, 10);
+  output.fill(0);
+
+  occa::scope fnScope({
+    {"output", output.memory()}
+  });
+
+  array
+    .lazy()
+    .filter(OCCA_FUNCTION([](const int &value) -> bool {
+      return value >= 5;
+    }))
+    .forEach(OCCA_FUNCTION(fnScope, [=](const int &value, const int index) -> void {
+      output[index] = 2 * value;
+    }));
+
+  int values[10];
+  output.copyTo(values);
+  for (int i = 0; i < 10; ++i) {
+    ASSERT_EQ(i >= 5 ? 2 * i : 0, values[i]);
+  }
+}
+
+void testCaptures(occa::device device) {
+  occa::array<int> array = getArray(device);
+
+  const int offset = 3;
+  const int limit = 10;
+
+  occa::scope offsetScope({
+    {"offset", offset}
+  });
+  occa::scope limitScope({
+    {"limit", limit}
+  });
+
+  occa::lazyArray<int> shifted = (
+    array
+    .lazy()
+    .map<int>(OCCA_FUNCTION(offsetScope, [=](const int &value) -> int {
+      return value + offset;
+    }))
+    .filter(OCCA_FUNCTION(limitScope, [=](const int &value) -> bool {
+      return value < limit;
+    }))
+  );
+
+  // 3, 4, ..., 9
+  ASSERT_EQ(7, shifted.count());
+  ASSERT_EQ(42, shifted.sum());
+
+  // Captured names become kernel arguments and can't repeat
+  ASSERT_THROW(
+    shifted.map<int>(OCCA_FUNCTION(offsetScope, [=](const int &value) -> int {
+      return value - offset;
+    }));
+  );
+}
+
+void testFusion(occa::device device) {
+  occa::device freshDevice(device.properties());
+  occa::array<int> array = getArray(freshDevice, 1000);
+
+  const int kernelCacheMisses = (int) freshDevice.kernelCacheMisses();
+
+  const int sum = (
+    array
+    .lazy()
+    .map<int>(OCCA_FUNCTION([](const int &value) -> int {
+      return 2 * value;
+    }))
+    .map<int>(OCCA_FUNCTION([](const int &value) -> int {
+      return value + 1;
+    }))
+    .filter(OCCA_FUNCTION([](const int &value) -> bool {
+      return value % 3;
+    }))
+    .sum()
+  );
+
+  int expectedSum = 0;
+  for (int i = 0; i < 1000; ++i) {
+    const int value = (2 * i) + 1;
+    if (value % 3) {
+      expectedSum += value;
+    }
+  }
+  ASSERT_EQ(expectedSum, sum);
+
+  // The whole pipeline is a single kernel
+  ASSERT_EQ(kernelCacheMisses + 1, (int) freshDevice.kernelCacheMisses());
+}
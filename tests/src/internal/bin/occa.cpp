@@ -70,7 +70,7 @@ int main(const int argc, const char **argv) {
 
   occa::io::stdout.setOverride(saveOutput);
 
-  const std::string commands = "autocomplete clear compile env info modes translate version";
+  const std::string commands = "autocomplete bundle clear compile env info modes translate version";
   const std::string helpOptions = "--help -h";
 
   const std::string modeSuggetions = getModes();
@@ -0,0 +1,231 @@
+#define OCCA_TEST_PARSER_TYPE okl::serialParser
+
+#include <occa/internal/lang/modes/serial.hpp>
+#include "../parserUtils.hpp"
+
+void testFusion();
+void testDependencies();
+void testControlFlow();
+
+int main(const int argc, const char **argv) {
+  parser.settings["serial/include_std"] = false;
+  parser.settings["okl/fuse_inner_loops"] = true;
+
+  testFusion();
+  testDependencies();
+  testControlFlow();
+
+  return 0;
+}
+
+#define ASSERT_INNER_LOOP_COUNT(COUNT)                                  \
+  do {                                                                  \
+    ASSERT_TRUE(parser.success);                                        \
+    ASSERT_EQ(COUNT,                                                    \
+              (int) parser.root.children                                \
+              .flatFilterByStatementType(statementType::for_, "inner")  \
+              .length());                                               \
+  } while(0)
+
+std::string innerLoops(const std::string &args,
+                       const std::string &body1,
+                       const std::string &body2,
+                       const std::string &header2 = "int j = 0; j < 16; ++j") {
+  return (
+    "@kernel void foo(const int N, " + args + ") {\n"
+    "  for (int i = 0; i < N; i += 16; @outer) {\n"
+    "    @shared float s[16];\n"
+    "    for (int j = 0; j < 16; ++j; @inner) {\n"
+    "      " + body1 + "\n"
+    "    }\n"
+    "    for (" + header2 + "; @inner) {\n"
+    "      " + body2 + "\n"
+    "    }\n"
+    "  }\n"
+    "}\n"
+  );
+}
+
+//---[ Fusion ]-------------------------
+void testFusion() {
+  const std::string kernelSource = innerLoops("@restrict float *a, @restrict float *b",
+                                              "a[i + j] = 2 * b[i + j];",
+                                              "b[i + j] = a[i + j] + 1;");
+
+  parser.settings["okl/fuse_inner_loops"] = false;
+  parseSource(kernelSource);
+  ASSERT_INNER_LOOP_COUNT(2);
+
+  parser.settings["okl/fuse_inner_loops"] = true;
+  parseSource(kernelSource);
+  ASSERT_INNER_LOOP_COUNT(1);
+
+  // The second body keeps its own scope
+  parseSource(
+    innerLoops("@restrict float *a",
+               "const float x = a[i + j]; a[i + j] = x * x;",
+               "const float x = a[i + j]; a[i + j] = x + 1;")
+  );
+  ASSERT_INNER_LOOP_COUNT(1);
+
+  // Headers must match
+  parseSource(
+    innerLoops("@restrict float *a",
+               "a[i + j] = 1;",
+               "a[i + j] += 1;",
+               "int j = 0; j < 8; ++j")
+  );
+  ASSERT_INNER_LOOP_COUNT(2);
+
+  // Chains fuse into the first loop
+  parseSource(
+    "@kernel void foo(const int N, @restrict float *a) {\n"
+    "  for (int i = 0; i < N; i += 16; @outer) {\n"
+    "    for (int j = 0; j < 16; ++j; @inner) { a[i + j] = 1; }\n"
+    "    for (int j = 0; j < 16; ++j; @inner) { a[i + j] += 1; }\n"
+    "    for (int j = 0; j < 16; ++j; @inner) { a[i + j] *= 2; }\n"
+    "  }\n"
+    "}\n"
+  );
+  ASSERT_INNER_LOOP_COUNT(1);
+}
+//======================================
+
+//---[ Dependencies ]-------------------
+void testDependencies() {
+  // @shared memory read by the same work-item
+  parseSource(
+    innerLoops("@restrict float *a",
+               "s[j] = a[i + j];",
+               "a[i + j] = s[j] * s[j];")
+  );
+  ASSERT_INNER_LOOP_COUNT(1);
+
+  // @shared memory read by a neighboring work-item
+  parseSource(
+    innerLoops("@restrict float *a",
+               "s[j] = a[i + j];",
+               "a[i + j] = s[15 - j];")
+  );
+  ASSERT_INNER_LOOP_COUNT(2);
+
+  parseSource(
+    innerLoops("@restrict float *a",
+               "a[i + j] = 1;",
+               "a[i + j + 1] += 1;")
+  );
+  ASSERT_INNER_LOOP_COUNT(2);
+
+  // Non-injective indices
+  parseSource(
+    innerLoops("@restrict float *a",
+               "a[i + j] = 1;",
+               "a[i + j] += a[i];")
+  );
+  ASSERT_INNER_LOOP_COUNT(2);
+
+  parseSource(
+    innerLoops("@restrict float *a",
+               "s[j / 2] = a[i + j];",
+               "a[i + j] = s[j / 2];")
+  );
+  ASSERT_INNER_LOOP_COUNT(2);
+
+  // Pointers without @restrict may alias
+  parseSource(
+    innerLoops("float *a, float *b",
+               "a[i + j] = b[i + j];",
+               "b[i + j] = 2;")
+  );
+  ASSERT_INNER_LOOP_COUNT(2);
+
+  // The same pointer is fine
+  parseSource(
+    innerLoops("float *a",
+               "a[i + j] = 1;",
+               "a[i + j] += 1;")
+  );
+  ASSERT_INNER_LOOP_COUNT(1);
+
+  // Scalars written by every work-item
+  parseSource(
+    "@kernel void foo(const int N, @restrict float *a) {\n"
+    "  for (int i = 0; i < N; i += 16; @outer) {\n"
+    "    float sum = 0;\n"
+    "    for (int j = 0; j < 16; ++j; @inner) { sum = a[i + j]; }\n"
+    "    for (int j = 0; j < 16; ++j; @inner) { a[i + j] = sum; }\n"
+    "  }\n"
+    "}\n"
+  );
+  ASSERT_INNER_LOOP_COUNT(2);
+
+  // @exclusive values belong to the work-item and become scalars once fused
+  parseSource(
+    "@kernel void foo(const int N, @restrict float *a) {\n"
+    "  for (int i = 0; i < N; i += 16; @outer) {\n"
+    "    @exclusive float value;\n"
+    "    for (int j = 0; j < 16; ++j; @inner) { value = a[i + j]; }\n"
+    "    for (int j = 0; j < 16; ++j; @inner) { a[i + j] = value * value; }\n"
+    "  }\n"
+    "}\n"
+  );
+  ASSERT_INNER_LOOP_COUNT(1);
+  ASSERT_EQ(std::string::npos,
+            parser.toString().find(okl::serialParser::exclusiveIndexName));
+}
+//======================================
+
+//---[ Control Flow ]-------------------
+void testControlFlow() {
+  // Leaving the first loop early would skip the second body
+  parser.settings["okl/validate"] = false;
+  parseSource(
+    innerLoops("@restrict float *a",
+               "if (j > 8) { continue; } a[i + j] = 1;",
+               "a[i + j] += 1;")
+  );
+  ASSERT_INNER_LOOP_COUNT(2);
+
+  parseSource(
+    innerLoops("@restrict float *a",
+               "a[i + j] = 1;",
+               "if (j > 8) { continue; } a[i + j] += 1;")
+  );
+  ASSERT_INNER_LOOP_COUNT(1);
+
+  parseSource(
+    innerLoops("@restrict float *a",
+               "a[i + j] = 1;",
+               "if (j > 8) { break; } a[i + j] += 1;")
+  );
+  ASSERT_INNER_LOOP_COUNT(2);
+  parser.settings["okl/validate"] = true;
+
+  parseSource(
+    innerLoops("@restrict float *a",
+               "a[i + j] = 1;",
+               "if (j > 8) { return; } a[i + j] += 1;")
+  );
+  ASSERT_INNER_LOOP_COUNT(2);
+
+  // Nested loops can break and continue
+  parseSource(
+    innerLoops("@restrict float *a",
+               "for (int k = 0; k < 4; ++k) { if (k == 2) { continue; } a[i + j] += k; }",
+               "while (true) { break; } a[i + j] += 1;")
+  );
+  ASSERT_INNER_LOOP_COUNT(1);
+
+  // Barriers are kept between the loops
+  parseSource(
+    "@kernel void foo(const int N, @restrict float *a) {\n"
+    "  for (int i = 0; i < N; i += 16; @outer) {\n"
+    "    for (int j = 0; j < 16; ++j; @inner) { a[i + j] = 1; }\n"
+    "    @barrier;\n"
+    "    for (int j = 0; j < 16; ++j; @inner) { a[i + j] += 1; }\n"
+    "  }\n"
+    "}\n"
+  );
+  ASSERT_INNER_LOOP_COUNT(2);
+}
+//======================================
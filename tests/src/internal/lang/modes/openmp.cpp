@@ -4,6 +4,7 @@
 #include "../parserUtils.hpp"
 
 void testPragma();
+void testPragmaClauses();
 void testAtomic();
 
 int main(const int argc, const char **argv) {
@@ -11,6 +12,7 @@ int main(const int argc, const char **argv) {
   parser.settings["serial/include_std"] = false;
 
   testPragma();
+  testPragmaClauses();
   testAtomic();
 
   return 0;
@@ -41,6 +43,75 @@ void testPragma() {
   );
   ASSERT_PRAGMA_EXISTS("omp parallel for", 1);
 }
+
+void testPragmaClauses() {
+  const std::string kernelSource = (
+    "@kernel void foo() {\n"
+    "  for (int i = 0; i < 2; ++i; @outer) {\n"
+    "    for (int j = 0; j < 2; ++j; @outer) {\n"
+    "      for (int k = 0; k < 2; ++k; @inner) {}\n"
+    "    }\n"
+    "  }\n"
+    "}"
+  );
+
+  parser.settings["openmp/collapse"] = 2;
+  parser.settings["openmp/schedule"] = "dynamic";
+  parser.settings["openmp/chunk"] = 4;
+  parser.settings["openmp/proc_bind"] = "spread";
+  parser.settings["openmp/threads"] = 8;
+  parseSource(kernelSource);
+  ASSERT_PRAGMA_EXISTS(
+    "omp parallel for collapse(2) schedule(dynamic, 4) proc_bind(spread) num_threads(8)",
+    1
+  );
+
+  // Collapse stops at the last perfectly nested @outer loop
+  parser.settings.remove("openmp");
+  parser.settings["openmp/collapse"] = 3;
+  parseSource(kernelSource);
+  ASSERT_PRAGMA_EXISTS("omp parallel for collapse(2)", 1);
+
+  parseSource(
+    "@kernel void foo() {\n"
+    "  for (int i = 0; i < 2; ++i; @outer) {\n"
+    "    int i2 = i;\n"
+    "    for (int j = 0; j < 2; ++j; @outer) {\n"
+    "      for (int k = 0; k < 2; ++k; @inner) {}\n"
+    "    }\n"
+    "  }\n"
+    "}"
+  );
+  ASSERT_PRAGMA_EXISTS("omp parallel for", 1);
+
+  // Loops with bounds depending on an enclosing @outer iterator aren't collapsed
+  parser.settings["openmp/collapse"] = 3;
+  parseSource(
+    "@kernel void foo() {\n"
+    "  for (int i = 0; i < 2; ++i; @outer) {\n"
+    "    for (int j = 0; j < 2; ++j; @outer) {\n"
+    "      for (int k = j; k < 2; ++k; @outer) {\n"
+    "        for (int l = 0; l < 2; ++l; @inner) {}\n"
+    "      }\n"
+    "    }\n"
+    "  }\n"
+    "}"
+  );
+  ASSERT_PRAGMA_EXISTS("omp parallel for collapse(2)", 1);
+
+  parseSource(
+    "@kernel void foo() {\n"
+    "  for (int i = 0; i < 2; ++i; @outer) {\n"
+    "    for (int j = 0; j < i; ++j; @outer) {\n"
+    "      for (int k = 0; k < 2; ++k; @inner) {}\n"
+    "    }\n"
+    "  }\n"
+    "}"
+  );
+  ASSERT_PRAGMA_EXISTS("omp parallel for", 1);
+
+  parser.settings.remove("openmp");
+}
 //======================================
 
 //---[ @atomic ]------------------------
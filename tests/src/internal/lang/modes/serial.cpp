@@ -7,6 +7,9 @@ void testPreprocessor();
 void testKernel();
 void testExclusives();
 void testAtomic();
+void testScalarExclusives();
+void testHelperFunctions();
+void testVectorize();
 
 int main(const int argc, const char **argv) {
   parser.settings["serial/include_std"] = false;
@@ -18,6 +21,10 @@ int main(const int argc, const char **argv) {
   // parser.settings["okl/validate"] = true;
   // testExclusives();
 
+  testScalarExclusives();
+  testHelperFunctions();
+  testVectorize();
+
   return 0;
 }
 
@@ -134,3 +141,205 @@ void testAtomic() {
   // TODO(dmed)
 }
 //======================================
+
+//---[ Scalar @exclusive ]-------------
+void testScalarExclusives() {
+  // [sum] lives in one @inner loop while [value] crosses the barrier
+  parseSource(
+    "@kernel void foo(const int N, float *a) {\n"
+    "  for (int i = 0; i < N; i += 16; @outer) {\n"
+    "    @exclusive float sum = 0;\n"
+    "    @exclusive float value;\n"
+    "    for (int j = 0; j < 16; ++j; @inner) {\n"
+    "      for (int k = 0; k < 4; ++k) {\n"
+    "        sum += a[i + j + k];\n"
+    "      }\n"
+    "      value = sum;\n"
+    "    }\n"
+    "    for (int j = 0; j < 16; ++j; @inner) {\n"
+    "      a[i + j] = value;\n"
+    "    }\n"
+    "  }\n"
+    "}\n"
+  );
+  ASSERT_TRUE(parser.success);
+
+  std::string output = parser.toString();
+  ASSERT_NEQ(std::string::npos,
+             output.find("float value[256];"));
+  ASSERT_EQ(std::string::npos,
+            output.find("float sum[256]"));
+  ASSERT_NEQ(std::string::npos,
+             output.find("sum += a[i + j + k];"));
+
+  // Values carried across regular loop iterations stay as arrays
+  parseSource(
+    "@kernel void foo(const int N, float *a) {\n"
+    "  for (int i = 0; i < N; i += 16; @outer) {\n"
+    "    @exclusive float sum;\n"
+    "    for (int k = 0; k < 4; ++k) {\n"
+    "      for (int j = 0; j < 16; ++j; @inner) {\n"
+    "        sum += a[i + j];\n"
+    "      }\n"
+    "    }\n"
+    "  }\n"
+    "}\n"
+  );
+  ASSERT_TRUE(parser.success);
+  ASSERT_NEQ(std::string::npos,
+             parser.toString().find("float sum[256];"));
+
+  // Uses in @inner loop headers run before the loop body
+  parseSource(
+    "@kernel void foo(const int N, float *a) {\n"
+    "  for (int i = 0; i < N; i += 16; @outer) {\n"
+    "    @exclusive int offset = 1;\n"
+    "    for (int j = offset; j < 16; ++j; @inner) {\n"
+    "      a[i + j] = offset;\n"
+    "    }\n"
+    "  }\n"
+    "}\n"
+  );
+  ASSERT_TRUE(parser.success);
+  ASSERT_NEQ(std::string::npos,
+             parser.toString().find("int offset[256]"));
+
+  // Scalar exclusives don't need the exclusive index
+  parseSource(
+    "@kernel void foo(const int N, float *a) {\n"
+    "  for (int i = 0; i < N; i += 16; @outer) {\n"
+    "    @exclusive float x;\n"
+    "    for (int j = 0; j < 16; ++j; @inner) {\n"
+    "      x = a[i + j];\n"
+    "      a[i + j] = x * x;\n"
+    "    }\n"
+    "  }\n"
+    "}\n"
+  );
+  ASSERT_TRUE(parser.success);
+  ASSERT_EQ(std::string::npos,
+            parser.toString().find(okl::serialParser::exclusiveIndexName));
+}
+//======================================
+
+//---[ Helper Functions ]---------------
+void testHelperFunctions() {
+  const std::string kernelSource = (
+    "float square(const float value) {\n"
+    "  return value * value;\n"
+    "}\n"
+    "extern float scale(const float value);\n"
+    "@kernel void foo(const int N, float *a) {\n"
+    "  for (int i = 0; i < N; ++i; @tile(16, @outer, @inner)) {\n"
+    "    a[i] = scale(square(a[i]));\n"
+    "  }\n"
+    "}\n"
+  );
+
+  // Disabled by default
+  parseSource(kernelSource);
+  ASSERT_TRUE(parser.success);
+
+  std::string output = parser.toString();
+  ASSERT_EQ(std::string::npos,
+            output.find("static float square("));
+
+  // Only kernels keep external linkage
+  parser.settings["serial/static_functions"] = true;
+  parseSource(kernelSource);
+  ASSERT_TRUE(parser.success);
+
+  output = parser.toString();
+  ASSERT_NEQ(std::string::npos,
+             output.find("static float square("));
+  ASSERT_EQ(std::string::npos,
+            output.find("static float scale("));
+  ASSERT_EQ(std::string::npos,
+            output.find("static void foo("));
+
+  // Prototypes get the same linkage as their definition
+  parseSource(
+    "float cube(const float value);\n"
+    "float offset(const float value);\n"
+    "@kernel void foo(const int N, float *a) {\n"
+    "  for (int i = 0; i < N; ++i; @tile(16, @outer, @inner)) {\n"
+    "    a[i] = offset(cube(a[i]));\n"
+    "  }\n"
+    "}\n"
+    "float cube(const float value) {\n"
+    "  return value * value * value;\n"
+    "}\n"
+  );
+  ASSERT_TRUE(parser.success);
+
+  output = parser.toString();
+  ASSERT_NEQ(std::string::npos,
+             output.find("static float cube(const float value);"));
+  ASSERT_NEQ(std::string::npos,
+             output.find("static float cube(const float value) {"));
+  // Declared but defined elsewhere
+  ASSERT_EQ(std::string::npos,
+            output.find("static float offset("));
+
+  parser.settings.remove("serial/static_functions");
+}
+//======================================
+
+//---[ Vectorize ]----------------------
+void testVectorize() {
+  const std::string kernelSource = (
+    "@kernel void foo(const int N, @restrict float *a, @restrict const float *b) {\n"
+    "  for (int i = 0; i < N; i += 16; @outer) {\n"
+    "    for (int j = i; j < (i + 16); ++j; @inner) {\n"
+    "      a[j] += b[j];\n"
+    "    }\n"
+    "    for (int j = i; j < (i + 16); ++j; @inner) {\n"
+    "      if (j >= N) { return; }\n"
+    "      a[j] *= 2;\n"
+    "    }\n"
+    "  }\n"
+    "}\n"
+  );
+
+  // Disabled by default
+  parseSource(kernelSource);
+  ASSERT_TRUE(parser.success);
+  ASSERT_EQ(0, (int) parser.root.children.flatFilterByStatementType(statementType::pragma).length());
+  ASSERT_EQ(0, (int) parser.vectorizationReport.size());
+
+  parser.settings["serial/vectorize"] = true;
+  parseSource(kernelSource);
+  ASSERT_TRUE(parser.success);
+
+  statementArray pragmaSmnts = (
+    parser.root.children
+    .flatFilterByStatementType(statementType::pragma)
+  );
+  ASSERT_EQ(1, (int) pragmaSmnts.length());
+  ASSERT_EQ("omp simd",
+            pragmaSmnts[0]->to<pragmaStatement>().value());
+
+  ASSERT_EQ(2, (int) parser.vectorizationReport.size());
+  ASSERT_NEQ(std::string::npos,
+             parser.vectorizationReport[0].find("foo: @inner loop vectorized"));
+  ASSERT_NEQ(std::string::npos,
+             parser.vectorizationReport[1].find("not vectorized (has break, return or goto statements)"));
+
+  // Each @restrict pointer argument gets an alignment hint
+  parser.settings["serial/assume_aligned"] = 64;
+  parseSource(kernelSource);
+  ASSERT_TRUE(parser.success);
+  statementArray hintSmnts = (
+    parser.root.children
+    .flatFilterByStatementType(statementType::sourceCode)
+  );
+  ASSERT_EQ(2, (int) hintSmnts.length());
+
+  parser.settings["serial/assume_aligned"] = 48;
+  parseSource(kernelSource);
+  ASSERT_FALSE(parser.success);
+
+  parser.settings.remove("serial/vectorize");
+  parser.settings.remove("serial/assume_aligned");
+}
+//======================================
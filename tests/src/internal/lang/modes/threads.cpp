@@ -0,0 +1,89 @@
+#define OCCA_TEST_PARSER_TYPE okl::threadsParser
+
+#include <occa/internal/lang/modes/threads.hpp>
+#include <occa/internal/utils/string.hpp>
+#include "../parserUtils.hpp"
+
+void testOuterLoops();
+void testAtomic();
+
+int main(const int argc, const char **argv) {
+  parser.settings["okl/validate"] = false;
+  parser.settings["serial/include_std"] = false;
+
+  testOuterLoops();
+  testAtomic();
+
+  return 0;
+}
+
+std::string parsedSource() {
+  printer pout;
+  parser.root.print(pout);
+  return pout.str();
+}
+
+//---[ @outer ]-------------------------
+void testOuterLoops() {
+  parseSource(
+    "@kernel void foo(const int N, float *a) {\n"
+    "  for (int i = 2; i < N; i += 3; @outer) {\n"
+    "    for (int j = 0; j < 4; ++j; @outer) {\n"
+    "      for (int k = 0; k < 4; ++k; @inner) {\n"
+    "        a[i] = j;\n"
+    "      }\n"
+    "    }\n"
+    "  }\n"
+    "}"
+  );
+  ASSERT_TRUE(parser.success);
+
+  const std::string output = parsedSource();
+
+  // The worker task is passed last
+  ASSERT_TRUE(occa::contains(output, "void * _occa_task)"));
+
+  // Only the outer-most @outer loop is shared between workers
+  ASSERT_TRUE(occa::contains(output, "while (occaThreadsClaim(_occa_task, "));
+  ASSERT_TRUE(occa::contains(output, "_occa_outer_index < _occa_outer_end;"));
+  ASSERT_TRUE(occa::contains(output, "int i = 2 + (3 * _occa_outer_index);"));
+  ASSERT_TRUE(occa::contains(output, "for (int j = 0; j < 4; ++j)"));
+
+  // The worker task is an implicit argument
+  occa::lang::sourceMetadata_t metadata;
+  parser.setSourceMetadata(metadata);
+  ASSERT_EQ(2, (int) metadata.kernelsMetadata["foo"].arguments.size());
+}
+//======================================
+
+//---[ @atomic ]------------------------
+void testAtomic() {
+  // Basic updates don't lock
+  parseSource(
+    "int i;\n"
+    "float *a;\n"
+    "@atomic i += 1;\n"
+    "@atomic a[i] -= 2;\n"
+    "@atomic ++i;\n"
+    "@atomic i--;\n"
+  );
+  ASSERT_TRUE(parser.success);
+
+  std::string output = parsedSource();
+  ASSERT_TRUE(occa::contains(output, "occaThreadsAtomicAdd(i, 1, false);"));
+  ASSERT_TRUE(occa::contains(output, "occaThreadsAtomicAdd(a[i], 2, true);"));
+  ASSERT_TRUE(occa::contains(output, "occaThreadsAtomicAdd(i, 1, true);"));
+  ASSERT_FALSE(occa::contains(output, "_occa_atomic_lock"));
+
+  // Other updates fall back to the mutex
+  parseSource(
+    "int i;\n"
+    "@atomic i *= 2;\n"
+  );
+  ASSERT_TRUE(parser.success);
+  ASSERT_TRUE(
+    occa::contains(parsedSource(),
+                   "std::lock_guard<std::mutex> _occa_atomic_lock(occaThreadsAtomicMutex);")
+  );
+}
+//======================================
@@ -1,6 +1,8 @@
 #include <sstream>
 
+#include <occa/internal/io.hpp>
 #include <occa/internal/utils/env.hpp>
+#include <occa/internal/utils/sys.hpp>
 #include <occa/internal/utils/testing.hpp>
 
 #include <occa/internal/lang/tokenizer.hpp>
@@ -16,6 +18,7 @@ void testErrorDefines();
 void testOccaMacros();
 void testSpecialMacros();
 void testInclude();
+void testIncludeCache();
 void testIncludeStandardHeader();
 void testPragma();
 void testOccaPragma();
@@ -85,6 +88,7 @@ int main(const int argc, const char **argv) {
   testOccaMacros();
   testSpecialMacros();
   testInclude();
+  testIncludeCache();
   testIncludeStandardHeader();
   testPragma();
   testOccaPragma();
@@ -670,6 +674,63 @@ void testInclude() {
             (int) pp.dependencies.size());
 }
 
+void testIncludeCache() {
+  const std::string header = (occa::env::OCCA_CACHE_DIR
+                              + "preprocessor_cache_test.hpp");
+  const std::string nestedHeader = (occa::env::OCCA_CACHE_DIR
+                                    + "preprocessor_cache_nested_test.hpp");
+
+  occa::io::write(header,
+                  "#if VALUE\n"
+                  "VALUE\n"
+                  "#else\n"
+                  "-1\n"
+                  "#endif\n");
+  occa::io::write(nestedHeader,
+                  "#include \"" + header + "\"\n");
+
+  tokenizer_t::clearHeaderCache();
+
+  // Cached tokens are expanded with the macros of each include
+  std::stringstream ss;
+  ss << "#define VALUE 1\n"
+     << "#include \"" << header << "\"\n"
+     << "#undef VALUE\n"
+     << "#define VALUE 2\n"
+     << "#include \"" << header << "\"\n"
+     << "#undef VALUE\n"
+     << "#include \"" << header << "\"\n"
+     << "3\n";
+  setStream(ss.str());
+
+  ASSERT_EQ(1, (int) nextTokenPrimitiveValue());
+  ASSERT_EQ(1, tokenizer_t::cachedHeaderCount());
+  ASSERT_EQ(2, (int) nextTokenPrimitiveValue());
+  getToken();
+  ASSERT_EQ_BINARY(tokenType::op,
+                   token->type());
+  ASSERT_EQ(1, (int) nextTokenPrimitiveValue());
+  ASSERT_EQ(3, (int) nextTokenPrimitiveValue());
+  ASSERT_EQ(1, tokenizer_t::cachedHeaderCount());
+
+  // Tokens point back to the header
+  setStream("#include \"" + header + "\"\n");
+  getToken();
+  ASSERT_EQ(header,
+            token->origin.file->filename);
+  ASSERT_TRUE(token->origin.up != NULL);
+
+  // Headers with #include directives are lexed from source
+  setStream("#define VALUE 5\n"
+            "#include \"" + nestedHeader + "\"\n");
+  ASSERT_EQ(5, (int) nextTokenPrimitiveValue());
+  ASSERT_EQ(1, tokenizer_t::cachedHeaderCount());
+
+  occa::sys::rmrf(header);
+  occa::sys::rmrf(nestedHeader);
+  tokenizer_t::clearHeaderCache();
+}
+
 void testIncludeStandardHeader() {
 #define checkInclude(header)                    \
   getToken();                                   \
@@ -0,0 +1,90 @@
+#include <occa.hpp>
+
+#include <occa/internal/utils/compilerDriver.hpp>
+#include <occa/internal/utils/string.hpp>
+#include <occa/internal/utils/testing.hpp>
+
+void testSplitCommandLine();
+void testRunJob();
+void testRunJobs();
+
+int main(const int argc, const char **argv) {
+  testSplitCommandLine();
+  testRunJob();
+  testRunJobs();
+
+  return 0;
+}
+
+void testSplitCommandLine() {
+  occa::strVector args = occa::sys::splitCommandLine(
+    "  g++ -O3   -DA=\"a b\" 'single quote' esc\\ aped  "
+  );
+
+  ASSERT_EQ(5, (int) args.size());
+  ASSERT_EQ("g++", args[0]);
+  ASSERT_EQ("-O3", args[1]);
+  ASSERT_EQ("-DA=a b", args[2]);
+  ASSERT_EQ("single quote", args[3]);
+  ASSERT_EQ("esc aped", args[4]);
+
+  ASSERT_EQ(0, (int) occa::sys::splitCommandLine("   ").size());
+
+  ASSERT_EQ(
+    "g++ -O3 '-DA=a b'",
+    occa::sys::joinCommandLine({"g++", "-O3", "-DA=a b"})
+  );
+
+  args = occa::sys::splitCommandLine(
+    occa::sys::joinCommandLine({"echo", "it's", ""})
+  );
+  ASSERT_EQ(3, (int) args.size());
+  ASSERT_EQ("it's", args[1]);
+  ASSERT_EQ("", args[2]);
+}
+
+void testRunJob() {
+  occa::sys::compilerDriver_t &driver = occa::sys::compilerDriver();
+
+  occa::sys::compileJob_t echoJob({"sh", "-c", "echo out; echo err 1>&2"});
+  driver.run(echoJob);
+  ASSERT_TRUE(echoJob.succeeded());
+  ASSERT_TRUE(occa::contains(echoJob.output, "out"));
+  ASSERT_TRUE(occa::contains(echoJob.output, "err"));
+
+  occa::sys::compileJob_t failedJob({"sh", "-c", "exit 3"});
+  driver.run(failedJob);
+  ASSERT_FALSE(failedJob.succeeded());
+  ASSERT_EQ(3, failedJob.exitStatus);
+
+  occa::sys::compileJob_t missingJob({"occa_missing_compiler_binary"});
+  driver.run(missingJob);
+  ASSERT_FALSE(missingJob.succeeded());
+  ASSERT_TRUE(occa::contains(missingJob.output, "occa_missing_compiler_binary"));
+
+  ASSERT_EQ(0, driver.activeJobs());
+}
+
+void testRunJobs() {
+  occa::sys::compilerDriver_t &driver = occa::sys::compilerDriver();
+
+  const int jobCount = 8;
+  std::vector<occa::sys::compileJob_t> jobs;
+  occa::sys::compileJobVector jobPtrs;
+  for (int i = 0; i < jobCount; ++i) {
+    jobs.push_back(
+      occa::sys::compileJob_t({"sh", "-c", "echo job" + occa::toString(i) + "; exit " + occa::toString(i % 2)})
+    );
+  }
+  for (int i = 0; i < jobCount; ++i) {
+    jobPtrs.push_back(&jobs[i]);
+  }
+
+  driver.run(jobPtrs, 3);
+
+  for (int i = 0; i < jobCount; ++i) {
+    ASSERT_EQ(i % 2, jobs[i].exitStatus);
+    ASSERT_TRUE(occa::contains(jobs[i].output, "job" + occa::toString(i)));
+  }
+  ASSERT_EQ(0, driver.activeJobs());
+}
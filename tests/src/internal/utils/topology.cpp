@@ -0,0 +1,159 @@
+#include <fstream>
+
+#include <occa.hpp>
+
+#include <occa/internal/io.hpp>
+#include <occa/internal/utils/sys.hpp>
+#include <occa/internal/utils/testing.hpp>
+#include <occa/internal/utils/topology.hpp>
+
+void testParseIdList();
+void testLoad();
+void testCache();
+
+int main(const int argc, const char **argv) {
+  testParseIdList();
+  testLoad();
+  testCache();
+
+  return 0;
+}
+
+void writeFile(const std::string &filename,
+               const std::string &content) {
+  occa::sys::mkpath(occa::io::dirname(filename));
+  std::ofstream file(filename);
+  file << content;
+}
+
+void testParseIdList() {
+  std::vector<int> ids = occa::sys::parseIdList("0-2,5,7-8\n");
+  ASSERT_EQ((int) ids.size(), 6);
+  ASSERT_EQ(ids[0], 0);
+  ASSERT_EQ(ids[2], 2);
+  ASSERT_EQ(ids[3], 5);
+  ASSERT_EQ(ids[5], 8);
+
+  ASSERT_EQ((int) occa::sys::parseIdList("").size(), 0);
+  ASSERT_EQ((int) occa::sys::parseIdList("3").size(), 1);
+}
+
+void testLoad() {
+#if (OCCA_OS & OCCA_LINUX_OS)
+  // Needs to have occa in the name
+  const std::string root = occa::io::expandFilename("occa_topology_test/");
+  const std::string sysRoot = root + "sys/";
+  const std::string procRoot = root + "proc/";
+  occa::sys::rmrf(root);
+
+  // 2 packages with 1 core each and 2 threads per core
+  writeFile(sysRoot + "cpu/online", "0-3\n");
+  for (int cpu = 0; cpu < 4; ++cpu) {
+    const std::string topologyDir = sysRoot + "cpu/cpu" + std::to_string(cpu) + "/topology/";
+    writeFile(topologyDir + "core_id", "0\n");
+    writeFile(topologyDir + "physical_package_id", std::to_string(cpu / 2) + "\n");
+    writeFile(topologyDir + "thread_siblings_list", (cpu < 2) ? "0-1\n" : "2-3\n");
+  }
+  writeFile(sysRoot + "cpu/cpu0/cpufreq/cpuinfo_max_freq", "3000000\n");
+
+  const std::string cacheDir = sysRoot + "cpu/cpu0/cache/";
+  const char *caches[4][4] = {
+    {"1", "Data", "48K", "0-1"},
+    {"1", "Instruction", "32K", "0-1"},
+    {"3", "Unified", "32M", "0-3"},
+    {"2", "Unified", "1024K", "0-1"}
+  };
+  for (int i = 0; i < 4; ++i) {
+    const std::string indexDir = cacheDir + "index" + std::to_string(i) + "/";
+    writeFile(indexDir + "level", caches[i][0]);
+    writeFile(indexDir + "type", caches[i][1]);
+    writeFile(indexDir + "size", caches[i][2]);
+    writeFile(indexDir + "shared_cpu_list", caches[i][3]);
+  }
+
+  writeFile(sysRoot + "node/online", "0-1\n");
+  writeFile(sysRoot + "node/node0/cpulist", "0-1\n");
+  writeFile(sysRoot + "node/node0/meminfo",
+            "Node 0 MemTotal:       1024 kB\n"
+            "Node 0 MemFree:         512 kB\n");
+  writeFile(sysRoot + "node/node1/cpulist", "2-3\n");
+  writeFile(sysRoot + "node/node1/meminfo",
+            "Node 1 MemTotal:       1024 kB\n"
+            "Node 1 MemFree:         256 kB\n");
+
+  writeFile(procRoot + "cpuinfo",
+            "processor\t: 0\n"
+            "model name\t: Test CPU\n"
+            "cpu MHz\t\t: 2000.000\n");
+  writeFile(procRoot + "meminfo",
+            "MemTotal:       2048 kB\n"
+            "MemFree:         100 kB\n"
+            "MemAvailable:    768 kB\n");
+
+  occa::sys::topology_t topology = occa::sys::topology_t::load(sysRoot, procRoot);
+
+  ASSERT_EQ(topology.processorName, "Test CPU");
+  ASSERT_EQ(topology.frequency, (occa::udim_t) 3000000000);
+  ASSERT_EQ(topology.cpuCount(), 4);
+  ASSERT_EQ(topology.coreCount, 2);
+  ASSERT_EQ(topology.packageCount, 2);
+  ASSERT_EQ(topology.threadsPerCore, 2);
+
+  ASSERT_EQ((int) topology.caches.size(), 4);
+  ASSERT_EQ(topology.caches[2].level, 2);
+  ASSERT_EQ(topology.caches[3].sharedCpuCount, 4);
+  ASSERT_EQ(topology.cacheSize(occa::sys::CacheLevel::L1D), (occa::udim_t) (48 << 10));
+  ASSERT_EQ(topology.cacheSize(occa::sys::CacheLevel::L1I), (occa::udim_t) (32 << 10));
+  ASSERT_EQ(topology.cacheSize(occa::sys::CacheLevel::L2), (occa::udim_t) (1024 << 10));
+  ASSERT_EQ(topology.cacheSize(occa::sys::CacheLevel::L3), (occa::udim_t) (32 << 20));
+
+  ASSERT_EQ(topology.numaNodeCount(), 2);
+  ASSERT_EQ(topology.numaNodes[1].id, 1);
+  ASSERT_EQ(topology.numaNodes[1].cpus[0], 2);
+  ASSERT_EQ(topology.numaNodes[1].totalMemory, (occa::udim_t) (1024 << 10));
+  ASSERT_EQ(topology.numaNodes[1].availableMemory, (occa::udim_t) (256 << 10));
+
+  ASSERT_EQ(topology.totalMemory, (occa::udim_t) (2048 << 10));
+  ASSERT_EQ(topology.availableMemory, (occa::udim_t) (768 << 10));
+
+  // Available memory is re-read on request
+  writeFile(procRoot + "meminfo",
+            "MemTotal:       2048 kB\n"
+            "MemFree:         100 kB\n"
+            "MemAvailable:    512 kB\n");
+  ASSERT_EQ(occa::sys::topology_t::readAvailableMemory(procRoot), (occa::udim_t) (512 << 10));
+  ASSERT_EQ(topology.availableMemory, (occa::udim_t) (768 << 10));
+
+  // Missing entries fall back to a single core and node per CPU
+  writeFile(root + "empty/cpu/online", "0-1\n");
+  occa::sys::topology_t fallback = occa::sys::topology_t::load(root + "empty/", root + "empty/");
+  ASSERT_EQ(fallback.cpuCount(), 2);
+  ASSERT_EQ(fallback.threadsPerCore, 1);
+  ASSERT_EQ(fallback.numaNodeCount(), 1);
+  ASSERT_EQ((int) fallback.numaNodes[0].cpus.size(), 2);
+
+  occa::sys::rmrf(root);
+#endif
+}
+
+void testCache() {
+  std::shared_ptr<const occa::sys::topology_t> topology = occa::sys::topology_t::get();
+  ASSERT_TRUE(topology->cpuCount() > 0);
+  ASSERT_TRUE(topology->coreCount > 0);
+  ASSERT_TRUE(topology->numaNodeCount() > 0);
+
+  // Cached until refreshed
+  ASSERT_EQ(topology.get(), occa::sys::topology_t::get().get());
+
+  std::shared_ptr<const occa::sys::topology_t> refreshed = occa::sys::topology_t::refresh();
+  ASSERT_NEQ(topology.get(), refreshed.get());
+  ASSERT_EQ(refreshed.get(), occa::sys::topology_t::get().get());
+  ASSERT_EQ(topology->cpuCount(), refreshed->cpuCount());
+
+  occa::sys::SystemInfo info = occa::sys::SystemInfo::load();
+  ASSERT_EQ(info.processor.coreCount, refreshed->coreCount);
+  ASSERT_EQ(info.memory.total, refreshed->totalMemory);
+#if (OCCA_OS & OCCA_LINUX_OS)
+  ASSERT_TRUE(info.memory.available > 0);
+#endif
+}
@@ -0,0 +1,118 @@
+#include <utime.h>
+
+#include <occa/internal/io.hpp>
+#include <occa/internal/utils/testing.hpp>
+
+#include <occa.hpp>
+
+void testHash();
+void testStreamingHash();
+void testHashStrings();
+void testHashFile();
+
+int main(const int argc, const char **argv) {
+  testHash();
+  testStreamingHash();
+  testHashStrings();
+  testHashFile();
+
+  return 0;
+}
+
+void testHash() {
+  ASSERT_TRUE(occa::hash("").isInitialized());
+  ASSERT_FALSE(occa::hash_t().isInitialized());
+
+  ASSERT_EQ(occa::hash("foo"), occa::hash(std::string("foo")));
+  ASSERT_NEQ(occa::hash("foo"), occa::hash("fop"));
+  ASSERT_NEQ(occa::hash(""), occa::hash(std::string(1, '\0')));
+
+  // Every input length up to a few stripes gives a different hash
+  std::string data;
+  occa::hash_t lastHash = occa::hash(data);
+  for (int i = 0; i < 100; ++i) {
+    data += 'a';
+    const occa::hash_t newHash = occa::hash(data);
+    ASSERT_NEQ(lastHash, newHash);
+    lastHash = newHash;
+  }
+
+  // Hashes are 256 bits, no 32-bit chunk should be left untouched
+  const occa::hash_t fooHash = occa::hash("foo");
+  const occa::hash_t barHash = occa::hash("bar");
+  for (int i = 0; i < 8; ++i) {
+    ASSERT_NEQ(fooHash.h[i], barHash.h[i]);
+  }
+}
+
+void testStreamingHash() {
+  std::string data;
+  for (int i = 0; i < 1000; ++i) {
+    data += (char) ((i * 7919) % 251);
+  }
+
+  const occa::hash_t fullHash = occa::hash(data);
+
+  // Feed the same data in differently sized chunks
+  const int chunkSizes[5] = {1, 3, 31, 32, 77};
+  for (int chunkSize : chunkSizes) {
+    occa::hasher_t hasher;
+    for (int i = 0; i < (int) data.size(); i += chunkSize) {
+      hasher.update(data.substr(i, chunkSize));
+    }
+    ASSERT_EQ(fullHash, hasher.digest());
+  }
+
+  // Digests can be taken while streaming
+  occa::hasher_t hasher;
+  hasher.update(data.c_str(), 100);
+  ASSERT_EQ(occa::hash(data.c_str(), 100), hasher.digest());
+  hasher.update(data.c_str() + 100, data.size() - 100);
+  ASSERT_EQ(fullHash, hasher.digest());
+}
+
+void testHashStrings() {
+  const occa::hash_t hash = occa::hash("foo");
+  ASSERT_EQ(hash, occa::hash_t::fromString(hash.getFullString()));
+  ASSERT_EQ(64, (int) hash.getFullString().size());
+  ASSERT_EQ(16, (int) hash.getString().size());
+}
+
+void setModifiedTime(const std::string &filename, const time_t mtime) {
+  struct utimbuf times;
+  times.actime = mtime;
+  times.modtime = mtime;
+  ::utime(filename.c_str(), &times);
+}
+
+void testHashFile() {
+  const std::string filename = occa::env::OCCA_CACHE_DIR + "hash_test_file.okl";
+
+  // Recently modified files are hashed every time
+  occa::io::write(filename, "abc");
+  ASSERT_EQ(occa::hash("abc"), occa::hashFile(filename));
+  occa::io::write(filename, "abd");
+  ASSERT_EQ(occa::hash("abd"), occa::hashFile(filename));
+
+  // Older files are cached until their size or timestamp changes
+  setModifiedTime(filename, 1000000);
+  ASSERT_EQ(occa::hash("abd"), occa::hashFile(filename));
+  ASSERT_EQ(occa::hash("abd"), occa::hashFile(filename));
+
+  occa::io::write(filename, "abcd");
+  setModifiedTime(filename, 1000000);
+  ASSERT_EQ(occa::hash("abcd"), occa::hashFile(filename));
+
+  occa::io::write(filename, "abce");
+  setModifiedTime(filename, 2000000);
+  ASSERT_EQ(occa::hash("abce"), occa::hashFile(filename));
+
+  occa::io::write(filename, "");
+  setModifiedTime(filename, 3000000);
+  ASSERT_EQ(occa::hash(""), occa::hashFile(filename));
+
+  occa::sys::rmrf(filename);
+  ASSERT_THROW(
+    occa::hashFile(filename);
+  );
+}